@@ -18,10 +18,9 @@ struct SpriteInput
 
 struct RibbonInput
 {
-	uint Order : TEXCOORD0;
-	uint ParticleIndex : TEXCOORD1;
-	uint PrevParticleIndex : TEXCOORD2;
-	float Distance : TEXCOORD3;
+	uint ParticleIndex : TEXCOORD0;
+	uint PrevParticleIndex : TEXCOORD1;
+	float Distance : TEXCOORD2;
 };
 
 // Primary constant buffer (with additional material parameters)
@@ -242,24 +241,57 @@ int GetParticleInt(uint particleIndex, int offset)
 	return asint(ParticlesData.Load(particleIndex * ParticleStride + offset));
 }
 
+// Floating-point particle attributes can use quantized storage format encoded in the upper 8 bits of the offset (see ParticleAttribute::Formats)
+#define PARTICLE_FORMAT_DEFAULT 0
+#define PARTICLE_FORMAT_HALF 1
+#define PARTICLE_FORMAT_UNORM8 2
+#define PARTICLE_FORMAT_UNORM16 3
+
+float4 DecodeParticleData(uint2 data, uint format)
+{
+	if (format == PARTICLE_FORMAT_HALF)
+		return f16tof32(uint4(data.x, data.x >> 16, data.y, data.y >> 16));
+	if (format == PARTICLE_FORMAT_UNORM8)
+		return float4(data.x & 0xff, (data.x >> 8) & 0xff, (data.x >> 16) & 0xff, data.x >> 24) / 255.0f;
+	return float4(data.x & 0xffff, data.x >> 16, data.y & 0xffff, data.y >> 16) / 65535.0f;
+}
+
 float GetParticleFloat(uint particleIndex, int offset)
 {
-	return asfloat(ParticlesData.Load(particleIndex * ParticleStride + offset));
+	uint address = particleIndex * ParticleStride + (offset & 0xffffff);
+	uint format = (uint)offset >> 24;
+	if (format == PARTICLE_FORMAT_DEFAULT)
+		return asfloat(ParticlesData.Load(address));
+	return DecodeParticleData(uint2(ParticlesData.Load(address), 0), format).x;
 }
 
 float2 GetParticleVec2(uint particleIndex, int offset)
 {
-	return asfloat(ParticlesData.Load2(particleIndex * ParticleStride + offset));
+	uint address = particleIndex * ParticleStride + (offset & 0xffffff);
+	uint format = (uint)offset >> 24;
+	if (format == PARTICLE_FORMAT_DEFAULT)
+		return asfloat(ParticlesData.Load2(address));
+	return DecodeParticleData(uint2(ParticlesData.Load(address), 0), format).xy;
 }
 
 float3 GetParticleVec3(uint particleIndex, int offset)
 {
-	return asfloat(ParticlesData.Load3(particleIndex * ParticleStride + offset));
+	uint address = particleIndex * ParticleStride + (offset & 0xffffff);
+	uint format = (uint)offset >> 24;
+	if (format == PARTICLE_FORMAT_DEFAULT)
+		return asfloat(ParticlesData.Load3(address));
+	uint2 data = format == PARTICLE_FORMAT_UNORM8 ? uint2(ParticlesData.Load(address), 0) : ParticlesData.Load2(address);
+	return DecodeParticleData(data, format).xyz;
 }
 
 float4 GetParticleVec4(uint particleIndex, int offset)
 {
-	return asfloat(ParticlesData.Load4(particleIndex * ParticleStride + offset));
+	uint address = particleIndex * ParticleStride + (offset & 0xffffff);
+	uint format = (uint)offset >> 24;
+	if (format == PARTICLE_FORMAT_DEFAULT)
+		return asfloat(ParticlesData.Load4(address));
+	uint2 data = format == PARTICLE_FORMAT_UNORM8 ? uint2(ParticlesData.Load(address), 0) : ParticlesData.Load2(address);
+	return DecodeParticleData(data, format);
 }
 
 float3 TransformParticlePosition(float3 input)
@@ -565,14 +597,14 @@ VertexOutput VS_Model(ModelInput input, uint particleIndex : SV_InstanceID)
 META_VS(true, FEATURE_LEVEL_ES2)
 META_VS_IN_ELEMENT(TEXCOORD, 0, R32_UINT,  0, 0,     PER_VERTEX, 0, true)
 META_VS_IN_ELEMENT(TEXCOORD, 1, R32_UINT,  0, ALIGN, PER_VERTEX, 0, true)
-META_VS_IN_ELEMENT(TEXCOORD, 2, R32_UINT,  0, ALIGN, PER_VERTEX, 0, true)
-META_VS_IN_ELEMENT(TEXCOORD, 3, R32_FLOAT, 0, ALIGN, PER_VERTEX, 0, true)
+META_VS_IN_ELEMENT(TEXCOORD, 2, R32_FLOAT, 0, ALIGN, PER_VERTEX, 0, true)
 VertexOutput VS_Ribbon(RibbonInput input, uint vertexIndex : SV_VertexID)
 {
 	VertexOutput output;
 
-	// Get particle data
+	// Get particle data (each ribbon point uses 2 vertices so the point order is derived from the vertex index)
 	uint particleIndex = input.ParticleIndex;
+	uint order = vertexIndex >> 1;
 	int vertexSign = (((int)vertexIndex & 0x1) * 2) - 1;
 	float3 position = GetParticlePosition(particleIndex);
 	float ribbonWidth = RibbonWidthOffset != -1 ? GetParticleFloat(particleIndex, RibbonWidthOffset) : 20.0f;
@@ -580,7 +612,7 @@ VertexOutput VS_Ribbon(RibbonInput input, uint vertexIndex : SV_VertexID)
 
 	// Calculate ribbon direction
 	float3 direction;
-	if (input.Order == 0)
+	if (order == 0)
 	{
 		direction = GetParticlePosition(input.PrevParticleIndex) - position;
 	}
@@ -609,7 +641,7 @@ VertexOutput VS_Ribbon(RibbonInput input, uint vertexIndex : SV_VertexID)
 	}
 	else
 	{
-		output.TexCoord.x = (float)input.Order / (float)RibbonSegmentCount;
+		output.TexCoord.x = (float)order / (float)RibbonSegmentCount;
 	}
 	output.TexCoord.y = (vertexIndex + 1) & 0x1;
 	output.TexCoord = output.TexCoord * RibbonUVScale + RibbonUVOffset;
@@ -12,7 +12,8 @@
 META_CB_BEGIN(0, Data)
 float4x4 WorldMatrix;
 float4x4 PrevWorldMatrix;
-float2 Dummy0;
+uint BoneMatricesOffset;
+uint PrevBoneMatricesOffset;
 float LODDitherFactor;
 float PerInstanceRandom;
 float3 GeometrySize;
@@ -411,19 +412,18 @@ float4 VS_Depth(ModelInput_PosOnly input) : SV_Position
 
 #if USE_SKINNING
 
-// The skeletal bones matrix buffer (stored as 4x3, 3 float4 behind each other)
+// The skeletal bones matrix buffer shared by all skinned meshes (stored as 4x3, 3 float4 behind each other)
 Buffer<float4> BoneMatrices : register(t0);
 
 #if PER_BONE_MOTION_BLUR
 
-// The skeletal bones matrix buffer from the previous frame
-Buffer<float4> PrevBoneMatrices : register(t1);
-
+// Calculates the transposed transform matrix for the given bone index from the previous frame
 float3x4 GetPrevBoneMatrix(int index)
 {
-	float4 a = PrevBoneMatrices[index * 3];
-	float4 b = PrevBoneMatrices[index * 3 + 1];
-	float4 c = PrevBoneMatrices[index * 3 + 2];
+	uint offset = PrevBoneMatricesOffset + index * 3;
+	float4 a = BoneMatrices[offset];
+	float4 b = BoneMatrices[offset + 1];
+	float4 c = BoneMatrices[offset + 2];
 	return float3x4(a, b, c);
 }
 
@@ -444,9 +444,10 @@ float3 SkinPrevPosition(ModelInput_Skinned input)
 // Calculates the transposed transform matrix for the given bone index
 float3x4 GetBoneMatrix(int index)
 {
-	float4 a = BoneMatrices[index * 3];
-	float4 b = BoneMatrices[index * 3 + 1];
-	float4 c = BoneMatrices[index * 3 + 2];
+	uint offset = BoneMatricesOffset + index * 3;
+	float4 a = BoneMatrices[offset];
+	float4 b = BoneMatrices[offset + 1];
+	float4 c = BoneMatrices[offset + 2];
 	return float3x4(a, b, c);
 }
 
@@ -148,24 +148,57 @@ int GetParticleInt(uint particleIndex, int offset)
 	return asint(ParticlesData.Load(particleIndex * ParticleStride + offset));
 }
 
+// Floating-point particle attributes can use quantized storage format encoded in the upper 8 bits of the offset (see ParticleAttribute::Formats)
+#define PARTICLE_FORMAT_DEFAULT 0
+#define PARTICLE_FORMAT_HALF 1
+#define PARTICLE_FORMAT_UNORM8 2
+#define PARTICLE_FORMAT_UNORM16 3
+
+float4 DecodeParticleData(uint2 data, uint format)
+{
+	if (format == PARTICLE_FORMAT_HALF)
+		return f16tof32(uint4(data.x, data.x >> 16, data.y, data.y >> 16));
+	if (format == PARTICLE_FORMAT_UNORM8)
+		return float4(data.x & 0xff, (data.x >> 8) & 0xff, (data.x >> 16) & 0xff, data.x >> 24) / 255.0f;
+	return float4(data.x & 0xffff, data.x >> 16, data.y & 0xffff, data.y >> 16) / 65535.0f;
+}
+
 float GetParticleFloat(uint particleIndex, int offset)
 {
-	return asfloat(ParticlesData.Load(particleIndex * ParticleStride + offset));
+	uint address = particleIndex * ParticleStride + (offset & 0xffffff);
+	uint format = (uint)offset >> 24;
+	if (format == PARTICLE_FORMAT_DEFAULT)
+		return asfloat(ParticlesData.Load(address));
+	return DecodeParticleData(uint2(ParticlesData.Load(address), 0), format).x;
 }
 
 float2 GetParticleVec2(uint particleIndex, int offset)
 {
-	return asfloat(ParticlesData.Load2(particleIndex * ParticleStride + offset));
+	uint address = particleIndex * ParticleStride + (offset & 0xffffff);
+	uint format = (uint)offset >> 24;
+	if (format == PARTICLE_FORMAT_DEFAULT)
+		return asfloat(ParticlesData.Load2(address));
+	return DecodeParticleData(uint2(ParticlesData.Load(address), 0), format).xy;
 }
 
 float3 GetParticleVec3(uint particleIndex, int offset)
 {
-	return asfloat(ParticlesData.Load3(particleIndex * ParticleStride + offset));
+	uint address = particleIndex * ParticleStride + (offset & 0xffffff);
+	uint format = (uint)offset >> 24;
+	if (format == PARTICLE_FORMAT_DEFAULT)
+		return asfloat(ParticlesData.Load3(address));
+	uint2 data = format == PARTICLE_FORMAT_UNORM8 ? uint2(ParticlesData.Load(address), 0) : ParticlesData.Load2(address);
+	return DecodeParticleData(data, format).xyz;
 }
 
 float4 GetParticleVec4(uint particleIndex, int offset)
 {
-	return asfloat(ParticlesData.Load4(particleIndex * ParticleStride + offset));
+	uint address = particleIndex * ParticleStride + (offset & 0xffffff);
+	uint format = (uint)offset >> 24;
+	if (format == PARTICLE_FORMAT_DEFAULT)
+		return asfloat(ParticlesData.Load4(address));
+	uint2 data = format == PARTICLE_FORMAT_UNORM8 ? uint2(ParticlesData.Load(address), 0) : ParticlesData.Load2(address);
+	return DecodeParticleData(data, format);
 }
 
 float3 TransformParticlePosition(float3 input)
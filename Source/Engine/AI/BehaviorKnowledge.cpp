@@ -91,8 +91,80 @@ bool AccessVariant(Variant& instance, const StringAnsiView& member, Variant& val
     return false;
 }
 
-bool AccessBehaviorKnowledge(BehaviorKnowledge* knowledge, const StringAnsiView& path, Variant& value, bool set)
+bool AccessVariant(const BehaviorTreeCompiledSelector& selector, Variant& instance, Variant& value, bool set)
 {
+    typedef BehaviorTreeCompiledSelector::Accessors Accessors;
+    if (selector.Accessor == Accessors::Value)
+        return AccessVariant(instance, StringAnsiView::Empty, value, set);
+    if (selector.TypeName != StringAnsiView(instance.Type.GetTypeName()))
+    {
+        // Value type differs from the one used to compile the selector (eg. blackboard type changed)
+        return AccessVariant(instance, selector.Member, value, set);
+    }
+    switch (selector.Accessor)
+    {
+    case Accessors::Structure:
+        if (set)
+            selector.Type.GetType().Struct.SetField(instance.AsBlob.Data, selector.MemberName, value);
+        else
+            selector.Type.GetType().Struct.GetField(instance.AsBlob.Data, selector.MemberName, value);
+        return true;
+    case Accessors::Field:
+        if (set)
+            return !selector.Type.Module->SetFieldValue(selector.Field, instance, value);
+        return !selector.Type.Module->GetFieldValue(selector.Field, instance, value);
+#if USE_CSHARP
+    case Accessors::ManagedField:
+    {
+        const auto mField = (MField*)selector.Field;
+        MObject* instanceObject = MUtils::BoxVariant(instance);
+        bool failed;
+        if (set)
+            mField->SetValue(instanceObject, MUtils::VariantToManagedArgPtr(value, mField->GetType(), failed));
+        else
+            value = MUtils::UnboxVariant(mField->GetValueBoxed(instanceObject));
+        return true;
+    }
+    case Accessors::ManagedProperty:
+    {
+        const auto mProperty = (MProperty*)selector.Field;
+        MObject* instanceObject = MUtils::BoxVariant(instance);
+        if (set)
+            mProperty->SetValue(instanceObject, MUtils::BoxVariant(value), nullptr);
+        else
+            value = MUtils::UnboxVariant(mProperty->GetValue(instanceObject, nullptr));
+        return true;
+    }
+#endif
+    default:
+        return false;
+    }
+}
+
+bool AccessBehaviorKnowledge(BehaviorKnowledge* knowledge, const BehaviorTreeCompiledSelector& selector, Variant& value, bool set)
+{
+    if (selector.Source == BehaviorTreeCompiledSelector::Sources::Blackboard)
+        return AccessVariant(selector, knowledge->Blackboard, value, set);
+    for (Variant& goal : knowledge->Goals)
+    {
+        if (selector.TypeName == StringAnsiView(goal.Type.GetTypeName()))
+        {
+            return AccessVariant(selector, goal, value, set);
+        }
+    }
+    return false;
+}
+
+bool AccessBehaviorKnowledge(BehaviorKnowledge* knowledge, const StringAnsiView& path, Variant& value, bool set, int64* cache = nullptr)
+{
+    // Use selector compiled by the tree to skip path parsing and type members lookup (only for persistent selectors, dynamic paths use lookup below)
+    if (cache && knowledge->Tree)
+    {
+        const BehaviorTreeCompiledSelector* selector = knowledge->Tree->GetSelector(path, cache);
+        if (selector && selector->Accessor != BehaviorTreeCompiledSelector::Accessors::Invalid)
+            return AccessBehaviorKnowledge(knowledge, *selector, value, set);
+    }
+
     const int32 typeEnd = path.Find('/');
     if (typeEnd == -1)
         return false;
@@ -121,20 +193,20 @@ bool AccessBehaviorKnowledge(BehaviorKnowledge* knowledge, const StringAnsiView&
 
 bool BehaviorKnowledgeSelectorAny::Set(BehaviorKnowledge* knowledge, const Variant& value) const
 {
-    return knowledge && knowledge->Set(Path, value);
+    return knowledge && AccessBehaviorKnowledge(knowledge, Path, const_cast<Variant&>(value), true, &_compiled);
 }
 
 Variant BehaviorKnowledgeSelectorAny::Get(const BehaviorKnowledge* knowledge) const
 {
     Variant value;
     if (knowledge)
-        knowledge->Get(Path, value);
+        AccessBehaviorKnowledge(const_cast<BehaviorKnowledge*>(knowledge), Path, value, false, &_compiled);
     return value;
 }
 
 bool BehaviorKnowledgeSelectorAny::TryGet(const BehaviorKnowledge* knowledge, Variant& value) const
 {
-    return knowledge && knowledge->Get(Path, value);
+    return knowledge && AccessBehaviorKnowledge(const_cast<BehaviorKnowledge*>(knowledge), Path, value, false, &_compiled);
 }
 
 BehaviorKnowledge::~BehaviorKnowledge()
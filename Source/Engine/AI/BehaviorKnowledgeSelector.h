@@ -20,6 +20,12 @@ API_STRUCT(NoDefault, MarshalAs=StringAnsi) struct FLAXENGINE_API BehaviorKnowle
     /// </summary>
     API_FIELD() StringAnsi Path;
 
+private:
+    // Cached index of the selector compiled by the Behavior Tree (see BehaviorTree::GetSelector).
+    mutable int64 _compiled = 0;
+
+public:
+
     // Sets the selected knowledge value (as Variant).
     bool Set(BehaviorKnowledge* knowledge, const Variant& value) const;
 
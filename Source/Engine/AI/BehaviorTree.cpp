@@ -6,17 +6,115 @@
 #include "Engine/Core/Collections/Sorting.h"
 #include "Engine/Content/Factories/BinaryAssetFactory.h"
 #include "Engine/Content/JsonAsset.h"
+#include "Engine/Engine/Engine.h"
+#include "Engine/Profiler/ProfilerCPU.h"
 #include "Engine/Scripting/Scripting.h"
+#include "Engine/Scripting/BinaryModule.h"
 #include "Engine/Serialization/JsonSerializer.h"
 #include "Engine/Serialization/MemoryReadStream.h"
 #include "Engine/Threading/Threading.h"
 #include "FlaxEngine.Gen.h"
+#if USE_CSHARP
+#include "Engine/Scripting/ManagedCLR/MClass.h"
+#endif
 #if USE_EDITOR
 #include "Engine/Level/Level.h"
 #endif
 
+// Max amount of compiled selectors per tree (table is allocated once to be safely accessed without a lock)
+#define BEHAVIOR_TREE_MAX_SELECTORS 1024
+
 REGISTER_BINARY_ASSET(BehaviorTree, "FlaxEngine.BehaviorTree", false);
 
+namespace
+{
+    int64 SelectorsIdCounter = 0;
+
+    void CompileSelectorMember(BehaviorTreeCompiledSelector& selector)
+    {
+        typedef BehaviorTreeCompiledSelector::Accessors Accessors;
+        if (selector.Member.IsEmpty())
+        {
+            selector.Accessor = Accessors::Value;
+            return;
+        }
+        const StringAnsiView typeName(selector.TypeName);
+        selector.Type = Scripting::FindScriptingType(typeName);
+        if (selector.Type)
+        {
+            const ScriptingType& type = selector.Type.GetType();
+            if (type.Type == ScriptingTypes::Structure)
+            {
+                selector.MemberName = selector.Member.ToString();
+                selector.Accessor = Accessors::Structure;
+                return;
+            }
+            selector.Field = selector.Type.Module->FindField(selector.Type, selector.Member);
+            if (selector.Field)
+            {
+                selector.Accessor = Accessors::Field;
+                return;
+            }
+        }
+#if USE_CSHARP
+        if (const auto mClass = Scripting::FindClass(typeName))
+        {
+            if ((selector.Field = mClass->GetField(selector.Member.Get())))
+            {
+                selector.Accessor = Accessors::ManagedField;
+                return;
+            }
+            if ((selector.Field = mClass->GetProperty(selector.Member.Get())))
+            {
+                selector.Accessor = Accessors::ManagedProperty;
+                return;
+            }
+        }
+#endif
+        if (typeName.HasChars())
+        {
+            LOG(Warning, "Missing member '{0}' in scripting type '{1}'", String(selector.Member), String(typeName));
+        }
+    }
+
+    void CompileSelector(BehaviorTree* tree, BehaviorTreeCompiledSelector& selector)
+    {
+        typedef BehaviorTreeCompiledSelector::Sources Sources;
+        const StringAnsiView path(selector.Path);
+        const int32 sourceEnd = path.Find('/');
+        if (sourceEnd == -1)
+            return;
+        const StringAnsiView source(path.Get(), sourceEnd);
+        const StringAnsiView subPath(path.Get() + sourceEnd + 1, path.Length() - sourceEnd - 1);
+        if (source == "Blackboard")
+        {
+            // Blackboard/<member>
+            selector.Source = Sources::Blackboard;
+            if (tree->Graph.Root)
+                selector.TypeName = tree->Graph.Root->BlackboardType;
+            selector.Member = subPath;
+        }
+        else if (source == "Goal")
+        {
+            // Goal/<type>/<member>
+            selector.Source = Sources::Goal;
+            const int32 goalTypeEnd = subPath.Find('/');
+            if (goalTypeEnd == -1)
+            {
+                selector.TypeName = subPath;
+            }
+            else
+            {
+                selector.TypeName = StringAnsiView(subPath.Get(), goalTypeEnd);
+                selector.Member = StringAnsiView(subPath.Get() + goalTypeEnd + 1, subPath.Length() - goalTypeEnd - 1);
+            }
+        }
+        else
+            return;
+        CompileSelectorMember(selector);
+    }
+}
+
 #define IS_BT_NODE(n) (n.GroupID == 19 && (n.TypeID == 1 || n.TypeID == 2 || n.TypeID == 3))
 
 bool SortBehaviorTreeChildren(GraphBox* const& a, GraphBox* const& b)
@@ -149,6 +247,12 @@ void BehaviorTreeGraph::SetupRecursive(Node& node)
     }
 }
 
+BehaviorTree::~BehaviorTree()
+{
+    _selectors.ClearDelete();
+    DeleteRetiredSelectors(true);
+}
+
 BehaviorTree::BehaviorTree(const SpawnParams& params, const AssetInfo* info)
     : BinaryAsset(params, info)
 {
@@ -180,6 +284,65 @@ BytesContainer BehaviorTree::LoadSurface()
     return BytesContainer();
 }
 
+const BehaviorTreeCompiledSelector* BehaviorTree::GetSelector(const StringAnsiView& path, int64* cache)
+{
+    // Fast-path via cached selector index (encoded with the selectors table id to detect tree reloads)
+    if (cache)
+    {
+        const int64 cached = Platform::AtomicRead(cache);
+        if (cached != 0 && cached >> 16 == Platform::AtomicRead(&_selectorsId))
+        {
+            const BehaviorTreeCompiledSelector* selector = _selectors.Get()[cached & 0xffff];
+            if (selector->Path == path)
+                return selector;
+        }
+    }
+
+    PROFILE_CPU();
+    ScopeLock lock(_selectorsLocker);
+    DeleteRetiredSelectors(false);
+    int32 index;
+    if (!_selectorsLookup.TryGet(path, index))
+    {
+        if (_selectors.Count() == BEHAVIOR_TREE_MAX_SELECTORS)
+            return nullptr;
+        if (_selectors.IsEmpty())
+        {
+            // Allocate table once so it's never moved when other threads read it
+            _selectors.EnsureCapacity(BEHAVIOR_TREE_MAX_SELECTORS, false);
+            Platform::AtomicStore(&_selectorsId, Platform::InterlockedIncrement(&SelectorsIdCounter));
+        }
+        auto selector = New<BehaviorTreeCompiledSelector>();
+        selector->Path = path;
+        CompileSelector(this, *selector);
+        index = _selectors.Count();
+        _selectors.Add(selector);
+        _selectorsLookup.Add(selector->Path, index);
+    }
+    if (cache)
+        Platform::AtomicStore(cache, (_selectorsId << 16) | index);
+    return _selectors.Get()[index];
+}
+
+void BehaviorTree::ClearSelectors()
+{
+    ScopeLock lock(_selectorsLocker);
+    Platform::AtomicStore(&_selectorsId, 0);
+    _selectorsLookup.Clear();
+
+    // Other threads might still read selectors via the lock-free cached path so delete them a few frames later
+    DeleteRetiredSelectors(false);
+    _selectorsRetired.Add(_selectors);
+    _selectorsRetiredFrame = Engine::FrameCount;
+    _selectors.Clear();
+}
+
+void BehaviorTree::DeleteRetiredSelectors(bool force)
+{
+    if (_selectorsRetired.HasItems() && (force || Engine::FrameCount > _selectorsRetiredFrame + 2))
+        _selectorsRetired.ClearDelete();
+}
+
 #if USE_EDITOR
 
 bool BehaviorTree::SaveSurface(const BytesContainer& data)
@@ -221,6 +384,7 @@ void BehaviorTree::OnScriptsReloadStart()
     }
 
     // Clear state
+    ClearSelectors();
     Graph.Root = nullptr;
     Graph.NodesCount = 0;
     Graph.NodesStatesSize = 0;
@@ -293,6 +457,7 @@ void BehaviorTree::unload(bool isReloading)
 #endif
 
     // Clear resources
+    ClearSelectors();
     Graph.Clear();
 }
 
@@ -4,6 +4,9 @@
 
 #include "Engine/Content/BinaryAsset.h"
 #include "Engine/Visject/VisjectGraph.h"
+#include "Engine/Core/Collections/Dictionary.h"
+#include "Engine/Platform/CriticalSection.h"
+#include "Engine/Scripting/ScriptingType.h"
 
 class BehaviorKnowledge;
 class BehaviorTree;
@@ -52,6 +55,49 @@ class BehaviorTreeExecutor : public VisjectExecutor
 {
 };
 
+/// <summary>
+/// Behavior knowledge selector path compiled for a specific Behavior Tree. Contains parsed path and the value member accessor resolved once for the container type.
+/// </summary>
+struct FLAXENGINE_API BehaviorTreeCompiledSelector
+{
+    enum class Sources : byte
+    {
+        Blackboard,
+        Goal,
+    };
+
+    enum class Accessors : byte
+    {
+        // Invalid path or missing type.
+        Invalid,
+        // Whole container value.
+        Value,
+        // Native structure field (via scripting type getter/setter).
+        Structure,
+        // Binary module field (handle from FindField).
+        Field,
+        // C# field (MField).
+        ManagedField,
+        // C# property (MProperty).
+        ManagedProperty,
+    };
+
+    // The full selector path.
+    StringAnsi Path;
+    // The container value type name (blackboard or goal type).
+    StringAnsi TypeName;
+    // The container member name.
+    StringAnsi Member;
+    // The container member name (for native structure accessor).
+    String MemberName;
+    // The container type.
+    ScriptingTypeHandle Type;
+    // The resolved member handle (depends on the accessor).
+    void* Field = nullptr;
+    Sources Source = Sources::Blackboard;
+    Accessors Accessor = Accessors::Invalid;
+};
+
 /// <summary>
 /// Behavior Tree asset with AI logic graph.
 /// </summary>
@@ -59,6 +105,7 @@ class BehaviorTreeExecutor : public VisjectExecutor
 API_CLASS(NoSpawn, Sealed) class FLAXENGINE_API BehaviorTree : public BinaryAsset
 {
     DECLARE_BINARY_ASSET_HEADER(BehaviorTree, 1);
+    ~BehaviorTree();
 
 public:
     /// <summary>
@@ -79,6 +126,14 @@ API_CLASS(NoSpawn, Sealed) class FLAXENGINE_API BehaviorTree : public BinaryAsse
     /// <returns>The surface data or empty if failed to load it.</returns>
     API_FUNCTION() BytesContainer LoadSurface();
 
+    /// <summary>
+    /// Gets the knowledge selector compiled for this tree. Selector path is parsed and its member accessor resolved only once, then reused by all behaviors that run this tree.
+    /// </summary>
+    /// <param name="path">The selector path.</param>
+    /// <param name="cache">The optional selector cache value (zero-initialized) used to skip lookup on subsequent calls. Can be null.</param>
+    /// <returns>The compiled selector or null if cannot compile it (eg. selectors table is full).</returns>
+    const BehaviorTreeCompiledSelector* GetSelector(const StringAnsiView& path, int64* cache = nullptr);
+
 #if USE_EDITOR
     /// <summary>
     /// Updates the graph surface (save new one, discard cached data, reload asset).
@@ -89,6 +144,15 @@ API_CLASS(NoSpawn, Sealed) class FLAXENGINE_API BehaviorTree : public BinaryAsse
 #endif
 
 private:
+    CriticalSection _selectorsLocker;
+    Array<BehaviorTreeCompiledSelector*> _selectors;
+    Array<BehaviorTreeCompiledSelector*> _selectorsRetired;
+    uint64 _selectorsRetiredFrame = 0;
+    Dictionary<StringAnsi, int32> _selectorsLookup;
+    int64 _selectorsId = 0;
+
+    void ClearSelectors();
+    void DeleteRetiredSelectors(bool force);
 #if USE_EDITOR
     void OnScriptsReloadStart();
     void OnScriptsReloadEnd();
@@ -1,7 +1,6 @@
 // Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
 
 #include "AudioClip.h"
-#include "Audio.h"
 #include "AudioSource.h"
 #include "AudioBackend.h"
 #include "Engine/Core/Log.h"
@@ -13,52 +12,180 @@
 #include "Engine/Tools/AudioTool/OggVorbisDecoder.h"
 #include "Engine/Tools/AudioTool/AudioTool.h"
 #include "Engine/Threading/Threading.h"
+#include "Engine/Threading/ThreadLocal.h"
+#include "Engine/Engine/EngineService.h"
 
 REGISTER_BINARY_ASSET_WITH_UPGRADER(AudioClip, "FlaxEngine.AudioClip", AudioClipUpgrader, false);
 
+namespace
+{
+    // Per-thread audio decoding state reused by the streaming tasks (avoids allocations for every decoded chunk)
+    struct AudioDecodeContext
+    {
+#if COMPILE_WITH_OGG_VORBIS
+        OggVorbisDecoder Decoder;
+#endif
+        Array<byte> Data;
+        Array<byte> MonoData;
+    };
+
+    ThreadLocal<AudioDecodeContext*> DecodeContexts;
+
+    AudioDecodeContext& GetDecodeContext()
+    {
+        auto& context = DecodeContexts.Get();
+        if (!context)
+            context = New<AudioDecodeContext>();
+        return *context;
+    }
+
+    void ReleaseDecodeContextBuffers()
+    {
+        // Free the decoded samples buffers (eg. after loading the whole clip at once that can be much larger than streamed chunks)
+        auto context = DecodeContexts.Get();
+        if (context)
+        {
+            context->Data.SetCapacity(0, false);
+            context->MonoData.SetCapacity(0, false);
+        }
+    }
+
+    bool DecodeChunk(const FlaxChunk* chunk, const AudioClip::Header& header, Span<byte>& data, AudioDataInfo& info)
+    {
+        if (chunk == nullptr || chunk->IsMissing())
+        {
+            LOG(Warning, "Missing audio data.");
+            return true;
+        }
+        auto& context = GetDecodeContext();
+        info = header.Info;
+        const uint32 bytesPerSample = info.BitDepth / 8;
+
+        // Get raw data or decompress it
+        switch (header.Format)
+        {
+        case AudioFormat::Vorbis:
+        {
+#if COMPILE_WITH_OGG_VORBIS
+            // Each chunk is a separate Ogg stream so decoder gets reopened but the decoder and its output buffer are reused
+            MemoryReadStream stream(chunk->Get(), chunk->Size());
+            AudioDataInfo tmpInfo;
+            if (!context.Decoder.Open(&stream, tmpInfo))
+            {
+                LOG(Warning, "Audio data decode failed (OggVorbisDecoder).");
+                return true;
+            }
+            // TODO: validate decompressed data header info?
+            context.Data.Resize(tmpInfo.NumSamples * (tmpInfo.BitDepth / 8), false);
+            context.Decoder.Read(context.Data.Get(), tmpInfo.NumSamples);
+            data = Span<byte>(context.Data.Get(), context.Data.Count());
+#else
+            LOG(Warning, "OggVorbisDecoder is disabled.");
+            return true;
+#endif
+        }
+        break;
+        case AudioFormat::Raw:
+            data = Span<byte>((byte*)chunk->Get(), chunk->Size());
+            break;
+        default:
+            return true;
+        }
+        info.NumSamples = Math::AlignDown(data.Length() / bytesPerSample, info.NumChannels * bytesPerSample);
+
+        // Convert to Mono if used as 3D source and backend doesn't support it
+        if (header.Is3D && info.NumChannels > 1 && EnumHasNoneFlags(AudioBackend::Features(), AudioBackend::FeatureFlags::SpatialMultiChannel))
+        {
+            const uint32 samplesPerChannel = info.NumSamples / info.NumChannels;
+            const uint32 monoBufferSize = samplesPerChannel * bytesPerSample;
+            context.MonoData.Resize(monoBufferSize, false);
+            AudioTool::ConvertToMono(data.Get(), context.MonoData.Get(), info.BitDepth, samplesPerChannel, info.NumChannels);
+            info.NumChannels = 1;
+            info.NumSamples = samplesPerChannel;
+            data = Span<byte>(context.MonoData.Get(), context.MonoData.Count());
+        }
+
+        return false;
+    }
+}
+
+class AudioClipService : public EngineService
+{
+public:
+    AudioClipService()
+        : EngineService(TEXT("Audio Clips"))
+    {
+    }
+
+    void Dispose() override
+    {
+        Array<AudioDecodeContext*> contexts;
+        DecodeContexts.GetValues(contexts);
+        contexts.ClearDelete();
+        DecodeContexts.Clear();
+    }
+};
+
+AudioClipService AudioClipServiceInstance;
+
 bool AudioClip::StreamingTask::Run()
 {
     AssetReference<AudioClip> ref = _asset.Get();
     if (ref == nullptr || AudioBackend::Instance == nullptr)
         return true;
-    ScopeLock lock(ref->Locker);
-    const auto& queue = ref->StreamingQueue;
+    auto clip = ref.Get();
+    Array<int32, FixedAllocation<ASSET_FILE_DATA_CHUNKS>> queue;
+    {
+        ScopeLock lock(clip->Locker);
+        queue = clip->StreamingQueue;
+    }
     if (queue.Count() == 0)
         return false;
-    auto clip = ref.Get();
 
     // Update the buffers
     for (int32 i = 0; i < queue.Count(); i++)
     {
         const auto idx = queue[i];
-        uint32& bufferId = clip->Buffers[idx];
-        if (bufferId == AUDIO_BUFFER_ID_INVALID)
-        {
-            bufferId = AudioBackend::Buffer::Create();
-        }
-        else
+        FlaxChunk* chunk;
+        Header header;
         {
-            // Release unused data
-            AudioBackend::Buffer::Delete(bufferId);
-            bufferId = AUDIO_BUFFER_ID_INVALID;
+            ScopeLock lock(clip->Locker);
+            if (!clip->IsLoaded() || idx >= clip->Buffers.Count())
+                return true;
+            uint32& bufferId = clip->Buffers[idx];
+            if (bufferId != AUDIO_BUFFER_ID_INVALID)
+            {
+                // Release unused data
+                AudioBackend::Buffer::Delete(bufferId);
+                bufferId = AUDIO_BUFFER_ID_INVALID;
+                continue;
+            }
+
+            // Pin the chunk for decoding (the task keeps the storage chunks locked so its data won't be released) and copy the header that gets cleared on unload
+            chunk = clip->GetChunk(idx);
+            header = clip->AudioHeader;
         }
-    }
 
-    // Load missing buffers data (from asset chunks)
-    for (int32 i = 0; i < queue.Count(); i++)
-    {
-        if (clip->WriteBuffer(queue[i]))
-        {
+        // Decode data outside the lock to not stall audio sources update
+        Span<byte> data;
+        AudioDataInfo info;
+        if (DecodeChunk(chunk, header, data, info))
             return true;
-        }
+
+        // Load missing buffer data (clip could be unloaded or buffer created in the meantime)
+        ScopeLock lock(clip->Locker);
+        if (!clip->IsLoaded() || idx >= clip->Buffers.Count() || clip->Buffers[idx] != AUDIO_BUFFER_ID_INVALID)
+            return true;
+        uint32& bufferId = clip->Buffers[idx];
+        bufferId = AudioBackend::Buffer::Create();
+        AudioBackend::Buffer::Write(bufferId, data.Get(), info);
     }
 
     // Update the sources
-    for (int32 sourceIndex = 0; sourceIndex < Audio::Sources.Count(); sourceIndex++)
+    ScopeLock lock(clip->Locker);
+    for (AudioSource* src : clip->_sources)
     {
-        // TODO: collect refs to audio clip from sources and use faster iteration (but do it thread-safe)
-        const auto src = Audio::Sources[sourceIndex];
-        if (src->Clip == clip && src->GetState() == AudioSource::States::Playing)
+        if (src->GetState() == AudioSource::States::Playing)
         {
             src->RequestStreamingBuffersUpdate();
         }
@@ -96,6 +223,8 @@ AudioClip::AudioClip(const SpawnParams& params, const AssetInfo* info)
 AudioClip::~AudioClip()
 {
     ASSERT(_streamingTask == nullptr);
+    for (AudioSource* src : _sources)
+        src->_registeredClip = nullptr;
 }
 
 float AudioClip::GetBufferStartTime(int32 bufferIndex) const
@@ -387,13 +516,8 @@ void AudioClip::unload(bool isReloading)
         hasAnyBuffer |= bufferId != AUDIO_BUFFER_ID_INVALID;
 
     // Stop any audio sources that are using this clip right now
-    // TODO: find better way to collect audio sources using audio clip and impl it for AudioStreamingHandler too
-    for (int32 sourceIndex = 0; sourceIndex < Audio::Sources.Count(); sourceIndex++)
-    {
-        const auto src = Audio::Sources[sourceIndex];
-        if (src->Clip == this)
-            src->Stop();
-    }
+    for (AudioSource* src : _sources)
+        src->Stop();
 
     StopStreaming();
     StreamingQueue.Clear();
@@ -410,6 +534,11 @@ void AudioClip::unload(bool isReloading)
     Platform::MemoryClear(&AudioHeader, sizeof(AudioHeader));
 }
 
+bool AudioClip::DecodeBuffer(int32 chunkIndex, Span<byte>& data, AudioDataInfo& info)
+{
+    return DecodeChunk(GetChunk(chunkIndex), AudioHeader, data, info);
+}
+
 bool AudioClip::WriteBuffer(int32 chunkIndex)
 {
     // Ignore if buffer is not created
@@ -421,60 +550,27 @@ bool AudioClip::WriteBuffer(int32 chunkIndex)
     if (AudioBackend::Instance == nullptr)
         return true;
 
-    const auto chunk = GetChunk(chunkIndex);
-    if (chunk == nullptr || chunk->IsMissing())
-    {
-        LOG(Warning, "Missing audio data.");
-        return true;
-    }
     Span<byte> data;
-    Array<byte> tmp1, tmp2;
-    AudioDataInfo info = AudioHeader.Info;
-    const uint32 bytesPerSample = info.BitDepth / 8;
-
-    // Get raw data or decompress it
-    switch (Format())
-    {
-    case AudioFormat::Vorbis:
-    {
-#if COMPILE_WITH_OGG_VORBIS
-        OggVorbisDecoder decoder;
-        MemoryReadStream stream(chunk->Get(), chunk->Size());
-        AudioDataInfo tmpInfo;
-        if (decoder.Convert(&stream, tmpInfo, tmp1))
-        {
-            LOG(Warning, "Audio data decode failed (OggVorbisDecoder).");
-            return true;
-        }
-        // TODO: validate decompressed data header info?
-        data = Span<byte>(tmp1.Get(), tmp1.Count());
-#else
-		LOG(Warning, "OggVorbisDecoder is disabled.");
-		return true;
-#endif
-    }
-    break;
-    case AudioFormat::Raw:
-        data = Span<byte>(chunk->Get(), chunk->Size());
-        break;
-    default:
+    AudioDataInfo info;
+    if (DecodeBuffer(chunkIndex, data, info))
         return true;
-    }
-    info.NumSamples = Math::AlignDown(data.Length() / bytesPerSample, info.NumChannels * bytesPerSample);
-
-    // Convert to Mono if used as 3D source and backend doesn't support it
-    if (Is3D() && info.NumChannels > 1 && EnumHasNoneFlags(AudioBackend::Features(), AudioBackend::FeatureFlags::SpatialMultiChannel))
-    {
-        const uint32 samplesPerChannel = info.NumSamples / info.NumChannels;
-        const uint32 monoBufferSize = samplesPerChannel * bytesPerSample;
-        tmp2.Resize(monoBufferSize);
-        AudioTool::ConvertToMono(data.Get(), tmp2.Get(), info.BitDepth, samplesPerChannel, info.NumChannels);
-        info.NumChannels = 1;
-        info.NumSamples = samplesPerChannel;
-        data = Span<byte>(tmp2.Get(), tmp2.Count());
-    }
 
     // Write samples to the audio buffer
     AudioBackend::Buffer::Write(bufferId, data.Get(), info);
+
+    // Per-thread decoding buffers are reused only by the streamed chunks so don't keep the whole clip data on the loading thread
+    ReleaseDecodeContextBuffers();
     return false;
 }
+
+void AudioClip::AddSource(AudioSource* source)
+{
+    ScopeLock lock(Locker);
+    _sources.Add(source);
+}
+
+void AudioClip::RemoveSource(AudioSource* source)
+{
+    ScopeLock lock(Locker);
+    _sources.Remove(source);
+}
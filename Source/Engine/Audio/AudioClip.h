@@ -6,6 +6,7 @@
 #include "Engine/Streaming/StreamableResource.h"
 #include "Engine/Content/WeakAssetReference.h"
 #include "Engine/Threading/ThreadPoolTask.h"
+#include "Engine/Core/Types/Span.h"
 #include "Types.h"
 #include "Config.h"
 
@@ -18,6 +19,8 @@ class AudioSource;
 API_CLASS(NoSpawn) class FLAXENGINE_API AudioClip : public BinaryAsset, public StreamableResource
 {
     DECLARE_BINARY_ASSET_HEADER(AudioClip, 2);
+    friend class AudioSource;
+    friend class AudioStreamingHandler;
 
 public:
     /// <summary>
@@ -72,6 +75,7 @@ API_CLASS(NoSpawn) class FLAXENGINE_API AudioClip : public BinaryAsset, public S
     int32 _totalChunksSize;
     StreamingTask* _streamingTask;
     float _buffersStartTimes[ASSET_FILE_DATA_CHUNKS + 1];
+    Array<AudioSource*> _sources; // Enabled audio sources that use this clip (guarded by Locker)
 
 public:
     /// <summary>
@@ -205,6 +209,15 @@ API_CLASS(NoSpawn) class FLAXENGINE_API AudioClip : public BinaryAsset, public S
     void unload(bool isReloading) override;
 
 private:
-    // Writes audio samples into Audio Backend buffer and handles automatic decompression or format conversion for runtime playback.
+    // Gets audio samples of the chunk and handles automatic decompression or format conversion for runtime playback. Decoded data is kept in a per-thread cache and remains valid until the next decode on the same thread.
+    bool DecodeBuffer(int32 chunkIndex, Span<byte>& data, AudioDataInfo& info);
+
+    // Writes audio samples into Audio Backend buffer.
     bool WriteBuffer(int32 chunkIndex);
+
+    // Registers the enabled audio source that uses this clip.
+    void AddSource(AudioSource* source);
+
+    // Unregisters the audio source that uses this clip.
+    void RemoveSource(AudioSource* source);
 };
@@ -276,6 +276,20 @@ void AudioSource::OnClipChanged()
 {
     Stop();
     _clipChanged = true;
+    if (_isEnabled)
+        SetRegisteredClip(Clip.Get());
+}
+
+void AudioSource::SetRegisteredClip(AudioClip* clip)
+{
+    // Keep the clip informed about the sources using it (used by the clip streaming and unloading)
+    if (_registeredClip == clip)
+        return;
+    if (_registeredClip)
+        _registeredClip->RemoveSource(this);
+    _registeredClip = clip;
+    if (clip)
+        clip->AddSource(this);
 }
 
 void AudioSource::OnClipLoaded()
@@ -489,8 +503,9 @@ void AudioSource::Update()
             }
             ASSERT(_streamingFirstChunk < clip->Buffers.Count());
 
-            // Update clip data streaming
+            // Update clip data streaming (read-ahead chunks that are already streamed in get queued during the next update)
             clip->RequestStreamingUpdate();
+            _needToUpdateStreamingBuffers = true;
         }
     }
 
@@ -504,6 +519,7 @@ void AudioSource::OnEnable()
     _clipChanged = false;
 
     Audio::OnAddSource(this);
+    SetRegisteredClip(Clip.Get());
     GetScene()->Ticking.Update.AddTick<AudioSource, &AudioSource::Update>(this);
 #if USE_EDITOR
     GetSceneRendering()->AddViewportIcon(this);
@@ -521,6 +537,7 @@ void AudioSource::OnDisable()
     GetSceneRendering()->RemoveViewportIcon(this);
 #endif
     GetScene()->Ticking.Update.RemoveTick(this);
+    SetRegisteredClip(nullptr);
     Audio::OnRemoveSource(this);
 
     // Base
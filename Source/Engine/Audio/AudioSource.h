@@ -63,6 +63,7 @@ class FLAXENGINE_API AudioSource : public Actor
     States _savedState = States::Stopped;
     float _savedTime = 0;
     int32 _streamingFirstChunk = 0;
+    AudioClip* _registeredClip = nullptr;
 
 public:
     /// <summary>
@@ -296,6 +297,7 @@ class FLAXENGINE_API AudioSource : public Actor
 private:
     void OnClipChanged();
     void OnClipLoaded();
+    void SetRegisteredClip(AudioClip* clip);
 
     /// <summary>
     /// Sets the single buffer from the audio clip that is not using dynamic streaming
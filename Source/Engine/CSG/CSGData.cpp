@@ -15,15 +15,10 @@ namespace CSG
 
     public:
 
-        struct Node : RectPack<Node, float>
+        struct Node : RectPackNode<float>
         {
-            Node(float xy, float wh)
-                : RectPack<Node, float>(xy, xy, wh, wh)
-            {
-            }
-
             Node(float x, float y, float width, float height)
-                : RectPack<Node, float>(x, y, width, height)
+                : RectPackNode<float>(x, y, width, height)
             {
             }
 
@@ -32,18 +27,22 @@ namespace CSG
                 const float invSize = 1.0f / atlasSize;
                 chart->UVsArea = Rectangle(X * invSize, Y * invSize, chart->Size.X * invSize, chart->Size.Y * invSize);
             }
+
+            void OnFree()
+            {
+            }
         };
 
     private:
 
-        Node _root;
+        RectPackAtlas<Node> _atlas;
         const float _atlasSize;
         const float _chartsPadding;
 
     public:
 
         LightmapUVsPacker(float atlasSize, float chartsPadding)
-            : _root(chartsPadding, atlasSize - chartsPadding)
+            : _atlas(chartsPadding, chartsPadding, atlasSize - chartsPadding, atlasSize - chartsPadding)
             , _atlasSize(atlasSize)
             , _chartsPadding(chartsPadding)
         {
@@ -55,7 +54,7 @@ namespace CSG
 
         Node* Insert(ChartType chart)
         {
-            return _root.Insert(chart->Size.X, chart->Size.Y, _chartsPadding, chart, _atlasSize);
+            return _atlas.Insert(chart->Size.X, chart->Size.Y, _chartsPadding, chart, _atlasSize);
         }
     };
 }
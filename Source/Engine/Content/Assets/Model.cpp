@@ -123,6 +123,7 @@ class StreamModelSDFTask : public GPUUploadTextureMipTask
         , _asset(model)
         , _dataLock(model->Storage->Lock())
     {
+        SetPriority(Priority::Low);
     }
 
     bool HasReference(Object* resource) const override
@@ -5,6 +5,7 @@
 #include "Engine/Core/DeleteMe.h"
 #include "Engine/Core/Types/TimeSpan.h"
 #include "Engine/Core/Types/DateTime.h"
+#include "Engine/Core/Types/Pair.h"
 #include "Engine/Core/Types/Stopwatch.h"
 #include "Engine/Platform/FileSystem.h"
 #include "Engine/Serialization/FileWriteStream.h"
@@ -21,6 +22,8 @@ void AssetsCache::Init()
 {
     Entry e;
     int32 count;
+    Registry registry;
+    PathsMapping pathsMapping;
     Stopwatch stopwatch;
 #if USE_EDITOR
     _path = Globals::ProjectCacheFolder / TEXT("AssetsCache.dat");
@@ -71,13 +74,9 @@ void AssetsCache::Init()
         return;
     }
 
-    ScopeLock lock(_locker);
-    _isDirty = false;
-
-    // Load elements count
+    // Load elements count (data is loaded into the local containers to not hold the lock during file access)
     stream->ReadInt32(&count);
-    _registry.Clear();
-    _registry.EnsureCapacity(count);
+    registry.EnsureCapacity(count);
 
     // Load data
     int32 rejectedCount = 0;
@@ -101,15 +100,14 @@ void AssetsCache::Init()
 
         // Use only valid entries
         if (IsEntryValid(e))
-            _registry.Add(e.Info.ID, e);
+            registry.Add(e.Info.ID, e);
         else
             rejectedCount++;
     }
 
     // Paths mapping
     stream->ReadInt32(&count);
-    _pathsMapping.Clear();
-    _pathsMapping.EnsureCapacity(count);
+    pathsMapping.EnsureCapacity(count);
     for (int32 i = 0; i < count; i++)
     {
         Guid id;
@@ -123,7 +121,7 @@ void AssetsCache::Init()
             mappedPath = Globals::StartupFolder / mappedPath;
         }
 
-        _pathsMapping.Add(mappedPath, id);
+        pathsMapping.Add(mappedPath, id);
     }
 
     // Check errors
@@ -131,17 +129,23 @@ void AssetsCache::Init()
     deleteStream.Delete();
     if (hasError)
     {
-        _isDirty = true;
-        _registry.Clear();
+        registry.Clear();
         LOG(Warning, "Asset Cache file has an error. Removing it.");
         if (FileSystem::DeleteFile(_path))
         {
             LOG(Error, "Cannot delete registry file after reading error.");
         }
     }
+    {
+        ScopeWriteLock lock(_locker);
+        _isDirty = hasError;
+        _registry.Swap(registry);
+        _pathsMapping.Swap(pathsMapping);
+        RebuildIndex();
+    }
 
     stopwatch.Stop();
-    LOG(Info, "Asset Cache loaded {0} entries in {1}ms ({2} rejected)", _registry.Count(), stopwatch.GetMilliseconds(), rejectedCount);
+    LOG(Info, "Asset Cache loaded {0} entries in {1}ms ({2} rejected)", Size(), stopwatch.GetMilliseconds(), rejectedCount);
 }
 
 bool AssetsCache::Save()
@@ -153,12 +157,22 @@ bool AssetsCache::Save()
     if (!_isDirty && FileSystem::FileExists(_path))
         return false;
 
-    ScopeLock lock(_locker);
+    // Copy data to not hold the lock during file writing (modifications done in the meantime mark it dirty again)
+    Registry registry;
+    PathsMapping pathsMapping;
+    {
+        ScopeWriteLock lock(_locker);
+        registry = _registry;
+        pathsMapping = _pathsMapping;
+        _isDirty = false;
+    }
 
-    if (Save(_path, _registry, _pathsMapping))
+    if (Save(_path, registry, pathsMapping))
+    {
+        ScopeWriteLock lock(_locker);
+        _isDirty = true;
         return true;
-
-    _isDirty = false;
+    }
 
 #endif
 
@@ -224,105 +238,71 @@ bool AssetsCache::Save(const StringView& path, const Registry& entries, const Pa
 
 const String& AssetsCache::GetEditorAssetPath(const Guid& id) const
 {
-    ScopeLock lock(_locker);
+    ScopeReadLock lock(_locker);
 #if USE_EDITOR
     auto e = _registry.TryGet(id);
     return e ? e->Info.Path : String::Empty;
 #else
-    for (auto& e : _pathsMapping)
-    {
-        if (e.Value == id)
-            return e.Key;
-    }
-    return String::Empty;
+    auto path = _idsMapping.TryGet(id);
+    return path ? *path : String::Empty;
 #endif
 }
 
 bool AssetsCache::FindAsset(const StringView& path, AssetInfo& info)
 {
     PROFILE_CPU();
-
-    bool result = false;
-
-    ScopeLock lock(_locker);
-
-    // Check if asset has direct mapping to id (used for some cooked assets)
-    Guid id;
-    if (_pathsMapping.TryGet(path, id))
+    Entry e;
     {
-        return FindAsset(id, info);
-    }
+        ScopeReadLock lock(_locker);
+
+        // Check if asset has direct mapping to id (used for some cooked assets)
+        Guid id;
+        bool found = _pathsMapping.TryGet(path, id);
 #if !USE_EDITOR
-    if (FileSystem::IsRelative(path))
-    {
-        // Additional check if user provides path relative to the project folder (eg. Content/SomeAssets/MyFile.json)
-        const String absolutePath = Globals::ProjectFolder / *path;
-        if (_pathsMapping.TryGet(absolutePath, id))
+        if (!found && FileSystem::IsRelative(path))
         {
-            return FindAsset(id, info);
+            // Additional check if user provides path relative to the project folder (eg. Content/SomeAssets/MyFile.json)
+            const String absolutePath = Globals::ProjectFolder / *path;
+            found = _pathsMapping.TryGet(absolutePath, id);
         }
-    }
 #endif
 
-    // Find asset in registry
-    for (auto i = _registry.Begin(); i.IsNotEnd(); ++i)
-    {
-        auto& e = i->Value;
-        if (e.Info.Path == path)
-        {
-            if (!IsEntryValid(e))
-            {
-                LOG(Warning, "Missing file from registry: \'{0}\':{1}:{2}", e.Info.Path, e.Info.ID, e.Info.TypeName);
-                _registry.Remove(i);
-            }
-            else
-            {
-                // Found
-                result = true;
-                info = e.Info;
-            }
-
-            break;
-        }
+        // Find asset in registry
+        if (!found && !FindPathIndex(path, id))
+            return false;
+        const Entry* entry = _registry.TryGet(id);
+        if (entry == nullptr)
+            return false;
+        e = *entry;
     }
-
-    return result;
+    return ValidateEntry(e, info);
 }
 
 bool AssetsCache::FindAsset(const Guid& id, AssetInfo& info)
 {
     PROFILE_CPU();
-    bool result = false;
-    ScopeLock lock(_locker);
-    auto e = _registry.TryGet(id);
-    if (e != nullptr)
+    Entry e;
     {
-        if (!IsEntryValid(*e))
-        {
-            LOG(Warning, "Missing file from registry: \'{0}\':{1}:{2}", e->Info.Path, e->Info.ID, e->Info.TypeName);
-            _registry.Remove(id);
-        }
-        else
-        {
-            // Found
-            result = true;
-            info = e->Info;
-        }
+        ScopeReadLock lock(_locker);
+        const Entry* entry = _registry.TryGet(id);
+        if (entry == nullptr)
+            return false;
+        e = *entry;
     }
-    return result;
+    return ValidateEntry(e, info);
 }
 
 void AssetsCache::GetAll(Array<Guid>& result) const
 {
     PROFILE_CPU();
-    ScopeLock lock(_locker);
+    ScopeReadLock lock(_locker);
     _registry.GetKeys(result);
 }
 
 void AssetsCache::GetAllByTypeName(const StringView& typeName, Array<Guid>& result) const
 {
     PROFILE_CPU();
-    ScopeLock lock(_locker);
+    ScopeReadLock lock(_locker);
     for (auto i = _registry.Begin(); i.IsNotEnd(); ++i)
     {
         if (i->Value.Info.TypeName == typeName)
@@ -340,49 +320,39 @@ void AssetsCache::RegisterAssets(FlaxStorage* storage)
     Array<FlaxStorage::Entry> entries;
     storage->GetEntries(entries);
     ASSERT(entries.HasItems());
-
-    ScopeLock lock(_locker);
     auto storagePath = storage->GetPath();
+    const String storagePathKey = GetPathKey(storagePath);
 
-    // Remove all old entries from that location
-    for (auto i = _registry.Begin(); i.IsNotEnd(); ++i)
+    // Copy registry entries using the same IDs but located in other files (validated outside the lock, path keys are case-insensitive on Windows so a project opened via a different drive letter case is not a collision)
+    Array<Pair<int32, Entry>> collisions;
     {
-        if (i->Value.Info.Path == storagePath)
-            _registry.Remove(i);
+        ScopeReadLock lock(_locker);
+        for (int32 i = 0; i < entries.Count(); i++)
+        {
+            auto& e = entries[i];
+            ASSERT(e.ID.IsValid());
+            const auto entry = _registry.TryGet(e.ID);
+            if (entry && GetPathKey(entry->Info.Path) != storagePathKey)
+                collisions.Add(Pair<int32, Entry>(i, *entry));
+        }
     }
 
     // Find asset IDs collisions
     AssetInfo info;
     Array<int32> duplicatedEntries;
-    for (int32 i = 0; i < entries.Count(); i++)
+    Array<Entry> removedEntries;
+    for (auto& collision : collisions)
     {
-        auto& e = entries[i];
-        ASSERT(e.ID.IsValid());
-
-        // Check if storage contains ID which has been already registered
-        if (FindAsset(e.ID, info))
+        Entry& existing = collision.Second;
+        if (!IsEntryValid(existing))
         {
-#if PLATFORM_WINDOWS
-            // On Windows - if you start your project using a shortcut/VS commandline -project, and using a upper/lower drive letter, it could the cache (case doesn't matter on OS)
-            if (StringUtils::CompareIgnoreCase(storagePath.GetText(), info.Path.GetText()) != 0)
-            {
-                LOG(Warning, "Founded duplicated asset \'{0}\'. Locations: \'{1}\' and \'{2}\'", e.ID, storagePath, info.Path);
-                duplicatedEntries.Add(i);
-            }
-            else
-            {
-                // Remove from registry so we can add it again later with the original ID, so we don't loose relations
-                for (auto j = _registry.Begin(); j.IsNotEnd(); ++j)
-                {
-                    if (StringUtils::CompareIgnoreCase(j->Value.Info.Path.GetText(), storagePath.GetText()) == 0)
-                        _registry.Remove(j);
-                }
-            }
-#else
-            LOG(Warning, "Founded duplicated asset \'{0}\'. Locations: \'{1}\' and \'{2}\'", e.ID, storagePath, info.Path);
-            duplicatedEntries.Add(i);
-#endif
+            LOG(Warning, "Missing file from registry: \'{0}\':{1}:{2}", existing.Info.Path, existing.Info.ID, existing.Info.TypeName);
+            removedEntries.Add(existing);
+            continue;
         }
+        info = existing.Info;
+        LOG(Warning, "Founded duplicated asset \'{0}\'. Locations: \'{1}\' and \'{2}\'", info.ID, storagePath, info.Path);
+        duplicatedEntries.Add(collision.First);
     }
 
     // Check if need to resolve any collisions
@@ -396,7 +366,7 @@ void AssetsCache::RegisterAssets(FlaxStorage* storage)
             return;
         }
 
-        // Process all duplicated entries
+        // Process all duplicated entries (modifies the file so it's done outside the lock)
         for (int32 i = 0; i < duplicatedEntries.Count(); i++)
         {
             auto& e = entries[duplicatedEntries[i]];
@@ -410,16 +380,51 @@ void AssetsCache::RegisterAssets(FlaxStorage* storage)
         }
     }
 
-    // Register all entries
+    // Send info
     for (int32 i = 0; i < entries.Count(); i++)
     {
         auto& e = entries[i];
-
-        // Send info
         LOG(Info, "Register asset {0}:{1} \'{2}\'", e.ID, e.TypeName, storagePath);
+    }
 
-        // Add new asset entry
-        _registry.Add(e.ID, Entry(e.ID, e.TypeName, storagePath));
+    ScopeWriteLock lock(_locker);
+
+    // Remove all old entries from that location
+    if (const auto ids = _pathsIndex.TryGet(storagePathKey))
+    {
+        for (const Guid& id : *ids)
+            _registry.Remove(id);
+        _pathsIndex.Remove(storagePathKey);
+    }
+
+    // Remove invalid entries found during validation (unless registry has been modified in the meantime)
+    for (const Entry& e : removedEntries)
+    {
+        const auto entry = _registry.TryGet(e.Info.ID);
+        if (entry && entry->Info.Path == e.Info.Path)
+        {
+            RemovePathIndex(*entry);
+            _registry.Remove(e.Info.ID);
+        }
+    }
+
+    // Register all entries
+    for (int32 i = 0; i < entries.Count(); i++)
+    {
+        auto& e = entries[i];
+
+        // Add new asset entry (replace the one added by other thread after validation)
+        const Entry entry(e.ID, e.TypeName, storagePath);
+        if (const auto existing = _registry.TryGet(e.ID))
+        {
+            RemovePathIndex(*existing);
+            *existing = entry;
+        }
+        else
+        {
+            _registry.Add(e.ID, entry);
+        }
+        AddPathIndex(entry);
     }
 
     // Mark registry as draft
@@ -439,114 +444,96 @@ void AssetsCache::RegisterAssets(const FlaxStorageReference& storage)
 void AssetsCache::RegisterAsset(const Guid& id, const String& typeName, const StringView& path)
 {
     PROFILE_CPU();
-    ScopeLock lock(_locker);
+    ScopeWriteLock lock(_locker);
 
     // Check if asset has been already added to the registry
-    bool isMissing = true;
-    for (auto i = _registry.Begin(); i.IsNotEnd(); ++i)
+    Entry* e = _registry.TryGet(id);
+    Guid pathId;
+    if (e == nullptr && FindPathIndex(path, pathId))
     {
-        auto& e = i->Value;
-
-        if (e.Info.ID == id)
+        // Other asset is registered at that location
+        e = _registry.TryGet(pathId);
+        if (e)
+            _isDirty = true;
+    }
+    if (e)
+    {
+        if (e->Info.Path != path)
         {
-            if (e.Info.Path != path)
-            {
-                e.Info.Path = path;
-                _isDirty = true;
-            }
-            if (e.Info.TypeName != typeName)
-            {
-                e.Info.TypeName = typeName;
-                _isDirty = true;
-            }
-            isMissing = false;
-            break;
+            RemovePathIndex(*e);
+            e->Info.Path = path;
+            AddPathIndex(*e);
+            _isDirty = true;
         }
-
-        if (e.Info.Path == path)
+        if (e->Info.TypeName != typeName)
         {
-            if (e.Info.ID != id)
-            {
-                e.Info.Path = path;
-                _isDirty = true;
-            }
-            if (e.Info.TypeName != typeName)
-            {
-                e.Info.TypeName = typeName;
-                _isDirty = true;
-            }
-            isMissing = false;
-            break;
+            e->Info.TypeName = typeName;
+            _isDirty = true;
         }
     }
-
-    if (isMissing)
+    else
     {
         LOG(Info, "Register asset {0}:{1} \'{2}\'", id, typeName, path);
-        _registry.Add(id, Entry(id, typeName, path));
+        const Entry entry(id, typeName, path);
+        _registry.Add(id, entry);
+        AddPathIndex(entry);
         _isDirty = true;
     }
 }
 
 bool AssetsCache::DeleteAsset(const StringView& path, AssetInfo* info)
 {
-    bool result = false;
-    _locker.Lock();
-
-    for (auto i = _registry.Begin(); i.IsNotEnd(); ++i)
+    ScopeWriteLock lock(_locker);
+    Guid id;
+    if (FindPathIndex(path, id))
     {
-        if (i->Value.Info.Path == path)
+        const auto e = _registry.TryGet(id);
+        if (e != nullptr)
         {
             if (info)
-                *info = i->Value.Info;
-            _registry.Remove(i);
+                *info = e->Info;
+            RemovePathIndex(*e);
+            _registry.Remove(id);
             _isDirty = true;
-            result = true;
-            break;
+            return true;
         }
     }
-
-    _locker.Unlock();
-    return result;
+    return false;
 }
 
 bool AssetsCache::DeleteAsset(const Guid& id, AssetInfo* info)
 {
-    bool result = false;
-    _locker.Lock();
-
+    ScopeWriteLock lock(_locker);
     const auto e = _registry.TryGet(id);
     if (e != nullptr)
     {
         if (info)
             *info = e->Info;
+        RemovePathIndex(*e);
         _registry.Remove(id);
         _isDirty = true;
-        result = true;
+        return true;
     }
-
-    _locker.Unlock();
-    return result;
+    return false;
 }
 
 bool AssetsCache::RenameAsset(const StringView& oldPath, const StringView& newPath)
 {
-    bool result = false;
-    _locker.Lock();
-
-    for (auto i = _registry.Begin(); i.IsNotEnd(); ++i)
+    ScopeWriteLock lock(_locker);
+    Guid id;
+    if (FindPathIndex(oldPath, id))
     {
-        if (i->Value.Info.Path == oldPath)
+        const auto e = _registry.TryGet(id);
+        if (e != nullptr)
         {
-            i->Value.Info.Path = newPath;
+            RemovePathIndex(*e);
+            e->Info.Path = newPath;
+            AddPathIndex(*e);
             _isDirty = true;
-            result = true;
-            break;
+            return true;
         }
     }
-
-    _locker.Unlock();
-    return result;
+    return false;
 }
 
 bool AssetsCache::IsEntryValid(Entry& e)
@@ -606,3 +593,89 @@ bool AssetsCache::IsEntryValid(Entry& e)
     return e.Info.Path.HasChars();
 #endif
 }
+
+String AssetsCache::GetPathKey(const StringView& path)
+{
+#if PLATFORM_WINDOWS
+    // Paths are case-insensitive
+    return String(path).ToLower();
+#else
+    return String(path);
+#endif
+}
+
+bool AssetsCache::ValidateEntry(Entry& e, AssetInfo& info)
+{
+    // Entry is a copy so file checks are done outside the lock and the registry is modified only if needed
+#if ENABLE_ASSETS_DISCOVERY
+    const DateTime fileModified = e.FileModified;
+#endif
+    if (!IsEntryValid(e))
+    {
+        LOG(Warning, "Missing file from registry: \'{0}\':{1}:{2}", e.Info.Path, e.Info.ID, e.Info.TypeName);
+        ScopeWriteLock lock(_locker);
+        const auto entry = _registry.TryGet(e.Info.ID);
+        if (entry && entry->Info.Path == e.Info.Path)
+        {
+            RemovePathIndex(*entry);
+            _registry.Remove(e.Info.ID);
+        }
+        return false;
+    }
+#if ENABLE_ASSETS_DISCOVERY
+    if (e.FileModified != fileModified)
+    {
+        ScopeWriteLock lock(_locker);
+        const auto entry = _registry.TryGet(e.Info.ID);
+        if (entry && entry->Info.Path == e.Info.Path)
+            entry->FileModified = e.FileModified;
+    }
+#endif
+    info = e.Info;
+    return true;
+}
+
+bool AssetsCache::FindPathIndex(const StringView& path, Guid& id) const
+{
+    const auto ids = _pathsIndex.TryGet(GetPathKey(path));
+    if (ids == nullptr)
+        return false;
+    id = ids->First();
+    return true;
+}
+
+void AssetsCache::AddPathIndex(const Entry& e)
+{
+    if (e.Info.Path.IsEmpty())
+        return;
+    auto& ids = _pathsIndex[GetPathKey(e.Info.Path)];
+    if (!ids.Contains(e.Info.ID))
+        ids.Add(e.Info.ID);
+}
+
+void AssetsCache::RemovePathIndex(const Entry& e)
+{
+    // Other assets from the same file (eg. package with many assets) stay indexed
+    const String key = GetPathKey(e.Info.Path);
+    const auto ids = _pathsIndex.TryGet(key);
+    if (ids == nullptr)
+        return;
+    ids->RemoveKeepOrder(e.Info.ID);
+    if (ids->IsEmpty())
+        _pathsIndex.Remove(key);
+}
+
+void AssetsCache::RebuildIndex()
+{
+    _pathsIndex.Clear();
+    _pathsIndex.EnsureCapacity(_registry.Count());
+    for (auto i = _registry.Begin(); i.IsNotEnd(); ++i)
+        AddPathIndex(i->Value);
+    _idsMapping.Clear();
+    _idsMapping.EnsureCapacity(_pathsMapping.Count());
+    for (auto i = _pathsMapping.Begin(); i.IsNotEnd(); ++i)
+    {
+        if (!_idsMapping.ContainsKey(i->Value))
+            _idsMapping.Add(i->Value, i->Key);
+    }
+}
@@ -9,8 +9,9 @@
 #include "Engine/Core/Types/DateTime.h"
 #endif
 #include "Engine/Core/Types/String.h"
+#include "Engine/Core/Collections/Array.h"
 #include "Engine/Core/Collections/Dictionary.h"
-#include "Engine/Platform/CriticalSection.h"
+#include "Engine/Threading/ReadWriteLock.h"
 
 struct AssetHeader;
 struct FlaxStorageReference;
@@ -75,9 +76,11 @@ class FLAXENGINE_API AssetsCache
 
 private:
     bool _isDirty = false;
-    CriticalSection _locker;
+    ReadWriteLock _locker;
     Registry _registry;
     PathsMapping _pathsMapping;
+    Dictionary<String, Array<Guid, InlinedAllocation<1>>> _pathsIndex; // Normalized asset path -> ids of the registry entries in that file (first one is used for lookups)
+    Dictionary<Guid, String> _idsMapping; // Asset id -> mapped path (reverse of the paths mapping)
     String _path;
 
 public:
@@ -86,9 +89,9 @@ class FLAXENGINE_API AssetsCache
     /// </summary>
     int32 Size() const
     {
-        _locker.Lock();
+        _locker.LockRead();
         const int32 result = _registry.Count();
-        _locker.Unlock();
+        _locker.UnlockRead();
         return result;
     }
 
@@ -230,4 +233,12 @@ class FLAXENGINE_API AssetsCache
     /// <param name="e">The asset entry.</param>
     /// <returns>True if is valid, otherwise false.</returns>
     bool IsEntryValid(Entry& e);
+
+private:
+    static String GetPathKey(const StringView& path);
+    bool ValidateEntry(Entry& e, AssetInfo& info);
+    bool FindPathIndex(const StringView& path, Guid& id) const;
+    void AddPathIndex(const Entry& e);
+    void RemovePathIndex(const Entry& e);
+    void RebuildIndex();
 };
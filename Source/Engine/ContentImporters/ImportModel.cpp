@@ -70,16 +70,20 @@ void RepackMeshLightmapUVs(ModelData& data)
     auto& lod = data.LODs[lodIndex];
 
     // Build list of meshes with their area
-    struct LightmapUVsPack : RectPack<LightmapUVsPack, float>
+    struct LightmapUVsPack : RectPackNode<float>
     {
         LightmapUVsPack(float x, float y, float width, float height)
-            : RectPack<LightmapUVsPack, float>(x, y, width, height)
+            : RectPackNode<float>(x, y, width, height)
         {
         }
 
         void OnInsert()
         {
         }
+
+        void OnFree()
+        {
+        }
     };
     struct MeshEntry
     {
@@ -109,10 +113,10 @@ void RepackMeshLightmapUVs(ModelData& data)
         {
             bool failed = false;
             const float chartsPadding = (4.0f / 256.0f) * atlasSize;
-            LightmapUVsPack root(chartsPadding, chartsPadding, atlasSize - chartsPadding, atlasSize - chartsPadding);
+            RectPackAtlas<LightmapUVsPack> atlas(chartsPadding, chartsPadding, atlasSize - chartsPadding, atlasSize - chartsPadding);
             for (auto& entry : entries)
             {
-                entry.Slot = root.Insert(entry.Size, entry.Size, chartsPadding);
+                entry.Slot = atlas.Insert(entry.Size, entry.Size, chartsPadding);
                 if (entry.Slot == nullptr)
                 {
                     // Failed to insert surface, increase atlas size and try again
@@ -2,7 +2,9 @@
 
 #include "Sorting.h"
 #include "Engine/Core/Memory/Memory.h"
+#include "Engine/Threading/JobSystem.h"
 #include "Engine/Threading/ThreadLocal.h"
+#include "Engine/Threading/Threading.h"
 
 // Use a cached storage for the sorting (one per thread to reduce locking)
 ThreadLocal<Sorting::SortingStack*> SortingStacks;
@@ -53,3 +55,17 @@ void Sorting::SortingStack::EnsureCapacity(int32 minCapacity)
         num = minCapacity;
     SetCapacity(num);
 }
+
+int32 Sorting::GetParallelJobsCount(int32 count)
+{
+    // Jobs waiting on other jobs could stall the job system so run parallel sorting only from the main thread
+    if (count < ParallelSortThreshold || !IsInMainThread())
+        return 1;
+    const int32 maxJobs = Math::Min(JobSystem::GetThreadsCount(), count / (ParallelSortThreshold / 2));
+    return Math::Clamp(maxJobs, 1, 64);
+}
+
+void Sorting::ExecuteParallel(const Function<void(int32)>& job, int32 jobCount)
+{
+    JobSystem::Execute(job, jobCount);
+}
@@ -3,6 +3,8 @@
 #pragma once
 
 #include "Engine/Core/Types/BaseTypes.h"
+#include "Engine/Core/Delegate.h"
+#include "Engine/Core/Math/Math.h"
 #include "Engine/Platform/Platform.h"
 
 /// <summary>
@@ -11,6 +13,11 @@
 class FLAXENGINE_API Sorting
 {
 public:
+    /// <summary>
+    /// The minimum amount of elements to use parallel sorting (smaller collections are sorted on a calling thread).
+    /// </summary>
+    static const int32 ParallelSortThreshold = 16 * 1024;
+
     /// <summary>
     /// Helper collection used by the sorting algorithms. Implements stack using single linear allocation with variable capacity.
     /// </summary>
@@ -54,7 +61,8 @@ class FLAXENGINE_API Sorting
 
         while (h <= mid && j <= end)
         {
-            if (data[h] < data[j])
+            // Take from the left side on equal items to keep sorting stable
+            if (!(data[j] < data[h]))
                 tmp[i] = data[h++];
             else
                 tmp[i] = data[j++];
@@ -87,6 +95,12 @@ class FLAXENGINE_API Sorting
         Merge(data, tmp, start, mid, end);
     }
 
+    // Gets the amount of jobs to use for parallel sorting of the given amount of elements. Returns 1 if sorting should be done on a calling thread.
+    static int32 GetParallelJobsCount(int32 count);
+
+    // Executes the sorting jobs via job system and waits for them to end.
+    static void ExecuteParallel(const Function<void(int32)>& job, int32 jobCount);
+
 public:
     /// <summary>
     /// Sorts the linear data array using Quick Sort algorithm (non recursive version, uses temporary stack collection).
@@ -307,7 +321,7 @@ class FLAXENGINE_API Sorting
     }
 
     /// <summary>
-    /// Sorts the linear data array using Merge Sort algorithm (recursive version, uses temporary memory).
+    /// Sorts the linear data array using Merge Sort algorithm (recursive version, uses temporary memory). Sorting is stable (equal elements keep their order).
     /// </summary>
     /// <param name="data">The data pointer.</param>
     /// <param name="count">The elements count.</param>
@@ -334,7 +348,62 @@ class FLAXENGINE_API Sorting
     }
 
     /// <summary>
-    /// Sorts the linear data array using Radix Sort algorithm (uses temporary keys collection).
+    /// Sorts the linear data array using Merge Sort algorithm executed in parallel via job system (uses temporary memory). Sorting is stable and gives the same results as MergeSort. Small collections are sorted on a calling thread.
+    /// </summary>
+    /// <param name="data">The data pointer.</param>
+    /// <param name="count">The elements count.</param>
+    /// <param name="tmp">The additional temporary memory buffer for sorting data. If null then will be automatically allocated within this function call.</param>
+    template<typename T>
+    static void ParallelMergeSort(T* data, int32 count, T* tmp = nullptr)
+    {
+        const int32 jobsCount = GetParallelJobsCount(count);
+        if (jobsCount <= 1)
+        {
+            MergeSort(data, count, tmp);
+            return;
+        }
+        const bool alloc = tmp == nullptr;
+        if (alloc)
+            tmp = (T*)Platform::Allocate(sizeof(T) * count, 16);
+
+        // Sort chunks of data in separate jobs
+        const int32 chunkSize = (count + jobsCount - 1) / jobsCount;
+        ExecuteParallel([&](int32 jobIndex)
+        {
+            const int32 start = jobIndex * chunkSize;
+            const int32 end = Math::Min(start + chunkSize, count) - 1;
+            if (start < end)
+                MergeSort(data, tmp, start, end);
+        }, jobsCount);
+
+        // Merge sorted chunks in pairs until whole data is sorted (each pair merge in a separate job)
+        for (int32 width = chunkSize; width < count; width *= 2)
+        {
+            const int32 mergesCount = (count + width * 2 - 1) / (width * 2);
+            ExecuteParallel([&](int32 jobIndex)
+            {
+                const int32 start = jobIndex * width * 2;
+                const int32 mid = Math::Min(start + width, count) - 1;
+                const int32 end = Math::Min(start + width * 2, count) - 1;
+                if (mid < end)
+                    Merge(data, tmp, start, mid, end);
+            }, mergesCount);
+        }
+
+        if (alloc)
+            Platform::Free(tmp);
+    }
+
+    template<typename T, typename AllocationType = HeapAllocation>
+    FORCE_INLINE static void ParallelMergeSort(Array<T, AllocationType>& data, Array<T, AllocationType>* tmp = nullptr)
+    {
+        if (tmp)
+            tmp->Resize(data.Count());
+        ParallelMergeSort(data.Get(), data.Count(), tmp ? tmp->Get() : nullptr);
+    }
+
+    /// <summary>
+    /// Sorts the linear data array using Radix Sort algorithm (uses temporary keys collection). Supports unsigned integer keys up to 64-bits. Sorting is stable.
     /// </summary>
     /// <param name="inputKeys">The data pointer to the input sorting keys array. When this method completes it contains a pointer to the original data or the temporary depending on the algorithm passes count. Use it as a results container.</param>
     /// <param name="inputValues">The data pointer to the input values array. When this method completes it contains a pointer to the original data or the temporary depending on the algorithm passes count. Use it as a results container.</param>
@@ -362,7 +431,8 @@ class FLAXENGINE_API Sorting
         uint32 histogram[RADIXSORT_HISTOGRAM_SIZE];
         uint16 shift = 0;
         int32 pass = 0;
-        for (; pass < 6; pass++)
+        const int32 passesCount = (sizeof(T) * 8 + RADIXSORT_BITS - 1) / RADIXSORT_BITS;
+        for (; pass < passesCount; pass++)
         {
             Platform::MemoryClear(histogram, sizeof(uint32) * RADIXSORT_HISTOGRAM_SIZE);
 
@@ -419,4 +489,118 @@ class FLAXENGINE_API Sorting
             inputValues = tmpValues;
         }
     }
+
+    /// <summary>
+    /// Sorts the linear data array using Radix Sort algorithm executed in parallel via job system (uses temporary keys collection). Gives the same results as RadixSort. Small collections are sorted on a calling thread.
+    /// </summary>
+    /// <param name="inputKeys">The data pointer to the input sorting keys array. When this method completes it contains a pointer to the original data or the temporary depending on the algorithm passes count. Use it as a results container.</param>
+    /// <param name="inputValues">The data pointer to the input values array. When this method completes it contains a pointer to the original data or the temporary depending on the algorithm passes count. Use it as a results container.</param>
+    /// <param name="tmpKeys">The data pointer to the temporary sorting keys array.</param>
+    /// <param name="tmpValues">The data pointer to the temporary values array.</param>
+    /// <param name="count">The elements count.</param>
+    template<typename T, typename U>
+    static void ParallelRadixSort(T*& inputKeys, U*& inputValues, T* tmpKeys, U* tmpValues, int32 count)
+    {
+        enum
+        {
+            RADIXSORT_BITS = 11,
+            RADIXSORT_HISTOGRAM_SIZE = 1 << RADIXSORT_BITS,
+            RADIXSORT_BIT_MASK = RADIXSORT_HISTOGRAM_SIZE - 1
+        };
+        const int32 jobsCount = GetParallelJobsCount(count);
+        if (jobsCount <= 1)
+        {
+            RadixSort(inputKeys, inputValues, tmpKeys, tmpValues, count);
+            return;
+        }
+
+        T* keys = inputKeys;
+        T* tempKeys = tmpKeys;
+        U* values = inputValues;
+        U* tempValues = tmpValues;
+
+        // Each job processes a continuous chunk of data using own histogram so scattering is stable and deterministic
+        const int32 chunkSize = (count + jobsCount - 1) / jobsCount;
+        uint32* histograms = (uint32*)Platform::Allocate(sizeof(uint32) * RADIXSORT_HISTOGRAM_SIZE * jobsCount, 16);
+        bool* sorted = (bool*)Platform::Allocate(sizeof(bool) * jobsCount, 16);
+        uint16 shift = 0;
+        int32 pass = 0;
+        const int32 passesCount = (sizeof(T) * 8 + RADIXSORT_BITS - 1) / RADIXSORT_BITS;
+        for (; pass < passesCount; pass++)
+        {
+            // Build per-job histograms
+            ExecuteParallel([&](int32 jobIndex)
+            {
+                uint32* histogram = histograms + jobIndex * RADIXSORT_HISTOGRAM_SIZE;
+                Platform::MemoryClear(histogram, sizeof(uint32) * RADIXSORT_HISTOGRAM_SIZE);
+                const int32 start = jobIndex * chunkSize;
+                const int32 end = Math::Min(start + chunkSize, count);
+                bool isSorted = true;
+                T prevKey = keys[start > 0 ? start - 1 : 0];
+                for (int32 i = start; i < end; i++)
+                {
+                    const T key = keys[i];
+                    const uint16 index = (key >> shift) & RADIXSORT_BIT_MASK;
+                    ++histogram[index];
+                    isSorted &= prevKey <= key;
+                    prevKey = key;
+                }
+                sorted[jobIndex] = isSorted;
+            }, jobsCount);
+
+            bool isSorted = true;
+            for (int32 jobIndex = 0; jobIndex < jobsCount; jobIndex++)
+                isSorted &= sorted[jobIndex];
+            if (isSorted)
+                break;
+
+            // Convert histograms into the output offsets (ordered by bucket and then by job)
+            uint32 offset = 0;
+            for (int32 i = 0; i < RADIXSORT_HISTOGRAM_SIZE; i++)
+            {
+                for (int32 jobIndex = 0; jobIndex < jobsCount; jobIndex++)
+                {
+                    uint32& histogram = histograms[jobIndex * RADIXSORT_HISTOGRAM_SIZE + i];
+                    const uint32 cnt = histogram;
+                    histogram = offset;
+                    offset += cnt;
+                }
+            }
+
+            // Scatter keys and values
+            ExecuteParallel([&](int32 jobIndex)
+            {
+                uint32* histogram = histograms + jobIndex * RADIXSORT_HISTOGRAM_SIZE;
+                const int32 start = jobIndex * chunkSize;
+                const int32 end = Math::Min(start + chunkSize, count);
+                for (int32 i = start; i < end; i++)
+                {
+                    const T k = keys[i];
+                    const uint16 index = (k >> shift) & RADIXSORT_BIT_MASK;
+                    const uint32 dest = histogram[index]++;
+                    tempKeys[dest] = k;
+                    tempValues[dest] = values[i];
+                }
+            }, jobsCount);
+
+            T* const swapKeys = tempKeys;
+            tempKeys = keys;
+            keys = swapKeys;
+
+            U* const swapValues = tempValues;
+            tempValues = values;
+            values = swapValues;
+
+            shift += RADIXSORT_BITS;
+        }
+        Platform::Free(histograms);
+        Platform::Free(sorted);
+
+        if (pass & 1)
+        {
+            // Use temporary keys and values as a result
+            inputKeys = tmpKeys;
+            inputValues = tmpValues;
+        }
+    }
 };
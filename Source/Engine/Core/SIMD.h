@@ -4,9 +4,7 @@
 
 #include "Engine/Platform/Platform.h"
 #if PLATFORM_SIMD_SSE2
-#ifdef _WIN32
 #include <xmmintrin.h>
-#endif
 #else
 #include <math.h>
 #endif
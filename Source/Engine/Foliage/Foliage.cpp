@@ -416,6 +416,8 @@ void Foliage::DrawType(RenderContext& renderContext, const FoliageType& type, Dr
 {
     if (!type.Root || !FOLIAGE_CAN_DRAW(renderContext, type))
         return;
+    if (!renderContext.View.CanDrawStaticFlags(GetStaticFlags()))
+        return;
     const DrawPass typeDrawModes = FOLIAGE_GET_DRAW_MODES(renderContext, type);
     PROFILE_CPU_ASSET(type.Model);
 #if FOLIAGE_USE_DRAW_CALLS_BATCHING
@@ -30,11 +30,19 @@ void DefaultGPUTasksExecutor::FrameEnd()
     ASSERT(_context != nullptr);
 
     // Default implementation performs async operations on end of the frame which is synchronized with a rendering thread
-    GPUTask* buffer[32];
-    const int32 count = GPUDevice::Instance->GetTasksManager()->RequestWork(buffer, 32);
-    for (int32 i = 0; i < count; i++)
+    // Tasks are requested in small batches to stay within the frame time budget (manager limits the tasks count and data size)
+    auto manager = GPUDevice::Instance->GetTasksManager();
+    const double timeEnd = Platform::GetTimeSeconds() + manager->FrameTimeBudget * 0.001;
+    GPUTask* buffer[4];
+    int32 count;
+    while ((count = manager->RequestWork(buffer, ARRAY_COUNT(buffer))) != 0)
     {
-        _context->Run(buffer[i]);
+        for (int32 i = 0; i < count; i++)
+        {
+            _context->Run(buffer[i]);
+        }
+        if (Platform::GetTimeSeconds() >= timeEnd)
+            break;
     }
 
     _context->OnFrameEnd();
@@ -26,12 +26,27 @@ class GPUTask : public Task
     /// </summary>
     DECLARE_ENUM_4(Result, Ok, Failed, MissingResources, MissingData);
 
+    /// <summary>
+    /// Describes GPU work priority. Tasks with higher priority are executed before the others.
+    /// </summary>
+    DECLARE_ENUM_3(Priority, Low, Normal, High);
+
 private:
     /// <summary>
     /// Task type
     /// </summary>
     Type _type;
 
+    /// <summary>
+    /// Task priority
+    /// </summary>
+    Priority _priority;
+
+    /// <summary>
+    /// Estimated amount of data (in bytes) to upload or copy by this task
+    /// </summary>
+    uint64 _cost;
+
     /// <summary>
     /// Synchronization point when async task has been done
     /// </summary>
@@ -49,6 +64,8 @@ class GPUTask : public Task
     /// <param name="type">The type.</param>
     GPUTask(const Type type)
         : _type(type)
+        , _priority(Priority::Normal)
+        , _cost(0)
         , _syncPoint(0)
         , _context(nullptr)
     {
@@ -64,6 +81,33 @@ class GPUTask : public Task
         return _type;
     }
 
+    /// <summary>
+    /// Gets a task priority.
+    /// </summary>
+    /// <returns>The priority.</returns>
+    FORCE_INLINE Priority GetPriority() const
+    {
+        return _priority;
+    }
+
+    /// <summary>
+    /// Sets a task priority. Should be called before starting the task.
+    /// </summary>
+    /// <param name="value">The priority.</param>
+    FORCE_INLINE void SetPriority(const Priority value)
+    {
+        _priority = value;
+    }
+
+    /// <summary>
+    /// Gets the estimated task cost (amount of data in bytes to upload or copy). Used by the GPU tasks manager to limit work done within a single frame.
+    /// </summary>
+    /// <returns>The cost (in bytes).</returns>
+    FORCE_INLINE uint64 GetCost() const
+    {
+        return _cost;
+    }
+
     /// <summary>
     /// Gets work finish synchronization point
     /// </summary>
@@ -120,6 +164,15 @@ class GPUTask : public Task
     }
 
 protected:
+    /// <summary>
+    /// Sets the estimated task cost (amount of data in bytes to upload or copy).
+    /// </summary>
+    /// <param name="value">The cost (in bytes).</param>
+    FORCE_INLINE void SetCost(const uint64 value)
+    {
+        _cost = value;
+    }
+
     virtual Result run(GPUTasksContext* context) = 0;
 
     virtual void OnSync()
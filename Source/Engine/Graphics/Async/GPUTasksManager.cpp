@@ -40,13 +40,15 @@ String GPUTask::ToString() const
 
 void GPUTask::Enqueue()
 {
-    GPUDevice::Instance->GetTasksManager()->_tasks.Add(this);
+    GPUDevice::Instance->GetTasksManager()->Enqueue(this);
 }
 
 GPUTasksManager::GPUTasksManager()
 {
-    _buffers[0].EnsureCapacity(64);
-    _buffers[1].EnsureCapacity(64);
+    for (auto& lane : _lanes)
+        lane.EnsureCapacity(64);
+    Platform::MemoryClear(&_frameStats, sizeof(_frameStats));
+    Platform::MemoryClear(&_lastFrameStats, sizeof(_lastFrameStats));
 }
 
 void GPUTasksManager::SetExecutor(GPUTasksExecutor* value)
@@ -68,73 +70,154 @@ void GPUTasksManager::Dispose()
     SAFE_DELETE(_executor);
 
     // Cleanup
-    Task::CancelAll(_buffers[0]);
-    Task::CancelAll(_buffers[1]);
-    _bufferIndex = 0;
+    for (int32 i = 0; i < GPUTask::Priority_Count; i++)
+    {
+        auto& lane = _lanes[i];
+        for (int32 j = _lanesStart[i]; j < lane.Count(); j++)
+            lane[j]->Cancel();
+        lane.Clear();
+        _lanesStart[i] = 0;
+    }
+    Task::CancelAll(_waiting);
     _tasks.CancelAll();
 }
 
+int32 GPUTasksManager::GetTaskCount() const
+{
+    int32 result = _tasks.Count() + _waiting.Count();
+    for (int32 i = 0; i < GPUTask::Priority_Count; i++)
+        result += _lanes[i].Count() - _lanesStart[i];
+    return result;
+}
+
 void GPUTasksManager::FrameBegin()
 {
-    _executor->FrameBegin();
+    if (_executor)
+        _executor->FrameBegin();
 }
 
 void GPUTasksManager::FrameEnd()
 {
-    _executor->FrameEnd();
+    // Retry tasks that were not ready during the previous frame
+    for (GPUTask* task : _waiting)
+        _lanes[(int32)task->GetPriority()].Add(task);
+    _waiting.Clear();
+
+    if (_executor)
+        _executor->FrameEnd();
+
+    // Remove finished or canceled tasks that were left in the lanes (eg. due to budget limits) before they get deleted and update lanes starvation
+    for (int32 laneIndex = 0; laneIndex < GPUTask::Priority_Count; laneIndex++)
+    {
+        auto& lane = _lanes[laneIndex];
+        int32& start = _lanesStart[laneIndex];
+        int32 count = 0, queuedCount = 0;
+        for (int32 i = start; i < lane.Count(); i++)
+        {
+            GPUTask* task = lane[i];
+            const auto state = task->GetState();
+            if (state == TaskState::Queued)
+                queuedCount++;
+            else if (state != TaskState::Created && state != TaskState::Running)
+                continue;
+            lane[count++] = task;
+        }
+        lane.Resize(count);
+        start = 0;
+        if (queuedCount != 0 && _frameStats.TasksCount[laneIndex] == 0)
+            _lanesStarvedFrames[laneIndex]++;
+        else
+            _lanesStarvedFrames[laneIndex] = 0;
+    }
+
+    // Update stats and start a new frame budget
+    _frameStats.DeferredCount = GetTaskCount();
+    _lastFrameStats = _frameStats;
+    Platform::MemoryClear(&_frameStats, sizeof(_frameStats));
 }
 
 int32 GPUTasksManager::RequestWork(GPUTask** buffer, int32 maxCount)
 {
-    const auto b1Index = _bufferIndex;
-    const auto b2Index = (_bufferIndex + 1) % 2;
-    auto& b1 = _buffers[b1Index];
-    auto& b2 = _buffers[b2Index];
-
-    // Take maximum amount of tasks to the buffer at once
-    ASSERT(b1.IsEmpty());
-    const int32 takenTasksCount = (int32)_tasks.try_dequeue_bulk(b1.Get(), maxCount);
-    b2.Add(b1.Get(), takenTasksCount);
+    // Move new tasks into the priority lanes
+    GPUTask* tasks[64];
+    std::size_t tasksCount;
+    while ((tasksCount = _tasks.try_dequeue_bulk(tasks, ARRAY_COUNT(tasks))) != 0)
+    {
+        for (std::size_t i = 0; i < tasksCount; i++)
+            _lanes[(int32)tasks[i]->GetPriority()].Add(tasks[i]);
+    }
 
+    // Take tasks from the highest priority lanes first until the frame budget is reached (lanes starved for too long go first)
+    int32 lanesOrder[GPUTask::Priority_Count];
+    int32 lanesOrderCount = 0;
+    for (int32 laneIndex = GPUTask::Priority_Count - 1; laneIndex >= 0; laneIndex--)
+    {
+        if (MaxStarvedFrames > 0 && _lanesStarvedFrames[laneIndex] >= MaxStarvedFrames)
+            lanesOrder[lanesOrderCount++] = laneIndex;
+    }
+    for (int32 laneIndex = GPUTask::Priority_Count - 1; laneIndex >= 0; laneIndex--)
+    {
+        if (MaxStarvedFrames <= 0 || _lanesStarvedFrames[laneIndex] < MaxStarvedFrames)
+            lanesOrder[lanesOrderCount++] = laneIndex;
+    }
     int32 count = 0;
-
-    // Filter taken tasks to keep maxTotalComplexity limit
-    b1.Clear();
-    int32 i = 0;
-    for (; i < b2.Count() && count < maxCount; i++)
+    bool budgetReached = false;
+    for (int32 orderIndex = 0; orderIndex < lanesOrderCount && !budgetReached; orderIndex++)
     {
-        auto task = b2[i];
-        const auto state = task->GetState();
-        switch (state)
+        const int32 laneIndex = lanesOrder[orderIndex];
+        auto& lane = _lanes[laneIndex];
+        int32& start = _lanesStart[laneIndex];
+        while (start < lane.Count() && count < maxCount)
         {
-        case TaskState::Failed:
-        case TaskState::Canceled:
-        case TaskState::Finished:
-            // Skip task
-            break;
-        case TaskState::Queued:
-            // Run queued task
-            buffer[count++] = task;
-            break;
-        case TaskState::Created:
-        case TaskState::Running:
-        default:
-            // Keep task for the next RequestWork
-            b1.Add(task);
-            break;
+            auto task = lane[start];
+            const auto state = task->GetState();
+            if (state == TaskState::Queued)
+            {
+                // Check the budget (the first task in a frame is always executed to ensure progress)
+                const int32 frameTasksCount = _frameStats.GetTasksCount();
+                if (frameTasksCount != 0 && (frameTasksCount >= FrameTasksLimit || _frameStats.Bytes + task->GetCost() > FrameBytesBudget))
+                {
+                    budgetReached = true;
+                    break;
+                }
+
+                // Run queued task
+                _frameStats.TasksCount[laneIndex]++;
+                _frameStats.Bytes += task->GetCost();
+                buffer[count++] = task;
+            }
+            else if (state == TaskState::Created || state == TaskState::Running)
+            {
+                // Keep task for the next frame
+                _waiting.Add(task);
+            }
+            start++;
         }
-    }
-    const int32 itemsLeft = b2.Count() - i;
-    if (itemsLeft > 0)
-        b1.Add(&b2[i], itemsLeft);
-    b2.Clear();
 
-    // Swap buffers
-    _bufferIndex = b2Index;
+        // Release the processed part of the lane
+        if (start == lane.Count())
+        {
+            lane.Clear();
+            start = 0;
+        }
+        else if (start >= 64 && start * 2 >= lane.Count())
+        {
+            const int32 itemsLeft = lane.Count() - start;
+            for (int32 i = 0; i < itemsLeft; i++)
+                lane[i] = lane[start + i];
+            lane.Resize(itemsLeft);
+            start = 0;
+        }
+    }
 
     return count;
 }
 
+void GPUTasksManager::Enqueue(GPUTask* task)
+{
+    _tasks.Add(task);
+}
+
 String GPUTasksManager::ToString() const
 {
     return TEXT("GPU Tasks Manager");
@@ -21,15 +21,72 @@ class GPUTasksManager : public Object, public NonCopyable
     friend GPUDevice;
     friend GPUTask;
 
+public:
+    /// <summary>
+    /// The GPU tasks execution statistics for a single frame.
+    /// </summary>
+    struct FrameStats
+    {
+        /// <summary>
+        /// The amount of executed tasks (per priority).
+        /// </summary>
+        int32 TasksCount[GPUTask::Priority_Count];
+
+        /// <summary>
+        /// The estimated amount of data (in bytes) processed by the executed tasks.
+        /// </summary>
+        uint64 Bytes;
+
+        /// <summary>
+        /// The amount of tasks left in a queue for the next frames (eg. due to budget limits).
+        /// </summary>
+        int32 DeferredCount;
+
+        /// <summary>
+        /// Gets the total amount of executed tasks.
+        /// </summary>
+        int32 GetTasksCount() const
+        {
+            int32 result = 0;
+            for (int32 i = 0; i < GPUTask::Priority_Count; i++)
+                result += TasksCount[i];
+            return result;
+        }
+    };
+
 private:
     GPUTasksExecutor* _executor = nullptr;
     ConcurrentTaskQueue<GPUTask> _tasks;
-    Array<GPUTask*> _buffers[2];
-    int32 _bufferIndex = 0;
+    Array<GPUTask*> _lanes[GPUTask::Priority_Count];
+    int32 _lanesStart[GPUTask::Priority_Count] = {};
+    int32 _lanesStarvedFrames[GPUTask::Priority_Count] = {};
+    Array<GPUTask*> _waiting;
+    FrameStats _frameStats;
+    FrameStats _lastFrameStats;
 
 public:
     GPUTasksManager();
 
+    /// <summary>
+    /// The maximum amount of tasks to execute within a single frame.
+    /// </summary>
+    int32 FrameTasksLimit = 32;
+
+    /// <summary>
+    /// The maximum amount of data (in bytes) to upload or copy by the tasks within a single frame. The first task in a frame is always executed (even if its cost exceeds the budget) to ensure progress.
+    /// </summary>
+    uint64 FrameBytesBudget = 32 * 1024 * 1024;
+
+    /// <summary>
+    /// The maximum time (in milliseconds) to spend on executing tasks within a single frame. Used by the tasks executor.
+    /// </summary>
+    float FrameTimeBudget = 4.0f;
+
+    /// <summary>
+    /// The maximum amount of frames that queued tasks can wait without execution when the budget is used by the higher priority tasks. After that, their lane goes first within the frame budget (prevents starvation). Use 0 to disable it.
+    /// </summary>
+    int32 MaxStarvedFrames = 10;
+
     /// <summary>
     /// Gets the GPU tasks executor.
     /// </summary>
@@ -47,9 +104,22 @@ class GPUTasksManager : public Object, public NonCopyable
     /// <summary>
     /// Gets the amount of enqueued tasks to perform.
     /// </summary>
-    FORCE_INLINE int32 GetTaskCount() const
+    int32 GetTaskCount() const;
+
+    /// <summary>
+    /// Gets the tasks execution statistics of the current frame.
+    /// </summary>
+    FORCE_INLINE const FrameStats& GetFrameStats() const
     {
-        return _tasks.Count();
+        return _frameStats;
+    }
+
+    /// <summary>
+    /// Gets the tasks execution statistics of the last finished frame.
+    /// </summary>
+    FORCE_INLINE const FrameStats& GetLastFrameStats() const
+    {
+        return _lastFrameStats;
     }
 
 public:
@@ -71,13 +141,19 @@ class GPUTasksManager : public Object, public NonCopyable
 
 public:
     /// <summary>
-    /// Requests work to do. Should be used only by GPUTasksExecutor.
+    /// Requests work to do. Should be used only by GPUTasksExecutor. Tasks are returned in priority order and within the per-frame budget (can be called multiple times per frame until it returns no tasks).
     /// </summary>
     /// <param name="buffer">The output buffer.</param>
     /// <param name="maxCount">The maximum allowed amount of tasks to get.</param>
     /// <returns>The amount of tasks added to the buffer.</returns>
     int32 RequestWork(GPUTask** buffer, int32 maxCount);
 
+    /// <summary>
+    /// Adds the task to the execution queue. Called by the task when it gets started.
+    /// </summary>
+    /// <param name="task">The task.</param>
+    void Enqueue(GPUTask* task);
+
 public:
     // [Object]
     String ToString() const override;
@@ -28,6 +28,7 @@ class GPUCopyResourceTask : public GPUTask
     {
         _srcResource.Released.Bind<GPUCopyResourceTask, &GPUCopyResourceTask::OnResourceReleased>(this);
         _dstResource.Released.Bind<GPUCopyResourceTask, &GPUCopyResourceTask::OnResourceReleased>(this);
+        SetCost(src ? src->GetMemoryUsage() : 0);
     }
 
 private:
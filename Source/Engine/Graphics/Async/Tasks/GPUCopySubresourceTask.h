@@ -33,6 +33,7 @@ class GPUCopySubresourceTask : public GPUTask
     {
         _srcResource.Released.Bind<GPUCopySubresourceTask, &GPUCopySubresourceTask::OnResourceReleased>(this);
         _dstResource.Released.Bind<GPUCopySubresourceTask, &GPUCopySubresourceTask::OnResourceReleased>(this);
+        SetCost(src ? src->GetMemoryUsage() : 0); // Whole resource size is used as an upper bound
     }
 
 private:
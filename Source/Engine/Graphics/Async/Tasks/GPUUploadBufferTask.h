@@ -37,6 +37,7 @@ class GPUUploadBufferTask : public GPUTask
             _data.Copy(data);
         else
             _data.Link(data);
+        SetCost(_data.Length());
     }
 
 private:
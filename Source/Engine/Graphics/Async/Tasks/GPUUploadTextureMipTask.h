@@ -41,6 +41,7 @@ class GPUUploadTextureMipTask : public GPUTask
             _data.Copy(data);
         else
             _data.Link(data);
+        SetCost(_data.Length());
     }
 
 private:
@@ -19,7 +19,8 @@
 PACK_STRUCT(struct DeferredMaterialShaderData {
     Matrix WorldMatrix;
     Matrix PrevWorldMatrix;
-    Float2 Dummy0;
+    uint32 BoneMatricesOffset;
+    uint32 PrevBoneMatricesOffset;
     float LODDitherFactor;
     float PerInstanceRandom;
     Float3 GeometrySize;
@@ -53,7 +54,7 @@ void DeferredMaterialShader::Bind(BindParameters& params)
     ASSERT_LOW_LAYER(cb.Length() >= sizeof(DeferredMaterialShaderData));
     auto materialData = reinterpret_cast<DeferredMaterialShaderData*>(cb.Get());
     cb = Span<byte>(cb.Get() + sizeof(DeferredMaterialShaderData), cb.Length() - sizeof(DeferredMaterialShaderData));
-    int32 srv = 2;
+    int32 srv = 1;
 
     // Setup features
     const bool useLightmap = _info.BlendMode == MaterialBlendMode::Opaque && LightmapFeature::Bind(params, cb, srv);
@@ -83,12 +84,14 @@ void DeferredMaterialShader::Bind(BindParameters& params)
     bool perBoneMotionBlur = false;
     if (useSkinning)
     {
-        // Bind skinning buffer
-        ASSERT(drawCall.Surface.Skinning->IsReady());
-        context->BindSR(0, drawCall.Surface.Skinning->BoneMatrices->View());
-        if (drawCall.Surface.Skinning->PrevBoneMatrices && drawCall.Surface.Skinning->PrevBoneMatrices->IsAllocated())
+        // Bind skinning buffer (shared by all skinned meshes)
+        const SkinnedMeshDrawData* skinning = drawCall.Surface.Skinning;
+        ASSERT(skinning->IsReady());
+        context->BindSR(0, SkinnedMeshDrawData::GetBoneMatrices()->View());
+        materialData->BoneMatricesOffset = skinning->GetBoneMatricesOffset();
+        if (skinning->HasPrevBoneMatrices())
         {
-            context->BindSR(1, drawCall.Surface.Skinning->PrevBoneMatrices->View());
+            materialData->PrevBoneMatricesOffset = skinning->GetPrevBoneMatricesOffset();
             perBoneMotionBlur = true;
         }
     }
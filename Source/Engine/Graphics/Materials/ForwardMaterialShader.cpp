@@ -20,7 +20,8 @@
 PACK_STRUCT(struct ForwardMaterialShaderData {
     Matrix WorldMatrix;
     Matrix PrevWorldMatrix;
-    Float2 Dummy0;
+    uint32 BoneMatricesOffset;
+    uint32 PrevBoneMatricesOffset;
     float LODDitherFactor;
     float PerInstanceRandom;
     Float3 GeometrySize;
@@ -48,7 +49,7 @@ void ForwardMaterialShader::Bind(BindParameters& params)
     ASSERT_LOW_LAYER(cb.Length() >= sizeof(ForwardMaterialShaderData));
     auto materialData = reinterpret_cast<ForwardMaterialShaderData*>(cb.Get());
     cb = Span<byte>(cb.Get() + sizeof(ForwardMaterialShaderData), cb.Length() - sizeof(ForwardMaterialShaderData));
-    int32 srv = 2;
+    int32 srv = 1;
 
     // Setup features
     if ((_info.FeaturesFlags & MaterialFeaturesFlags::GlobalIllumination) != MaterialFeaturesFlags::None)
@@ -69,9 +70,10 @@ void ForwardMaterialShader::Bind(BindParameters& params)
     const bool useSkinning = drawCall.Surface.Skinning != nullptr;
     if (useSkinning)
     {
-        // Bind skinning buffer
+        // Bind skinning buffer (shared by all skinned meshes)
         ASSERT(drawCall.Surface.Skinning->IsReady());
-        context->BindSR(0, drawCall.Surface.Skinning->BoneMatrices->View());
+        context->BindSR(0, SkinnedMeshDrawData::GetBoneMatrices()->View());
+        materialData->BoneMatricesOffset = drawCall.Surface.Skinning->GetBoneMatricesOffset();
     }
 
     // Setup material constants
@@ -14,6 +14,36 @@
 #include "Engine/Renderer/GlobalSignDistanceFieldPass.h"
 #include "Engine/Scripting/Enums.h"
 #include "Engine/Streaming/Streaming.h"
+#include "Engine/Profiler/ProfilerCPU.h"
+
+namespace
+{
+    int64 ParamsDataVersion = 0;
+
+    // Gets the size of the constant buffer data written by the parameter that depends only on its value (0 if parameter binds resources or dynamic data)
+    int32 GetStaticConstantSize(MaterialParameterType type)
+    {
+        switch (type)
+        {
+        case MaterialParameterType::Bool:
+        case MaterialParameterType::Integer:
+        case MaterialParameterType::Float:
+            return sizeof(int32);
+        case MaterialParameterType::Vector2:
+            return sizeof(Float2);
+        case MaterialParameterType::Vector3:
+            return sizeof(Float3);
+        case MaterialParameterType::Vector4:
+        case MaterialParameterType::Color:
+        case MaterialParameterType::ChannelMask:
+            return sizeof(Float4);
+        case MaterialParameterType::Matrix:
+            return sizeof(Matrix);
+        default:
+            return 0;
+        }
+    }
+}
 
 bool MaterialInfo8::operator==(const MaterialInfo8& other) const
 {
@@ -168,6 +198,12 @@ Variant MaterialParameter::GetValue() const
 
 void MaterialParameter::SetValue(const Variant& value)
 {
+    // Resources are read from the parameter during binding so only the constants change needs to invalidate the cached binding
+    const bool isStatic = IsStaticConstant();
+    Matrix prevData;
+    if (isStatic)
+        Platform::MemoryCopy(&prevData, AsData, sizeof(Matrix));
+
     bool invalidType = false;
     switch (_type)
     {
@@ -275,6 +311,19 @@ void MaterialParameter::SetValue(const Variant& value)
     {
         LOG(Error, "Invalid material parameter value type {0} to set (param type: {1})", value.Type, ScriptingEnum::ToString(_type));
     }
+    else if (isStatic && Platform::MemoryCompare(&prevData, AsData, sizeof(Matrix)) != 0)
+    {
+        onChanged();
+    }
+}
+
+void MaterialParameter::SetIsOverride(bool value)
+{
+    if (_override != value)
+    {
+        _override = value;
+        onChanged();
+    }
 }
 
 void MaterialParameter::Bind(BindMeta& meta) const
@@ -476,6 +525,17 @@ bool MaterialParameter::HasContentLoaded() const
     return _asAsset == nullptr || _asAsset->IsLoaded();
 }
 
+bool MaterialParameter::IsStaticConstant() const
+{
+    return GetStaticConstantSize(_type) != 0;
+}
+
+void MaterialParameter::onChanged()
+{
+    if (_owner)
+        _owner->OnChanged();
+}
+
 void MaterialParameter::clone(const MaterialParameter* param)
 {
     // Clone data
@@ -597,16 +657,32 @@ int32 MaterialParams::GetVersionHash() const
 void MaterialParams::Bind(MaterialParamsLink* link, MaterialParameter::BindMeta& meta)
 {
     ASSERT(link && link->This);
-    for (int32 i = 0; i < link->This->Count(); i++)
+    MaterialParams* params = link->This;
+    const BindCache& cache = params->_bindCache;
+
+    // Rebuild cached binding if any collection in the link chain has been modified
+    int32 chainLength = 0;
+    for (const MaterialParamsLink* l = link; l; l = l->Down, chainLength++)
     {
-        MaterialParamsLink* l = link;
-        while (l->Down && !l->This->At(i).IsOverride())
+        if (chainLength >= cache.Chain.Count() || cache.Chain[chainLength].First != l->This || cache.Chain[chainLength].Second != l->This->_dataVersion)
         {
-            l = l->Down;
+            chainLength = -1;
+            break;
         }
+    }
+    if (chainLength != cache.Chain.Count())
+        params->CacheBinding(link);
 
-        l->This->At(i).Bind(meta);
+    // Copy pre-resolved constants
+    for (const Int2& range : cache.ConstantsRanges)
+    {
+        ASSERT_LOW_LAYER(meta.Constants.Get() && meta.Constants.Length() >= range.X + range.Y);
+        Platform::MemoryCopy(meta.Constants.Get() + range.X, cache.Constants.Get() + range.X, range.Y);
     }
+
+    // Bind resources and dynamic constants
+    for (const MaterialParameter* param : cache.Dynamic)
+        param->Bind(meta);
 }
 
 void MaterialParams::Clone(MaterialParams& result)
@@ -620,13 +696,17 @@ void MaterialParams::Clone(MaterialParams& result)
         result.At(i).clone(&At(i));
     }
 
+    for (int32 i = 0; i < Count(); i++)
+        result.At(i)._owner = &result;
     result._versionHash = _versionHash;
+    result.OnChanged();
 }
 
 void MaterialParams::Dispose()
 {
     Resize(0);
     _versionHash = 0;
+    OnChanged();
 }
 
 bool MaterialParams::Load(ReadStream* stream)
@@ -875,7 +955,10 @@ bool MaterialParams::Load(ReadStream* stream)
         }
     }
 
+    for (int32 i = 0; i < Count(); i++)
+        At(i)._owner = this;
     UpdateHash();
+    OnChanged();
 
     return result;
 }
@@ -1073,3 +1156,73 @@ void MaterialParams::UpdateHash()
 {
     _versionHash = rand();
 }
+
+void MaterialParams::OnChanged()
+{
+    // Use globally unique version to detect the reused collections memory
+    _dataVersion = Platform::InterlockedIncrement(&ParamsDataVersion);
+}
+
+void MaterialParams::CacheBinding(MaterialParamsLink* link)
+{
+    PROFILE_CPU();
+    BindCache& cache = _bindCache;
+    cache.Chain.Clear();
+    cache.ConstantsRanges.Clear();
+    cache.Dynamic.Clear();
+    for (const MaterialParamsLink* l = link; l; l = l->Down)
+        cache.Chain.Add(ToPair((const MaterialParams*)l->This, l->This->_dataVersion));
+
+    // Resolve parameters overrides across the link chain
+    Array<const MaterialParameter*, InlinedAllocation<64>> staticParams;
+    int32 constantsSize = 0;
+    for (int32 i = 0; i < Count(); i++)
+    {
+        const MaterialParamsLink* l = link;
+        while (l->Down && !l->This->At(i).IsOverride())
+            l = l->Down;
+        const MaterialParameter& param = l->This->At(i);
+        const int32 size = GetStaticConstantSize(param._type);
+        if (size != 0)
+        {
+            staticParams.Add(&param);
+            constantsSize = Math::Max(constantsSize, (int32)param._offset + size);
+        }
+        else
+        {
+            cache.Dynamic.Add(&param);
+        }
+    }
+
+    // Write static constants into the image
+    cache.Constants.Resize(constantsSize, false);
+    Platform::MemoryClear(cache.Constants.Get(), constantsSize);
+    MaterialParameter::BindMeta meta;
+    meta.Context = nullptr;
+    meta.Constants = Span<byte>(cache.Constants.Get(), constantsSize);
+    meta.Input = nullptr;
+    meta.Buffers = nullptr;
+    meta.CanSampleDepth = meta.CanSampleGBuffer = false;
+    Array<bool, InlinedAllocation<1024>> used;
+    used.Resize(constantsSize, false);
+    Platform::MemoryClear(used.Get(), constantsSize);
+    for (const MaterialParameter* param : staticParams)
+    {
+        param->Bind(meta);
+        Platform::MemorySet(used.Get() + param->_offset, GetStaticConstantSize(param->_type), 1);
+    }
+
+    // Gather continuous ranges of written constants
+    for (int32 i = 0; i < constantsSize;)
+    {
+        if (!used[i])
+        {
+            i++;
+            continue;
+        }
+        const int32 start = i;
+        while (i < constantsSize && used[i])
+            i++;
+        cache.ConstantsRanges.Add(Int2(start, i - start));
+    }
+}
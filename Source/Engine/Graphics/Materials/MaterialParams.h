@@ -6,6 +6,7 @@
 #include "Engine/Core/Math/Vector2.h"
 #include "Engine/Core/Math/Vector3.h"
 #include "Engine/Core/Types/StringView.h"
+#include "Engine/Core/Types/Pair.h"
 #include "Engine/Core/Collections/Array.h"
 #include "Engine/Scripting/ScriptingObjectReference.h"
 #include "Engine/Content/Assets/Texture.h"
@@ -197,6 +198,7 @@ API_CLASS(NoSpawn) class FLAXENGINE_API MaterialParameter : public ScriptingObje
     AssetReference<Asset> _asAsset;
     ScriptingObjectReference<GPUTexture> _asGPUTexture;
     String _name;
+    MaterialParams* _owner = nullptr;
 
 public:
     MaterialParameter(const MaterialParameter& other)
@@ -259,10 +261,7 @@ API_CLASS(NoSpawn) class FLAXENGINE_API MaterialParameter : public ScriptingObje
     /// <summary>
     /// Sets the value override mode.
     /// </summary>
-    API_PROPERTY() void SetIsOverride(bool value)
-    {
-        _override = value;
-    }
+    API_PROPERTY() void SetIsOverride(bool value);
 
     /// <summary>
     /// Gets the parameter resource graphics pipeline binding register index.
@@ -338,8 +337,14 @@ API_CLASS(NoSpawn) class FLAXENGINE_API MaterialParameter : public ScriptingObje
 
     bool HasContentLoaded() const;
 
+    /// <summary>
+    /// Returns true if parameter binds only the constant buffer data that depends solely on the parameter value (can be cached).
+    /// </summary>
+    bool IsStaticConstant() const;
+
 private:
     void clone(const MaterialParameter* param);
+    void onChanged();
 
 public:
     bool operator==(const MaterialParameter& other) const;
@@ -354,8 +359,24 @@ API_CLASS(NoSpawn) class FLAXENGINE_API MaterialParameter : public ScriptingObje
 class FLAXENGINE_API MaterialParams : public Array<MaterialParameter>
 {
     friend MaterialInstance;
+    friend MaterialParameter;
 private:
+    // Pre-resolved parameters binding data for the params link chain that starts with this collection
+    struct BindCache
+    {
+        // Collections in the link chain with their data version used to build the cache
+        Array<Pair<const MaterialParams*, int64>, InlinedAllocation<4>> Chain;
+        // Constant buffer image with values of the static constants
+        Array<byte> Constants;
+        // Ranges (offset and size) of the constants image to copy
+        Array<Int2> ConstantsRanges;
+        // Parameters that need to be bound on every use (resources and dynamic constants)
+        Array<const MaterialParameter*> Dynamic;
+    };
+
     int32 _versionHash = 0;
+    int64 _dataVersion = 0;
+    BindCache _bindCache;
 
 public:
     MaterialParameter* Get(const Guid& id);
@@ -430,4 +451,6 @@ class FLAXENGINE_API MaterialParams : public Array<MaterialParameter>
 
 private:
     void UpdateHash();
+    void OnChanged();
+    void CacheBinding(MaterialParamsLink* link);
 };
@@ -97,27 +97,17 @@ void ForwardShadingFeature::Bind(MaterialShader::BindParameters& params, Span<by
         params.GPUContext->UnBindSR(envProbeShaderRegisterIndex);
     }
 
-    // Set local lights
-    data.LocalLightsCount = 0;
+    // Set local lights (pick the most important ones using the lights grid)
     const BoundingSphere objectBounds(drawCall.ObjectPosition, drawCall.ObjectRadius);
-    // TODO: optimize lights searching for a transparent material - use spatial cache for renderer to find it
-    for (int32 i = 0; i < cache->PointLights.Count() && data.LocalLightsCount < MaxLocalLights; i++)
+    int32 localLights[MaxLocalLights];
+    data.LocalLightsCount = cache->GetLocalLightsGrid(view).Query(objectBounds, localLights, MaxLocalLights);
+    for (int32 i = 0; i < data.LocalLightsCount; i++)
     {
-        const auto& light = cache->PointLights[i];
-        if (CollisionsHelper::SphereIntersectsSphere(objectBounds, BoundingSphere(light.Position, light.Radius)))
-        {
-            light.SetupLightData(&data.LocalLights[data.LocalLightsCount], false);
-            data.LocalLightsCount++;
-        }
-    }
-    for (int32 i = 0; i < cache->SpotLights.Count() && data.LocalLightsCount < MaxLocalLights; i++)
-    {
-        const auto& light = cache->SpotLights[i];
-        if (CollisionsHelper::SphereIntersectsSphere(objectBounds, BoundingSphere(light.Position, light.Radius)))
-        {
-            light.SetupLightData(&data.LocalLights[data.LocalLightsCount], false);
-            data.LocalLightsCount++;
-        }
+        const int32 lightIndex = localLights[i];
+        if (lightIndex < cache->PointLights.Count())
+            cache->PointLights.Get()[lightIndex].SetupLightData(&data.LocalLights[i], false);
+        else
+            cache->SpotLights.Get()[lightIndex - cache->PointLights.Count()].SetupLightData(&data.LocalLights[i], false);
     }
 
     cb = Span<byte>(cb.Get() + sizeof(Data), cb.Length() - sizeof(Data));
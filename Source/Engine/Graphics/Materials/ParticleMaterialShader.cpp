@@ -83,7 +83,7 @@ void ParticleMaterialShader::Bind(BindParameters& params)
             if (param.GetParameterType() == MaterialParameterType::Integer && param.GetName().StartsWith(TEXT("Particle.")))
             {
                 const StringView name(param.GetName().Get() + 9, param.GetName().Length() - 9);
-                const int32 offset = drawCall.Particle.Particles->Layout->FindAttributeOffset(name);
+                const int32 offset = drawCall.Particle.Particles->Layout->FindAttributeShaderOffset(name);
                 ASSERT_LOW_LAYER(bindMeta.Constants.Get() && bindMeta.Constants.Length() >= (int32)param.GetBindOffset() + sizeof(int32));
                 *((int32*)(bindMeta.Constants.Get() + param.GetBindOffset())) = offset;
             }
@@ -105,14 +105,14 @@ void ParticleMaterialShader::Bind(BindParameters& params)
         materialData->SortedIndicesOffset = drawCall.Particle.Particles->GPU.SortedIndices && params.RenderContext.View.Pass != DrawPass::Depth ? sortedIndicesOffset : 0xFFFFFFFF;
         materialData->PerInstanceRandom = drawCall.PerInstanceRandom;
         materialData->ParticleStride = drawCall.Particle.Particles->Stride;
-        materialData->PositionOffset = drawCall.Particle.Particles->Layout->FindAttributeOffset(ParticlePosition, ParticleAttribute::ValueTypes::Float3);
-        materialData->SpriteSizeOffset = drawCall.Particle.Particles->Layout->FindAttributeOffset(ParticleSpriteSize, ParticleAttribute::ValueTypes::Float2);
-        materialData->SpriteFacingModeOffset = drawCall.Particle.Particles->Layout->FindAttributeOffset(ParticleSpriteFacingMode, ParticleAttribute::ValueTypes::Int, -1);
-        materialData->SpriteFacingVectorOffset = drawCall.Particle.Particles->Layout->FindAttributeOffset(ParticleSpriteFacingVector, ParticleAttribute::ValueTypes::Float3);
-        materialData->VelocityOffset = drawCall.Particle.Particles->Layout->FindAttributeOffset(ParticleVelocityOffset, ParticleAttribute::ValueTypes::Float3);
-        materialData->RotationOffset = drawCall.Particle.Particles->Layout->FindAttributeOffset(ParticleRotationOffset, ParticleAttribute::ValueTypes::Float3, -1);
-        materialData->ScaleOffset = drawCall.Particle.Particles->Layout->FindAttributeOffset(ParticleScaleOffset, ParticleAttribute::ValueTypes::Float3, -1);
-        materialData->ModelFacingModeOffset = drawCall.Particle.Particles->Layout->FindAttributeOffset(ParticleModelFacingModeOffset, ParticleAttribute::ValueTypes::Int, -1);
+        materialData->PositionOffset = drawCall.Particle.Particles->Layout->FindAttributeShaderOffset(ParticlePosition, ParticleAttribute::ValueTypes::Float3);
+        materialData->SpriteSizeOffset = drawCall.Particle.Particles->Layout->FindAttributeShaderOffset(ParticleSpriteSize, ParticleAttribute::ValueTypes::Float2);
+        materialData->SpriteFacingModeOffset = drawCall.Particle.Particles->Layout->FindAttributeShaderOffset(ParticleSpriteFacingMode, ParticleAttribute::ValueTypes::Int, -1);
+        materialData->SpriteFacingVectorOffset = drawCall.Particle.Particles->Layout->FindAttributeShaderOffset(ParticleSpriteFacingVector, ParticleAttribute::ValueTypes::Float3);
+        materialData->VelocityOffset = drawCall.Particle.Particles->Layout->FindAttributeShaderOffset(ParticleVelocityOffset, ParticleAttribute::ValueTypes::Float3);
+        materialData->RotationOffset = drawCall.Particle.Particles->Layout->FindAttributeShaderOffset(ParticleRotationOffset, ParticleAttribute::ValueTypes::Float3, -1);
+        materialData->ScaleOffset = drawCall.Particle.Particles->Layout->FindAttributeShaderOffset(ParticleScaleOffset, ParticleAttribute::ValueTypes::Float3, -1);
+        materialData->ModelFacingModeOffset = drawCall.Particle.Particles->Layout->FindAttributeShaderOffset(ParticleModelFacingModeOffset, ParticleAttribute::ValueTypes::Int, -1);
         Matrix::Invert(drawCall.World, materialData->WorldMatrixInverseTransposed);
     }
 
@@ -143,9 +143,9 @@ void ParticleMaterialShader::Bind(BindParameters& params)
         static StringView ParticleRibbonTwist(TEXT("RibbonTwist"));
         static StringView ParticleRibbonFacingVector(TEXT("RibbonFacingVector"));
 
-        materialData->RibbonWidthOffset = drawCall.Particle.Particles->Layout->FindAttributeOffset(ParticleRibbonWidth, ParticleAttribute::ValueTypes::Float, -1);
-        materialData->RibbonTwistOffset = drawCall.Particle.Particles->Layout->FindAttributeOffset(ParticleRibbonTwist, ParticleAttribute::ValueTypes::Float, -1);
-        materialData->RibbonFacingVectorOffset = drawCall.Particle.Particles->Layout->FindAttributeOffset(ParticleRibbonFacingVector, ParticleAttribute::ValueTypes::Float3, -1);
+        materialData->RibbonWidthOffset = drawCall.Particle.Particles->Layout->FindAttributeShaderOffset(ParticleRibbonWidth, ParticleAttribute::ValueTypes::Float, -1);
+        materialData->RibbonTwistOffset = drawCall.Particle.Particles->Layout->FindAttributeShaderOffset(ParticleRibbonTwist, ParticleAttribute::ValueTypes::Float, -1);
+        materialData->RibbonFacingVectorOffset = drawCall.Particle.Particles->Layout->FindAttributeShaderOffset(ParticleRibbonFacingVector, ParticleAttribute::ValueTypes::Float3, -1);
 
         materialData->RibbonUVTilingDistance = drawCall.Particle.Ribbon.UVTilingDistance;
         materialData->RibbonUVScale.X = drawCall.Particle.Ribbon.UVScaleX;
@@ -1,8 +1,16 @@
 // Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
 
 #include "MeshDeformation.h"
+#include "Engine/Content/Assets/ModelBase.h"
+#include "Engine/Engine/Engine.h"
+#include "Engine/Engine/EngineService.h"
+#include "Engine/Graphics/GPUContext.h"
+#include "Engine/Graphics/GPUDevice.h"
+#include "Engine/Graphics/RenderTask.h"
 #include "Engine/Graphics/Models/MeshBase.h"
+#include "Engine/Platform/CriticalSection.h"
 #include "Engine/Profiler/ProfilerCPU.h"
+#include "Engine/Threading/JobSystem.h"
 
 struct Key
 {
@@ -29,56 +37,123 @@ FORCE_INLINE static uint32 GetKey(int32 lodIndex, int32 meshIndex, MeshBufferTyp
     return key.Value;
 }
 
-void MeshDeformation::GetBounds(int32 lodIndex, int32 meshIndex, BoundingBox& bounds) const
+class MeshDeformationService : public EngineService
 {
-    const auto key = GetKey(lodIndex, meshIndex, MeshBufferType::Vertex0);
-    for (MeshDeformationData* deformation : _deformations)
+public:
+    struct DeformMesh
+    {
+        MeshDeformationData* Deformation;
+        const MeshBase* Mesh;
+        const Delegate<const MeshBase*, MeshDeformationData&>* Deformer;
+        const Delegate<const MeshBase*, MeshDeformationData&, MeshDeformationSpan&>* SpanDeformer;
+        BytesContainer VertexData;
+        int32 VertexCount;
+        uint32 RestoreMin;
+        uint32 RestoreMax;
+    };
+
+    struct DeformJob
+    {
+        int32 MeshIndex;
+        MeshDeformationSpan Span;
+    };
+
+    CriticalSection Locker;
+    Array<MeshDeformation*> DirtyList;
+    Array<MeshDeformation*> UpdateList;
+    Array<DeformMesh> Meshes;
+    Array<DeformJob> Jobs;
+
+    MeshDeformationService()
+        : EngineService(TEXT("Mesh Deformation"))
     {
-        if (deformation->Key == key)
-        {
-            bounds = deformation->Bounds;
-            break;
-        }
     }
+
+    void Job(int32 index);
+    void Draw() override;
+};
+
+MeshDeformationService MeshDeformationServiceInstance;
+
+void MeshDeformationService::Job(int32 index)
+{
+    PROFILE_CPU_NAMED("MeshDeformation.Job");
+    DeformJob& job = Jobs[index];
+    DeformMesh& mesh = Meshes[job.MeshIndex];
+    MeshDeformation::DeformSpan(mesh.Deformation, mesh.SpanDeformer, mesh.Mesh, mesh.VertexData, mesh.RestoreMin, mesh.RestoreMax, job.Span);
+}
+
+void MeshDeformationService::Draw()
+{
+    MeshDeformation::RunQueuedDeformers();
+}
+
+void MeshDeformationVertexBuffer::Flush(uint32 offset, uint32 size)
+{
+    if (!_buffer || _buffer->GetSize() < (uint32)Data.Count() || !GPUDevice::Instance->IsRendering())
+    {
+        // Create buffer and upload all data
+        DynamicBuffer::Flush();
+        return;
+    }
+    ASSERT(offset + size <= (uint32)Data.Count());
+
+    // Upload only the modified data
+    RenderContext::GPULocker.Lock();
+    GPUDevice::Instance->GetMainContext()->UpdateBuffer(_buffer, Data.Get() + offset, size, offset);
+    RenderContext::GPULocker.Unlock();
+}
+
+MeshDeformation::~MeshDeformation()
+{
+    MeshDeformationServiceInstance.Locker.Lock();
+    if (_queued)
+        MeshDeformationServiceInstance.DirtyList.Remove(this);
+    MeshDeformationServiceInstance.Locker.Unlock();
+    SetModel(nullptr);
+    Clear();
+}
+
+void MeshDeformation::GetBounds(int32 lodIndex, int32 meshIndex, BoundingBox& bounds) const
+{
+    const auto key = GetKey(lodIndex, meshIndex, MeshBufferType::Vertex0);
+    MeshDeformationData* deformation;
+    if (_deformations.TryGet(key, deformation))
+        bounds = deformation->Bounds;
 }
 
 void MeshDeformation::Clear()
 {
-    for (MeshDeformationData* e : _deformations)
-        Delete(e);
-    _deformations.Clear();
+    _deformations.ClearDelete();
 }
 
 void MeshDeformation::Dirty()
 {
-    for (MeshDeformationData* deformation : _deformations)
-        deformation->Dirty = true;
+    for (auto& e : _deformations)
+        e.Value->Dirty = true;
+    Queue();
 }
 
 void MeshDeformation::Dirty(int32 lodIndex, int32 meshIndex, MeshBufferType type)
 {
     const auto key = GetKey(lodIndex, meshIndex, type);
-    for (MeshDeformationData* deformation : _deformations)
+    MeshDeformationData* deformation;
+    if (_deformations.TryGet(key, deformation))
     {
-        if (deformation->Key == key)
-        {
-            deformation->Dirty = true;
-            break;
-        }
+        deformation->Dirty = true;
+        Queue();
     }
 }
 
 void MeshDeformation::Dirty(int32 lodIndex, int32 meshIndex, MeshBufferType type, const BoundingBox& bounds)
 {
     const auto key = GetKey(lodIndex, meshIndex, type);
-    for (MeshDeformationData* deformation : _deformations)
+    MeshDeformationData* deformation;
+    if (_deformations.TryGet(key, deformation))
     {
-        if (deformation->Key == key)
-        {
-            deformation->Dirty = true;
-            deformation->Bounds = bounds;
-            break;
-        }
+        deformation->Dirty = true;
+        deformation->Bounds = bounds;
+        Queue();
     }
 }
 
@@ -96,71 +171,277 @@ void MeshDeformation::RemoveDeformer(int32 lodIndex, int32 meshIndex, MeshBuffer
     Dirty(lodIndex, meshIndex, type);
 }
 
+void MeshDeformation::AddSpanDeformer(int32 lodIndex, int32 meshIndex, MeshBufferType type, const Function<void(const MeshBase* mesh, MeshDeformationData& deformation, MeshDeformationSpan& span)>& deformer)
+{
+    const auto key = GetKey(lodIndex, meshIndex, type);
+    _spanDeformers[key].Bind(deformer);
+    Dirty(lodIndex, meshIndex, type);
+}
+
+void MeshDeformation::RemoveSpanDeformer(int32 lodIndex, int32 meshIndex, MeshBufferType type, const Function<void(const MeshBase* mesh, MeshDeformationData& deformation, MeshDeformationSpan& span)>& deformer)
+{
+    const auto key = GetKey(lodIndex, meshIndex, type);
+    _spanDeformers[key].Unbind(deformer);
+    Dirty(lodIndex, meshIndex, type);
+}
+
 void MeshDeformation::RunDeformers(const MeshBase* mesh, MeshBufferType type, GPUBuffer*& vertexBuffer)
 {
     const auto key = GetKey(mesh->GetLODIndex(), mesh->GetIndex(), type);
-    if (const auto* e = _deformers.TryGet(key))
+    const auto* deformer = _deformers.TryGet(key);
+    const auto* spanDeformer = _spanDeformers.TryGet(key);
+    if (!deformer && !spanDeformer)
+        return;
+    const int32 vertexStride = vertexBuffer->GetStride();
+
+    // Get mesh deformation container
+    MeshDeformationData* deformation = nullptr;
+    _deformations.TryGet(key, deformation);
+    if ((!deformer || !deformer->IsBinded()) && (!spanDeformer || !spanDeformer->IsBinded()))
     {
+        // Auto-recycle unused deformations
+        if (deformation)
+        {
+            _deformations.Remove(key);
+            Delete(deformation);
+        }
+        _deformers.Remove(key);
+        _spanDeformers.Remove(key);
+        return;
+    }
+    if (!deformation)
+    {
+        deformation = New<MeshDeformationData>(key, type, vertexStride);
+        deformation->VertexBuffer.Data.Resize(vertexBuffer->GetSize());
+        deformation->Bounds = mesh->GetBox();
+        _deformations.Add(key, deformation);
+    }
+    if (_model != mesh->GetModelBase())
+        SetModel(mesh->GetModelBase());
+    deformation->Mesh = mesh;
+    deformation->LastFrameDrawn = Engine::FrameCount;
+
+    if (deformation->Dirty)
+    {
+        // Deformation was not updated ahead of the rendering (eg. first draw or mesh was not visible in the previous frame)
         PROFILE_CPU();
-        const int32 vertexStride = vertexBuffer->GetStride();
 
-        // Get mesh deformation container
-        MeshDeformationData* deformation = nullptr;
-        for (int32 i = 0; i < _deformations.Count(); i++)
+        // Get original mesh vertex buffer data (cached on CPU)
+        BytesContainer vertexData;
+        int32 vertexCount;
+        if (mesh->DownloadDataCPU(type, vertexData, vertexCount) || vertexCount <= 0)
+            return;
+        ASSERT(vertexData.Length() / vertexCount == vertexStride);
+
+        // Deform all vertices at once
+        uint32 restoreMin, restoreMax;
+        BeginDeform(deformation, vertexData, vertexCount, restoreMin, restoreMax);
+        MeshDeformationSpan span;
+        span.VertexStart = 0;
+        span.VertexEnd = (uint32)vertexCount - 1;
+        DeformSpan(deformation, spanDeformer, mesh, vertexData, restoreMin, restoreMax, span);
+        EndDeform(deformation, deformer, mesh, vertexCount, restoreMin, restoreMax);
+        Upload(deformation);
+    }
+
+    // Override vertex buffer for draw call
+    vertexBuffer = deformation->VertexBuffer.GetBuffer();
+}
+
+void MeshDeformation::RunQueuedDeformers()
+{
+    auto& service = MeshDeformationServiceInstance;
+
+    // Copy list of deformations to update (new ones can be dirtied during rendering)
+    service.Locker.Lock();
+    if (service.DirtyList.IsEmpty())
+    {
+        service.Locker.Unlock();
+        return;
+    }
+    PROFILE_CPU_NAMED("MeshDeformation");
+    service.UpdateList.Clear();
+    service.UpdateList.Add(service.DirtyList);
+    service.DirtyList.Clear();
+    for (MeshDeformation* deformation : service.UpdateList)
+        deformation->_queued = false;
+    service.Locker.Unlock();
+
+    // Collect dirty deformations of the meshes that were drawn recently (culled meshes get updated lazily on draw)
+    service.Meshes.Clear();
+    service.Jobs.Clear();
+    for (MeshDeformation* deformation : service.UpdateList)
+    {
+        for (auto& e : deformation->_deformations)
         {
-            if (_deformations[i]->Key == key)
+            MeshDeformationData* data = e.Value;
+            if (!data->Dirty || !data->Mesh || data->LastFrameDrawn + 1 < Engine::FrameCount)
+                continue;
+            const auto* deformer = deformation->_deformers.TryGet(e.Key);
+            const auto* spanDeformer = deformation->_spanDeformers.TryGet(e.Key);
+            if (deformer && !deformer->IsBinded())
+                deformer = nullptr;
+            if (spanDeformer && !spanDeformer->IsBinded())
+                spanDeformer = nullptr;
+            if (!deformer && !spanDeformer)
+                continue;
+
+            // Get original mesh vertex buffer data (cached on CPU, accessed on a main thread to not race on the mesh cache init)
+            const int32 meshIndex = service.Meshes.Count();
+            auto& mesh = service.Meshes.AddOne();
+            mesh.Deformation = data;
+            mesh.Mesh = data->Mesh;
+            mesh.Deformer = deformer;
+            mesh.SpanDeformer = spanDeformer;
+            if (data->Mesh->DownloadDataCPU(data->Type, mesh.VertexData, mesh.VertexCount) || mesh.VertexCount <= 0)
             {
-                deformation = _deformations[i];
-                break;
+                service.Meshes.RemoveLast();
+                continue;
             }
-        }
-        if (!e->IsBinded())
-        {
-            // Auto-recycle unused deformations
-            if (deformation)
+            BeginDeform(data, mesh.VertexData, mesh.VertexCount, mesh.RestoreMin, mesh.RestoreMax);
+
+            // Split vertices into spans (restoring the previous dirty range and running span deformers)
+            for (uint32 vertexStart = 0; vertexStart < (uint32)mesh.VertexCount; vertexStart += SpanSize)
             {
-                _deformations.Remove(deformation);
-                Delete(deformation);
+                auto& job = service.Jobs.AddOne();
+                job.MeshIndex = meshIndex;
+                job.Span.VertexStart = vertexStart;
+                job.Span.VertexEnd = Math::Min(vertexStart + SpanSize, (uint32)mesh.VertexCount) - 1;
             }
-            _deformers.Remove(key);
-            return;
-        }
-        if (!deformation)
-        {
-            deformation = New<MeshDeformationData>(key, type, vertexStride);
-            deformation->VertexBuffer.Data.Resize(vertexBuffer->GetSize());
-            deformation->Bounds = mesh->GetBox();
-            _deformations.Add(deformation);
         }
+    }
+    if (service.Meshes.IsEmpty())
+        return;
 
-        if (deformation->Dirty)
+    // Run span deformers in parallel
+    Function<void(int32)> func;
+    func.Bind<MeshDeformationService, &MeshDeformationService::Job>(&service);
+    JobSystem::Execute(func, service.Jobs.Count());
+
+    // Merge spans and run the remaining deformers on a main thread
+    int32 jobIndex = 0;
+    for (int32 meshIndex = 0; meshIndex < service.Meshes.Count(); meshIndex++)
+    {
+        auto& mesh = service.Meshes[meshIndex];
+        MeshDeformationData* data = mesh.Deformation;
+        for (; jobIndex < service.Jobs.Count() && service.Jobs[jobIndex].MeshIndex == meshIndex; jobIndex++)
         {
-            // Get original mesh vertex buffer data (cached on CPU)
-            BytesContainer vertexData;
-            int32 vertexCount;
-            if (mesh->DownloadDataCPU(type, vertexData, vertexCount))
-                return;
-            ASSERT(vertexData.Length() / vertexCount == vertexStride);
-
-            // Init dirty range with valid data (use the dirty range from the previous update to be cleared with initial data)
-            deformation->VertexBuffer.Data.Resize(vertexData.Length());
-            const uint32 dirtyDataStart = Math::Min<uint32>(deformation->DirtyMinIndex, vertexCount - 1) * vertexStride;
-            const uint32 dirtyDataLength = Math::Min<uint32>(deformation->DirtyMaxIndex - deformation->DirtyMinIndex + 1, vertexCount) * vertexStride;
-            Platform::MemoryCopy(deformation->VertexBuffer.Data.Get() + dirtyDataStart, vertexData.Get() + dirtyDataStart, dirtyDataLength);
-
-            // Reset dirty state
-            deformation->DirtyMinIndex = MAX_uint32 - 1;
-            deformation->DirtyMaxIndex = 0;
-            deformation->Dirty = false;
-
-            // Run deformers
-            (*e)(mesh, *deformation);
-
-            // Upload modified vertex data to the GPU
-            deformation->VertexBuffer.Flush();
+            const MeshDeformationSpan& span = service.Jobs[jobIndex].Span;
+            if (span.DirtyMinIndex <= span.DirtyMaxIndex)
+            {
+                data->DirtyMinIndex = Math::Min(data->DirtyMinIndex, span.DirtyMinIndex);
+                data->DirtyMaxIndex = Math::Max(data->DirtyMaxIndex, span.DirtyMaxIndex);
+            }
         }
+        EndDeform(data, mesh.Deformer, mesh.Mesh, mesh.VertexCount, mesh.RestoreMin, mesh.RestoreMax);
+
+        // Upload modified vertices to the GPU
+        Upload(data);
+    }
+    service.Meshes.Clear();
+    service.Jobs.Clear();
+}
+
+void MeshDeformation::Queue()
+{
+    if (_queued)
+        return;
+    ScopeLock lock(MeshDeformationServiceInstance.Locker);
+    if (!_queued)
+    {
+        _queued = true;
+        MeshDeformationServiceInstance.DirtyList.Add(this);
+    }
+}
+
+void MeshDeformation::SetModel(ModelBase* model)
+{
+    if (_model)
+    {
+        _model->OnReloading.Unbind<MeshDeformation, &MeshDeformation::OnModelUnloaded>(this);
+        _model->OnUnloaded.Unbind<MeshDeformation, &MeshDeformation::OnModelUnloaded>(this);
+    }
+    _model = model;
+    if (_model)
+    {
+        _model->OnReloading.Bind<MeshDeformation, &MeshDeformation::OnModelUnloaded>(this);
+        _model->OnUnloaded.Bind<MeshDeformation, &MeshDeformation::OnModelUnloaded>(this);
+    }
+}
+
+void MeshDeformation::OnModelUnloaded(Asset* asset)
+{
+    // Meshes are released with the model data so drop deformations that cache them (recreated on the next draw)
+    SetModel(nullptr);
+    Clear();
+}
+
+void MeshDeformation::BeginDeform(MeshDeformationData* deformation, const BytesContainer& vertexData, int32 vertexCount, uint32& restoreMin, uint32& restoreMax)
+{
+    // Use the dirty range from the previous update to be cleared with initial data
+    deformation->VertexBuffer.Data.Resize(vertexData.Length());
+    restoreMin = deformation->DirtyMinIndex;
+    restoreMax = Math::Min(deformation->DirtyMaxIndex, (uint32)vertexCount - 1);
+
+    // Reset dirty state
+    deformation->DirtyMinIndex = MAX_uint32 - 1;
+    deformation->DirtyMaxIndex = 0;
+    deformation->Dirty = false;
+}
+
+void MeshDeformation::DeformSpan(MeshDeformationData* deformation, const Delegate<const MeshBase*, MeshDeformationData&, MeshDeformationSpan&>* deformer, const MeshBase* mesh, const BytesContainer& vertexData, uint32 restoreMin, uint32 restoreMax, MeshDeformationSpan& span)
+{
+    // Init dirty range within the span with valid data
+    const uint32 vertexStride = deformation->VertexBuffer.GetStride();
+    const uint32 copyMin = Math::Max(restoreMin, span.VertexStart);
+    const uint32 copyMax = Math::Min(restoreMax, span.VertexEnd);
+    if (copyMin <= copyMax)
+    {
+        const uint32 dataStart = copyMin * vertexStride;
+        const uint32 dataLength = (copyMax - copyMin + 1) * vertexStride;
+        Platform::MemoryCopy(deformation->VertexBuffer.Data.Get() + dataStart, vertexData.Get() + dataStart, dataLength);
+    }
+
+    // Run span deformers
+    span.DirtyMinIndex = MAX_uint32 - 1;
+    span.DirtyMaxIndex = 0;
+    if (deformer)
+        (*deformer)(mesh, *deformation, span);
+}
 
-        // Override vertex buffer for draw call
-        vertexBuffer = deformation->VertexBuffer.GetBuffer();
+void MeshDeformation::EndDeform(MeshDeformationData* deformation, const Delegate<const MeshBase*, MeshDeformationData&>* deformer, const MeshBase* mesh, int32 vertexCount, uint32 restoreMin, uint32 restoreMax)
+{
+    const uint32 vertexStride = deformation->VertexBuffer.GetStride();
+    const uint32 lastVertex = (uint32)vertexCount - 1;
+
+    // Run deformers
+    if (deformer)
+        (*deformer)(mesh, *deformation);
+
+    // Upload both restored and modified vertices
+    uint32 uploadMin = restoreMin, uploadMax = restoreMax;
+    if (deformation->DirtyMinIndex <= deformation->DirtyMaxIndex)
+    {
+        const uint32 dirtyMax = Math::Min(deformation->DirtyMaxIndex, lastVertex);
+        uploadMax = uploadMin <= uploadMax ? Math::Max(uploadMax, dirtyMax) : dirtyMax;
+        uploadMin = Math::Min(uploadMin, deformation->DirtyMinIndex);
     }
+    if (uploadMin <= uploadMax)
+    {
+        deformation->UploadOffset = uploadMin * vertexStride;
+        deformation->UploadSize = (uploadMax - uploadMin + 1) * vertexStride;
+    }
+    else
+    {
+        deformation->UploadOffset = 0;
+        deformation->UploadSize = 0;
+    }
+}
+
+void MeshDeformation::Upload(MeshDeformationData* deformation)
+{
+    if (deformation->UploadSize == 0 && deformation->VertexBuffer.GetBuffer())
+        return;
+    deformation->VertexBuffer.Flush(deformation->UploadOffset, deformation->UploadSize);
+    deformation->UploadSize = 0;
 }
@@ -7,6 +7,44 @@
 #include "Engine/Graphics/Models/Types.h"
 #include "Engine/Graphics/DynamicBuffer.h"
 
+class Asset;
+
+/// <summary>
+/// The vertex buffer for mesh deformation. Uses default GPU memory (not dynamic) to support uploading only the modified range of vertices.
+/// </summary>
+class FLAXENGINE_API MeshDeformationVertexBuffer : public DynamicVertexBuffer
+{
+public:
+    MeshDeformationVertexBuffer(uint32 initialCapacity, uint32 stride, const String& name = String::Empty)
+        : DynamicVertexBuffer(initialCapacity, stride, name)
+    {
+    }
+
+    using DynamicBuffer::Flush;
+
+    /// <summary>
+    /// Gets the size of a single vertex (in bytes).
+    /// </summary>
+    FORCE_INLINE uint32 GetStride() const
+    {
+        return _stride;
+    }
+
+    /// <summary>
+    /// Uploads the range of the data to the GPU buffer. Performs full data upload if buffer is not yet created.
+    /// </summary>
+    /// <param name="offset">The offset of the data to upload (in bytes).</param>
+    /// <param name="size">The size of the data to upload (in bytes).</param>
+    void Flush(uint32 offset, uint32 size);
+
+protected:
+    // [DynamicVertexBuffer]
+    void InitDesc(GPUBufferDescription& desc, int32 numElements) override
+    {
+        desc = GPUBufferDescription::Vertex(_stride, numElements, GPUResourceUsage::Default);
+    }
+};
+
 /// <summary>
 /// The mesh deformation data container.
 /// </summary>
@@ -18,7 +56,15 @@ struct MeshDeformationData
     uint32 DirtyMaxIndex = MAX_uint32 - 1;
     bool Dirty = true;
     BoundingBox Bounds;
-    DynamicVertexBuffer VertexBuffer;
+    MeshDeformationVertexBuffer VertexBuffer;
+
+    // The mesh from the last drawing (used to run deformers ahead of the rendering) and the frame number when it was drawn. Cleared when the mesh model gets unloaded or reloaded.
+    const MeshBase* Mesh = nullptr;
+    uint64 LastFrameDrawn = 0;
+
+    // The range of the vertex data modified by the last deformation that needs to be uploaded to the GPU (in bytes).
+    uint32 UploadOffset = 0;
+    uint32 UploadSize = 0;
 
     MeshDeformationData(uint64 key, MeshBufferType type, uint32 stride)
         : Key(key)
@@ -34,27 +80,73 @@ struct MeshDeformationData
     }
 };
 
+/// <summary>
+/// The range of the mesh vertices processed by the span deformer (see MeshDeformation::AddSpanDeformer).
+/// </summary>
+struct MeshDeformationSpan
+{
+    // The first and the last index of the vertices in the span (inclusive).
+    uint32 VertexStart;
+    uint32 VertexEnd;
+
+    // The range of the vertices within the span modified by the deformer (deformer should extend it to cover all the vertices it modifies).
+    uint32 DirtyMinIndex;
+    uint32 DirtyMaxIndex;
+};
+
 /// <summary>
 /// The mesh deformation utility for editing or morphing models dynamically at runtime (eg. via Blend Shapes or Cloth).
 /// </summary>
 class FLAXENGINE_API MeshDeformation
 {
+    friend class MeshDeformationService;
+public:
+    /// <summary>
+    /// The maximum amount of vertices processed by a single span deformer job. Larger meshes are split into multiple spans deformed in parallel.
+    /// </summary>
+    static constexpr uint32 SpanSize = 16 * 1024;
+
 private:
     Dictionary<uint32, Delegate<const MeshBase*, MeshDeformationData&>> _deformers;
-    Array<MeshDeformationData*> _deformations;
+    Dictionary<uint32, Delegate<const MeshBase*, MeshDeformationData&, MeshDeformationSpan&>> _spanDeformers;
+    Dictionary<uint32, MeshDeformationData*> _deformations;
+    ModelBase* _model = nullptr;
+    bool _queued = false;
 
 public:
-    ~MeshDeformation()
-    {
-        Clear();
-    }
-    
+    ~MeshDeformation();
+
     void GetBounds(int32 lodIndex, int32 meshIndex, BoundingBox& bounds) const;
     void Clear();
     void Dirty();
     void Dirty(int32 lodIndex, int32 meshIndex, MeshBufferType type);
     void Dirty(int32 lodIndex, int32 meshIndex, MeshBufferType type, const BoundingBox& bounds);
+
+    /// <summary>
+    /// Adds the deformer for the mesh vertex buffer. Deformers are invoked on the main thread before rendering the frame (for meshes drawn in the previous frame), or during mesh drawing (which may run on the Job System threads) when the deformation was not updated ahead of the rendering. Deformers run after the span deformers of the same mesh.
+    /// </summary>
     void AddDeformer(int32 lodIndex, int32 meshIndex, MeshBufferType type, const Function<void(const MeshBase* mesh, MeshDeformationData& deformation)>& deformer);
     void RemoveDeformer(int32 lodIndex, int32 meshIndex, MeshBufferType type, const Function<void(const MeshBase* mesh, MeshDeformationData& deformation)>& deformer);
+
+    /// <summary>
+    /// Adds the span deformer for the mesh vertex buffer. Span deformers are invoked on the Job System threads, in parallel for different meshes and for the separate spans of the large meshes (see SpanSize), thus they have to be thread-safe and modify only the vertices within the given span.
+    /// </summary>
+    void AddSpanDeformer(int32 lodIndex, int32 meshIndex, MeshBufferType type, const Function<void(const MeshBase* mesh, MeshDeformationData& deformation, MeshDeformationSpan& span)>& deformer);
+    void RemoveSpanDeformer(int32 lodIndex, int32 meshIndex, MeshBufferType type, const Function<void(const MeshBase* mesh, MeshDeformationData& deformation, MeshDeformationSpan& span)>& deformer);
+
     void RunDeformers(const MeshBase* mesh, MeshBufferType type, GPUBuffer*& vertexBuffer);
+
+    /// <summary>
+    /// Runs the deformers of all dirty deformations of the meshes drawn in the previous frame. Called by the engine before rendering the frame.
+    /// </summary>
+    static void RunQueuedDeformers();
+
+private:
+    void Queue();
+    void SetModel(ModelBase* model);
+    void OnModelUnloaded(Asset* asset);
+    static void BeginDeform(MeshDeformationData* deformation, const BytesContainer& vertexData, int32 vertexCount, uint32& restoreMin, uint32& restoreMax);
+    static void DeformSpan(MeshDeformationData* deformation, const Delegate<const MeshBase*, MeshDeformationData&, MeshDeformationSpan&>* deformer, const MeshBase* mesh, const BytesContainer& vertexData, uint32 restoreMin, uint32 restoreMax, MeshDeformationSpan& span);
+    static void EndDeform(MeshDeformationData* deformation, const Delegate<const MeshBase*, MeshDeformationData&>* deformer, const MeshBase* mesh, int32 vertexCount, uint32 restoreMin, uint32 restoreMax);
+    static void Upload(MeshDeformationData* deformation);
 };
@@ -1,41 +1,221 @@
 // Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
 
 #include "SkinnedMeshDrawData.h"
+#include "Engine/Graphics/GPUContext.h"
 #include "Engine/Graphics/GPUDevice.h"
+#include "Engine/Graphics/RenderTask.h"
 #include "Engine/Animations/Config.h"
 #include "Engine/Core/Log.h"
 #include "Engine/Core/Math/Matrix.h"
 #include "Engine/Core/Math/Matrix3x4.h"
+#include "Engine/Engine/EngineService.h"
+#include "Engine/Platform/CriticalSection.h"
+#include "Engine/Profiler/ProfilerCPU.h"
 
-SkinnedMeshDrawData::SkinnedMeshDrawData()
+class SkinnedMeshBonesService : public EngineService
 {
+public:
+    struct Range
+    {
+        int32 Offset;
+        int32 Count;
+    };
+
+    CriticalSection Locker;
+    GPUBuffer* Buffer = nullptr;
+    Array<byte> Staging; // CPU copy of the whole bones buffer (written directly by the animation update jobs)
+    int32 Capacity = 0; // Amount of bones that fit into both staging and GPU buffer
+    int32 Size = 0; // End of the allocated bones range
+    int32 DirtyMin = MAX_int32;
+    int32 DirtyMax = 0;
+    Array<Range> FreeRanges; // Sorted by offset
+    Array<SkinnedMeshDrawData*> Pending; // Data allocated outside the current capacity (copied to staging after resize)
+
+    SkinnedMeshBonesService()
+        : EngineService(TEXT("Skinned Mesh Bones"))
+    {
+    }
+
+    int32 Allocate(int32 count);
+    void Free(int32 offset, int32 count);
+    void Write(SkinnedMeshDrawData* data);
+    void Upload();
+    void Draw() override;
+    void Dispose() override;
+};
+
+SkinnedMeshBonesService SkinnedMeshBonesServiceInstance;
+
+int32 SkinnedMeshBonesService::Allocate(int32 count)
+{
+    ScopeLock lock(Locker);
+
+    // Reuse the first free range that fits
+    for (int32 i = 0; i < FreeRanges.Count(); i++)
+    {
+        Range& range = FreeRanges[i];
+        if (range.Count >= count)
+        {
+            const int32 offset = range.Offset;
+            range.Offset += count;
+            range.Count -= count;
+            if (range.Count == 0)
+                FreeRanges.RemoveAtKeepOrder(i);
+            return offset;
+        }
+    }
+
+    // Allocate at the end (buffer gets resized before the rendering)
+    const int32 offset = Size;
+    Size += count;
+    return offset;
 }
 
-SkinnedMeshDrawData::~SkinnedMeshDrawData()
+void SkinnedMeshBonesService::Free(int32 offset, int32 count)
 {
-    SAFE_DELETE_GPU_RESOURCE(BoneMatrices);
-    SAFE_DELETE_GPU_RESOURCE(PrevBoneMatrices);
+    ScopeLock lock(Locker);
+
+    // Insert range and merge it with the neighbours
+    int32 i = 0;
+    while (i < FreeRanges.Count() && FreeRanges[i].Offset < offset)
+        i++;
+    FreeRanges.Insert(i, { offset, count });
+    if (i + 1 < FreeRanges.Count() && offset + count == FreeRanges[i + 1].Offset)
+    {
+        FreeRanges[i].Count += FreeRanges[i + 1].Count;
+        FreeRanges.RemoveAtKeepOrder(i + 1);
+    }
+    if (i > 0 && FreeRanges[i - 1].Offset + FreeRanges[i - 1].Count == offset)
+    {
+        FreeRanges[i - 1].Count += FreeRanges[i].Count;
+        FreeRanges.RemoveAtKeepOrder(i);
+        i--;
+    }
+
+    // Shrink the used range if freed at the end
+    if (FreeRanges[i].Offset + FreeRanges[i].Count == Size)
+    {
+        Size = FreeRanges[i].Offset;
+        FreeRanges.RemoveAtKeepOrder(i);
+    }
 }
 
-void SkinnedMeshDrawData::Setup(int32 bonesCount)
+void SkinnedMeshBonesService::Write(SkinnedMeshDrawData* data)
 {
-    if (BoneMatrices == nullptr)
+    // Staging is resized only on a main thread before rendering so the animation jobs can write to their own ranges in parallel
+    const int32 offset = data->_bonesOffset;
+    const int32 count = data->BonesCount;
+    const bool fits = offset + count <= Capacity;
+    if (fits)
+        Platform::MemoryCopy(Staging.Get() + offset * sizeof(Matrix3x4), data->Data.Get(), count * sizeof(Matrix3x4));
+
+    ScopeLock lock(Locker);
+    if (!fits && !data->_isPending)
     {
-        BoneMatrices = GPUDevice::Instance->CreateBuffer(TEXT("BoneMatrices"));
+        data->_isPending = true;
+        Pending.Add(data);
     }
+    DirtyMin = Math::Min(DirtyMin, offset);
+    DirtyMax = Math::Max(DirtyMax, offset + count);
+}
 
-    const int32 elementsCount = bonesCount * 3; // 3 * float4 per bone
-    if (BoneMatrices->Init(GPUBufferDescription::Typed(elementsCount, PixelFormat::R32G32B32A32_Float, false, GPUResourceUsage::Dynamic)))
+void SkinnedMeshBonesService::Upload()
+{
+    if (!GPUDevice::Instance->IsRendering())
+        return;
+
+    // Send the whole modified range with a single copy
+    const int32 dirtyMax = Math::Min(DirtyMax, Capacity);
+    if (DirtyMin < dirtyMax)
     {
-        LOG(Error, "Failed to initialize the skinned mesh bones buffer");
+        const uint32 offset = DirtyMin * sizeof(Matrix3x4);
+        const uint32 size = (dirtyMax - DirtyMin) * sizeof(Matrix3x4);
+        RenderContext::GPULocker.Lock();
+        GPUDevice::Instance->GetMainContext()->UpdateBuffer(Buffer, Staging.Get() + offset, size, offset);
+        RenderContext::GPULocker.Unlock();
+    }
+    DirtyMin = MAX_int32;
+    DirtyMax = 0;
+}
+
+void SkinnedMeshBonesService::Draw()
+{
+    ScopeLock lock(Locker);
+    if (DirtyMax == 0 && Size <= Capacity)
         return;
+    PROFILE_CPU_NAMED("Skinned Mesh Bones");
+
+    // Resize buffer to fit all allocated bones
+    if (Size > Capacity)
+    {
+        const int32 capacity = Math::RoundUpToPowerOf2(Math::Max(Size, 1024));
+        if (Buffer == nullptr)
+            Buffer = GPUDevice::Instance->CreateBuffer(TEXT("BoneMatrices"));
+        if (Buffer->Init(GPUBufferDescription::Typed(capacity * 3, PixelFormat::R32G32B32A32_Float, false, GPUResourceUsage::Default)))
+        {
+            LOG(Error, "Failed to initialize the skinned mesh bones buffer");
+            Capacity = 0;
+            return;
+        }
+        Staging.Resize(capacity * sizeof(Matrix3x4));
+        Capacity = capacity;
+
+        // Upload all the data to the new buffer
+        DirtyMin = 0;
+        DirtyMax = Size;
     }
 
+    // Copy data that didn't fit into staging before
+    for (int32 i = Pending.Count() - 1; i >= 0; i--)
+    {
+        SkinnedMeshDrawData* data = Pending[i];
+        if (data->_bonesOffset + data->BonesCount <= Capacity)
+        {
+            Platform::MemoryCopy(Staging.Get() + data->_bonesOffset * sizeof(Matrix3x4), data->Data.Get(), data->BonesCount * sizeof(Matrix3x4));
+            data->_isPending = false;
+            Pending.RemoveAt(i);
+        }
+    }
+
+    Upload();
+}
+
+void SkinnedMeshBonesService::Dispose()
+{
+    SAFE_DELETE_GPU_RESOURCE(Buffer);
+    Staging.Resize(0);
+    Capacity = 0;
+}
+
+SkinnedMeshDrawData::SkinnedMeshDrawData()
+{
+}
+
+SkinnedMeshDrawData::~SkinnedMeshDrawData()
+{
+    Release();
+}
+
+GPUBuffer* SkinnedMeshDrawData::GetBoneMatrices()
+{
+    return SkinnedMeshBonesServiceInstance.Buffer;
+}
+
+bool SkinnedMeshDrawData::IsReady() const
+{
+    return _hasValidData && !_isPending && _bonesOffset != -1 && _bonesOffset + BonesCount <= SkinnedMeshBonesServiceInstance.Capacity;
+}
+
+void SkinnedMeshDrawData::Setup(int32 bonesCount)
+{
+    Release();
+
     BonesCount = bonesCount;
     _hasValidData = false;
     _isDirty = false;
-    Data.Resize(BoneMatrices->GetSize());
-    SAFE_DELETE_GPU_RESOURCE(PrevBoneMatrices);
+    Data.Resize(bonesCount * sizeof(Matrix3x4));
+    if (bonesCount > 0)
+        _bonesOffset = SkinnedMeshBonesServiceInstance.Allocate(bonesCount);
 }
 
 void SkinnedMeshDrawData::SetData(const Matrix* bones, bool dropHistory)
@@ -63,25 +243,57 @@ void SkinnedMeshDrawData::SetData(const Matrix* bones, bool dropHistory)
 
 void SkinnedMeshDrawData::OnDataChanged(bool dropHistory)
 {
-    // Setup previous frame bone matrices if needed
+    if (_bonesOffset == -1)
+        return;
+
+    // Setup previous frame bone matrices if needed (the current range becomes the previous one)
     if (_hasValidData && !dropHistory)
     {
-        ASSERT(BoneMatrices);
-        if (PrevBoneMatrices == nullptr)
-        {
-            PrevBoneMatrices = GPUDevice::Instance->CreateBuffer(TEXT("BoneMatrices"));
-            if (PrevBoneMatrices->Init(BoneMatrices->GetDescription()))
-            {
-                LOG(Fatal, "Failed to initialize the skinned mesh bones buffer");
-            }
-        }
-        Swap(PrevBoneMatrices, BoneMatrices);
+        if (_prevBonesOffset == -1)
+            _prevBonesOffset = SkinnedMeshBonesServiceInstance.Allocate(BonesCount);
+        Swap(_prevBonesOffset, _bonesOffset);
     }
-    else
+    else if (_prevBonesOffset != -1)
     {
-        SAFE_DELETE_GPU_RESOURCE(PrevBoneMatrices);
+        SkinnedMeshBonesServiceInstance.Free(_prevBonesOffset, BonesCount);
+        _prevBonesOffset = -1;
     }
 
+    // Write bones to the shared buffer
+    SkinnedMeshBonesServiceInstance.Write(this);
+
     _isDirty = true;
     _hasValidData = true;
 }
+
+void SkinnedMeshDrawData::Flush()
+{
+    auto& service = SkinnedMeshBonesServiceInstance;
+    if (Platform::AtomicRead(&service.DirtyMax) != 0)
+    {
+        ScopeLock lock(service.Locker);
+        service.Upload();
+    }
+    _isDirty = false;
+}
+
+void SkinnedMeshDrawData::Release()
+{
+    auto& service = SkinnedMeshBonesServiceInstance;
+    if (_isPending)
+    {
+        ScopeLock lock(service.Locker);
+        service.Pending.Remove(this);
+        _isPending = false;
+    }
+    if (_bonesOffset != -1)
+    {
+        service.Free(_bonesOffset, BonesCount);
+        _bonesOffset = -1;
+    }
+    if (_prevBonesOffset != -1)
+    {
+        service.Free(_prevBonesOffset, BonesCount);
+        _prevBonesOffset = -1;
+    }
+}
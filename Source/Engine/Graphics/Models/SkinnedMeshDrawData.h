@@ -6,13 +6,17 @@
 #include "Engine/Graphics/GPUBuffer.h"
 
 /// <summary>
-/// Data storage for the skinned meshes rendering
+/// Data storage for the skinned meshes rendering. Bone matrices of all skinned meshes are sub-allocated from a single shared GPU buffer (see <see cref="GetBoneMatrices"/>) and referenced by offset.
 /// </summary>
 class FLAXENGINE_API SkinnedMeshDrawData
 {
+    friend class SkinnedMeshBonesService;
 private:
     bool _hasValidData = false;
     bool _isDirty = false;
+    bool _isPending = false;
+    int32 _bonesOffset = -1;
+    int32 _prevBonesOffset = -1;
 
 public:
     /// <summary>
@@ -20,16 +24,6 @@ class FLAXENGINE_API SkinnedMeshDrawData
     /// </summary>
     int32 BonesCount = 0;
 
-    /// <summary>
-    /// The bone matrices buffer. Contains prepared skeletal bones transformations (stored as 4x3, 3 Vector4 behind each other).
-    /// </summary>
-    GPUBuffer* BoneMatrices = nullptr;
-
-    /// <summary>
-    /// The bone matrices buffer used during the previous update. Used by per-bone motion blur.
-    /// </summary>
-    GPUBuffer* PrevBoneMatrices = nullptr;
-
     /// <summary>
     /// The CPU data buffer with the bones transformations (ready to be flushed with the GPU).
     /// </summary>
@@ -48,13 +42,39 @@ class FLAXENGINE_API SkinnedMeshDrawData
 
 public:
     /// <summary>
-    /// Determines whether this instance is ready for rendering.
+    /// Gets the shared bone matrices buffer used by all skinned meshes. Contains prepared skeletal bones transformations (stored as 4x3, 3 Vector4 behind each other).
+    /// </summary>
+    static GPUBuffer* GetBoneMatrices();
+
+    /// <summary>
+    /// Gets the offset (in Vector4 elements) of the current bones data within the shared bone matrices buffer.
+    /// </summary>
+    FORCE_INLINE uint32 GetBoneMatricesOffset() const
+    {
+        return (uint32)_bonesOffset * 3;
+    }
+
+    /// <summary>
+    /// Gets the offset (in Vector4 elements) of the previous update bones data within the shared bone matrices buffer. Valid only if <see cref="HasPrevBoneMatrices"/> returns true.
     /// </summary>
-    FORCE_INLINE bool IsReady() const
+    FORCE_INLINE uint32 GetPrevBoneMatricesOffset() const
     {
-        return BoneMatrices != nullptr && BoneMatrices->IsAllocated();
+        return (uint32)_prevBonesOffset * 3;
     }
 
+    /// <summary>
+    /// Determines whether this instance has bone matrices data from the previous update. Used by per-bone motion blur.
+    /// </summary>
+    FORCE_INLINE bool HasPrevBoneMatrices() const
+    {
+        return _prevBonesOffset != -1;
+    }
+
+    /// <summary>
+    /// Determines whether this instance is ready for rendering.
+    /// </summary>
+    bool IsReady() const;
+
     /// <summary>
     /// Determines whether this instance has been modified and needs to be flushed with GPU buffer.
     /// </summary>
@@ -82,6 +102,11 @@ class FLAXENGINE_API SkinnedMeshDrawData
     /// <param name="dropHistory">True if drop previous update bones used for motion blur, otherwise will keep them and do the update.</param>
     void OnDataChanged(bool dropHistory);
 
+    /// <summary>
+    /// Uploads the modified bones data to the GPU. All skinned meshes updated before rendering are uploaded at once, so this is needed only for the data modified during rendering.
+    /// </summary>
+    void Flush();
+
     /// <summary>
     /// After bones Data has been send to the GPU buffer.
     /// </summary>
@@ -89,4 +114,7 @@ class FLAXENGINE_API SkinnedMeshDrawData
     {
         _isDirty = false;
     }
+
+private:
+    void Release();
 };
@@ -3,22 +3,61 @@
 #include "RenderTargetPool.h"
 #include "GPUDevice.h"
 #include "Engine/Core/Log.h"
+#include "Engine/Core/Collections/Dictionary.h"
 #include "Engine/Engine/Engine.h"
+#include "Engine/Platform/CriticalSection.h"
 #include "Engine/Profiler/ProfilerCPU.h"
+#include "Engine/Threading/Threading.h"
 
 struct Entry
 {
-    GPUTexture* RT;
+    // Description requested when creating the render target (device can adjust the actual texture description, eg. format).
+    GPUTextureDescription Desc;
     uint64 LastFrameReleased;
-    uint32 DescriptionHash;
+    uint64 MemoryUsage;
     bool IsOccupied;
 };
 
 namespace
 {
-    Array<Entry> TemporaryRTs;
+    CriticalSection Locker;
+    Dictionary<GPUTexture*, Entry> TemporaryRTs;
+    // Free render targets grouped by the requested description (ordered by release frame, the most recently released at the end)
+    Dictionary<GPUTextureDescription, Array<GPUTexture*>> FreeRTs;
+    uint64 MemoryUsage = 0;
+    uint64 StatsFrame = 0;
+    RenderTargetPool::Stats CurrentStats;
+    RenderTargetPool::Stats LastStats;
+#if GPU_ENABLE_RESOURCE_NAMING
+    int32 NamesCounter = 0;
+#endif
+
+    void UpdateStats()
+    {
+        const uint64 frame = Engine::FrameCount;
+        if (StatsFrame != frame)
+        {
+            StatsFrame = frame;
+            LastStats = CurrentStats;
+            CurrentStats = RenderTargetPool::Stats();
+            CurrentStats.PeakMemoryUsage = MemoryUsage;
+        }
+        CurrentStats.Count = TemporaryRTs.Count();
+        CurrentStats.MemoryUsage = MemoryUsage;
+        CurrentStats.PeakMemoryUsage = Math::Max(CurrentStats.PeakMemoryUsage, MemoryUsage);
+    }
+
+    void DeleteRT(GPUTexture* rt)
+    {
+        MemoryUsage -= TemporaryRTs[rt].MemoryUsage;
+        TemporaryRTs.Remove(rt);
+        rt->DeleteObjectNow();
+        CurrentStats.Evicted++;
+    }
 }
 
+uint64 RenderTargetPool::MemoryBudget = 0;
+
 void RenderTargetPool::Flush(bool force, int32 framesOffset)
 {
     PROFILE_CPU();
@@ -27,36 +66,66 @@ void RenderTargetPool::Flush(bool force, int32 framesOffset)
     const uint64 frameCount = Engine::FrameCount;
     const uint64 maxReleaseFrame = frameCount - Math::Min<uint64>(frameCount, framesOffset);
     force |= Engine::ShouldExit();
+    ScopeLock lock(Locker);
 
-    for (int32 i = 0; i < TemporaryRTs.Count(); i++)
+    // Release render targets unused for too long
+    for (auto i = FreeRTs.Begin(); i.IsNotEnd(); ++i)
     {
-        const auto& e = TemporaryRTs[i];
-        if (!e.IsOccupied && (force || e.LastFrameReleased < maxReleaseFrame))
+        auto& list = i->Value;
+        int32 count = 0;
+        while (count < list.Count() && (force || TemporaryRTs[list[count]].LastFrameReleased < maxReleaseFrame))
+            DeleteRT(list[count++]);
+        if (count == list.Count())
+            FreeRTs.Remove(i);
+        else if (count != 0)
         {
-            e.RT->DeleteObjectNow();
-            TemporaryRTs.RemoveAt(i--);
-            if (TemporaryRTs.IsEmpty())
-                break;
+            for (int32 j = count; j < list.Count(); j++)
+                list[j - count] = list[j];
+            list.Resize(list.Count() - count);
         }
     }
+
+    // Release the least recently used render targets to fit into the memory budget
+    while (MemoryBudget != 0 && MemoryUsage > MemoryBudget && FreeRTs.HasItems())
+    {
+        auto oldest = FreeRTs.Begin();
+        uint64 oldestFrame = MAX_uint64;
+        for (auto i = FreeRTs.Begin(); i.IsNotEnd(); ++i)
+        {
+            const uint64 frame = TemporaryRTs[i->Value[0]].LastFrameReleased;
+            if (frame < oldestFrame)
+            {
+                oldestFrame = frame;
+                oldest = i;
+            }
+        }
+        auto& list = oldest->Value;
+        DeleteRT(list[0]);
+        if (list.Count() == 1)
+            FreeRTs.Remove(oldest);
+        else
+            list.RemoveAtKeepOrder(0);
+    }
+
+    UpdateStats();
 }
 
 GPUTexture* RenderTargetPool::Get(const GPUTextureDescription& desc)
 {
     PROFILE_CPU();
+    ScopeLock lock(Locker);
+    UpdateStats();
 
-    // Find free render target with the same properties
-    const uint32 descHash = GetHash(desc);
-    for (int32 i = 0; i < TemporaryRTs.Count(); i++)
+    // Reuse the most recently released render target with the same properties
+    auto* list = FreeRTs.TryGet(desc);
+    if (list && list->HasItems())
     {
-        auto& e = TemporaryRTs[i];
-        if (!e.IsOccupied && e.DescriptionHash == descHash)
-        {
-            // Mark as used
-            e.IsOccupied = true;
-            return e.RT;
-        }
+        GPUTexture* rt = list->Pop();
+        TemporaryRTs[rt].IsOccupied = true;
+        CurrentStats.Hits++;
+        return rt;
     }
+    CurrentStats.Misses++;
 #if !BUILD_RELEASE
     if (TemporaryRTs.Count() > 2000)
     {
@@ -66,7 +135,11 @@ GPUTexture* RenderTargetPool::Get(const GPUTextureDescription& desc)
 #endif
 
     // Create new rt
-    const String name = TEXT("TemporaryRT_") + StringUtils::ToString(TemporaryRTs.Count());
+#if GPU_ENABLE_RESOURCE_NAMING
+    const String name = String::Format(TEXT("TemporaryRT_{0}"), NamesCounter++);
+#else
+    const StringView name;
+#endif
     GPUTexture* rt = GPUDevice::Instance->CreateTexture(name);
     if (rt->Init(desc))
     {
@@ -77,11 +150,13 @@ GPUTexture* RenderTargetPool::Get(const GPUTextureDescription& desc)
 
     // Create temporary rt entry
     Entry e;
+    e.Desc = desc;
     e.IsOccupied = true;
     e.LastFrameReleased = 0;
-    e.RT = rt;
-    e.DescriptionHash = descHash;
-    TemporaryRTs.Add(e);
+    e.MemoryUsage = rt->GetMemoryUsage();
+    TemporaryRTs.Add(rt, e);
+    MemoryUsage += e.MemoryUsage;
+    UpdateStats();
 
     return rt;
 }
@@ -90,17 +165,23 @@ void RenderTargetPool::Release(GPUTexture* rt)
 {
     if (!rt)
         return;
-    for (int32 i = 0; i < TemporaryRTs.Count(); i++)
+    ScopeLock lock(Locker);
+    Entry* e = TemporaryRTs.TryGet(rt);
+    if (e)
     {
-        auto& e = TemporaryRTs[i];
-        if (e.RT == rt)
-        {
-            // Mark as free
-            ASSERT(e.IsOccupied);
-            e.IsOccupied = false;
-            e.LastFrameReleased = Engine::FrameCount;
-            return;
-        }
+        // Mark as free
+        ASSERT(e->IsOccupied);
+        e->IsOccupied = false;
+        e->LastFrameReleased = Engine::FrameCount;
+        FreeRTs[e->Desc].Add(rt);
+        return;
     }
     LOG(Error, "Trying to release temporary render target which has not been registered in service!");
 }
+
+RenderTargetPool::Stats RenderTargetPool::GetStats()
+{
+    ScopeLock lock(Locker);
+    UpdateStats();
+    return LastStats;
+}
@@ -10,6 +10,50 @@
 API_CLASS(Static) class FLAXENGINE_API RenderTargetPool
 {
     DECLARE_SCRIPTING_TYPE_NO_SPAWN(RenderTargetPool);
+public:
+    /// <summary>
+    /// The render targets pool usage statistics (per-frame).
+    /// </summary>
+    API_STRUCT(NoDefault) struct Stats
+    {
+        DECLARE_SCRIPTING_TYPE_MINIMAL(Stats);
+
+        /// <summary>
+        /// The amount of render target requests that reused the pooled resource.
+        /// </summary>
+        API_FIELD() int32 Hits = 0;
+
+        /// <summary>
+        /// The amount of render target requests that allocated a new resource.
+        /// </summary>
+        API_FIELD() int32 Misses = 0;
+
+        /// <summary>
+        /// The amount of render targets in the pool (both used and free).
+        /// </summary>
+        API_FIELD() int32 Count = 0;
+
+        /// <summary>
+        /// The amount of render targets evicted from the pool (unused for too long or due to memory budget).
+        /// </summary>
+        API_FIELD() int32 Evicted = 0;
+
+        /// <summary>
+        /// The GPU memory used by the pooled render targets (in bytes).
+        /// </summary>
+        API_FIELD() uint64 MemoryUsage = 0;
+
+        /// <summary>
+        /// The peak GPU memory used by the pooled render targets during the frame (in bytes).
+        /// </summary>
+        API_FIELD() uint64 PeakMemoryUsage = 0;
+    };
+
+    /// <summary>
+    /// The GPU memory budget (in bytes) for the pooled render targets. When exceeded, the least recently used free render targets get released on flush. Use 0 to disable the limit.
+    /// </summary>
+    API_FIELD() static uint64 MemoryBudget;
+
 public:
     /// <summary>
     /// Flushes the temporary render targets.
@@ -30,6 +74,11 @@ API_CLASS(Static) class FLAXENGINE_API RenderTargetPool
     /// </summary>
     /// <param name="rt">The reference to temporary target to release.</param>
     API_FUNCTION() static void Release(GPUTexture* rt);
+
+    /// <summary>
+    /// Gets the pool usage statistics from the last frame.
+    /// </summary>
+    API_FUNCTION() static Stats GetStats();
 };
 
 // Utility to set name to the pooled render target (compiled-put in Release builds)
@@ -127,6 +127,11 @@ API_STRUCT(NoDefault) struct FLAXENGINE_API RenderView
     /// </summary>
     API_FIELD() StaticFlags StaticFlagsMask = StaticFlags::None;
 
+    /// <summary>
+    /// If checked, StaticFlagsMask hides objects that have any of the given static flags instead. Eg. used by cached shadow maps to draw only dynamic objects on top of the cached static objects.
+    /// </summary>
+    API_FIELD() bool StaticFlagsMaskInverted = false;
+
     /// <summary>
     /// The view flags.
     /// </summary>
@@ -330,6 +335,14 @@ API_STRUCT(NoDefault) struct FLAXENGINE_API RenderView
         }
     }
 
+    /// <summary>
+    /// Checks if object with the given static flags passes the view static flags mask (see StaticFlagsMask and StaticFlagsMaskInverted).
+    /// </summary>
+    FORCE_INLINE bool CanDrawStaticFlags(StaticFlags staticFlags) const
+    {
+        return StaticFlagsMask == StaticFlags::None || ((staticFlags & StaticFlagsMask) != StaticFlags::None) != StaticFlagsMaskInverted;
+    }
+
 public:
     // Camera's View * Projection matrix
     FORCE_INLINE const Matrix& ViewProjection() const
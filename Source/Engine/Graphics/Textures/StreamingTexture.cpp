@@ -333,6 +333,12 @@ class StreamTextureMipTask : public GPUUploadTextureMipTask
     {
         _streamingTexture->_streamingTasks.Add(this);
         _texture.Released.Bind<StreamTextureMipTask, &StreamTextureMipTask::OnResourceReleased2>(this);
+
+        // Estimate the upload size (mip data is loaded later)
+        uint32 rowPitch, slicePitch;
+        const auto gpuTexture = texture->GetTexture();
+        gpuTexture->ComputePitch(mipIndex, rowPitch, slicePitch);
+        SetCost((uint64)slicePitch * gpuTexture->ArraySize());
     }
 
 private:
@@ -442,9 +448,12 @@ Task* StreamingTexture::CreateStreamingTask(int32 residency)
                     result = task;
             }
 
-            // Add upload data task
+            // Add upload data task (texture without any mips loaded cannot be used so upload its first mip before the other tasks)
             const int32 allocatedMipIndex = TotalIndexToTextureMipIndex(mipIndex);
-            task = New<StreamTextureMipTask>(this, allocatedMipIndex);
+            auto mipTask = New<StreamTextureMipTask>(this, allocatedMipIndex);
+            if (mipIndex == startMipIndex && _texture->ResidentMipLevels() == 0)
+                mipTask->SetPriority(GPUTask::Priority::High);
+            task = mipTask;
             if (result)
                 result->ContinueWith(task);
             else
@@ -33,8 +33,6 @@
 #define CHECK_EXECUTE_IN_EDITOR
 #endif
 
-#define ACTOR_ORIENTATION_EPSILON 0.000000001f
-
 namespace
 {
     Actor* GetChildByPrefabObjectId(Actor* a, const Guid& prefabObjectId)
@@ -11,6 +11,9 @@
 #include "Engine/Scripting/ScriptingObject.h"
 #include "Types.h"
 
+// Epsilon used to detect actor orientation changes (when setting transform).
+#define ACTOR_ORIENTATION_EPSILON 0.000000001f
+
 struct RenderView;
 struct RenderContext;
 struct RenderContextBatch;
@@ -3,6 +3,7 @@
 #include "AnimatedModel.h"
 #include "BoneSocket.h"
 #include "Engine/Core/Math/Matrix3x4.h"
+#include "Engine/Core/SIMD.h"
 #include "Engine/Threading/Threading.h"
 #include "Engine/Animations/Animations.h"
 #include "Engine/Engine/Engine.h"
@@ -41,6 +42,8 @@ AnimatedModel::~AnimatedModel()
 {
     if (_deformation)
         Delete(_deformation);
+    for (BoneSocket* socket : _sockets)
+        socket->_model = nullptr;
 }
 
 void AnimatedModel::ResetAnimation()
@@ -107,6 +110,22 @@ void AnimatedModel::PreInitSkinningData()
     GraphInstance.Invalidate();
     GraphInstance.RootTransform = skeleton.Nodes[0].LocalTransform;
 
+    // Calculate how far the mesh extends beyond the skeleton bones in the bind pose (used to estimate bounds of the animated pose)
+    if (bonesCount != 0)
+    {
+        BoundingBox bonesBox(GraphInstance.NodesPose[skeleton.Bones[0].NodeIndex].GetTranslation());
+        for (int32 boneIndex = 1; boneIndex < bonesCount; boneIndex++)
+            bonesBox.Merge(GraphInstance.NodesPose[skeleton.Bones[boneIndex].NodeIndex].GetTranslation());
+        const BoundingBox modelBox = SkinnedModel->GetBox();
+        _bonesBoundsMin = Float3(Vector3::Max(bonesBox.Minimum - modelBox.Minimum, Vector3::Zero));
+        _bonesBoundsMax = Float3(Vector3::Max(modelBox.Maximum - bonesBox.Maximum, Vector3::Zero));
+    }
+    else
+    {
+        _bonesBoundsMin = _bonesBoundsMax = Float3::Zero;
+    }
+    _hasPoseBounds = false;
+
     // Setup bones transformations including bone offset matrix
     Array<Matrix> identityMatrices; // TODO: use shared memory?
     identityMatrices.Resize(bonesCount, false);
@@ -346,7 +365,7 @@ void AnimatedModel::SetBlendShapeWeight(const StringView& name, float value)
     const bool isZero = Math::IsZero(value);
     if (!_deformation && !isZero)
         _deformation = New<MeshDeformation>();
-    Function<void(const MeshBase*, MeshDeformationData&)> deformer;
+    Function<void(const MeshBase*, MeshDeformationData&, MeshDeformationSpan&)> deformer;
     deformer.Bind<AnimatedModel, &AnimatedModel::RunBlendShapeDeformer>(this);
     for (int32 i = 0; i < _blendShapeWeights.Count(); i++)
     {
@@ -374,7 +393,7 @@ void AnimatedModel::SetBlendShapeWeight(const StringView& name, float value)
                                         blendShapeMesh.Usages--;
                                         if (blendShapeMesh.Usages == 0)
                                         {
-                                            _deformation->RemoveDeformer(blendShapeMesh.LODIndex, blendShapeMesh.MeshIndex, MeshBufferType::Vertex0, deformer);
+                                            _deformation->RemoveSpanDeformer(blendShapeMesh.LODIndex, blendShapeMesh.MeshIndex, MeshBufferType::Vertex0, deformer);
                                             _blendShapeMeshes.RemoveAt(j);
                                         }
                                         break;
@@ -442,7 +461,7 @@ void AnimatedModel::SetBlendShapeWeight(const StringView& name, float value)
                             blendShapeMesh.LODIndex = mesh.GetLODIndex();
                             blendShapeMesh.MeshIndex = mesh.GetIndex();
                             blendShapeMesh.Usages = 1;
-                            _deformation->AddDeformer(blendShapeMesh.LODIndex, blendShapeMesh.MeshIndex, MeshBufferType::Vertex0, deformer);
+                            _deformation->AddSpanDeformer(blendShapeMesh.LODIndex, blendShapeMesh.MeshIndex, MeshBufferType::Vertex0, deformer);
                         }
                         break;
                     }
@@ -456,10 +475,10 @@ void AnimatedModel::ClearBlendShapeWeights()
 {
     if (_deformation)
     {
-        Function<void(const MeshBase*, MeshDeformationData&)> deformer;
+        Function<void(const MeshBase*, MeshDeformationData&, MeshDeformationSpan&)> deformer;
         deformer.Bind<AnimatedModel, &AnimatedModel::RunBlendShapeDeformer>(this);
         for (auto e : _blendShapeMeshes)
-            _deformation->RemoveDeformer(e.LODIndex, e.MeshIndex, MeshBufferType::Vertex0, deformer);
+            _deformation->RemoveSpanDeformer(e.LODIndex, e.MeshIndex, MeshBufferType::Vertex0, deformer);
     }
     _blendShapeWeights.Clear();
     _blendShapeMeshes.Clear();
@@ -601,7 +620,7 @@ void AnimatedModel::SyncParameters()
     }
 }
 
-void AnimatedModel::RunBlendShapeDeformer(const MeshBase* mesh, MeshDeformationData& deformation)
+void AnimatedModel::RunBlendShapeDeformer(const MeshBase* mesh, MeshDeformationData& deformation, MeshDeformationSpan& span)
 {
     PROFILE_CPU_NAMED("BlendShapes");
     auto* skinnedMesh = (const SkinnedMesh*)mesh;
@@ -612,6 +631,8 @@ void AnimatedModel::RunBlendShapeDeformer(const MeshBase* mesh, MeshDeformationD
     Array<Pair<const BlendShape&, const float>, InlinedAllocation<32>> blendShapes;
     for (const BlendShape& blendShape : skinnedMesh->BlendShapes)
     {
+        if (blendShape.MaxVertexIndex < span.VertexStart || blendShape.MinVertexIndex > span.VertexEnd)
+            continue;
         for (auto& q : _blendShapeWeights)
         {
             if (q.First == blendShape.Name)
@@ -625,8 +646,12 @@ void AnimatedModel::RunBlendShapeDeformer(const MeshBase* mesh, MeshDeformationD
             }
         }
     }
+    minVertexIndex = Math::Max(minVertexIndex, span.VertexStart);
+    maxVertexIndex = Math::Min(maxVertexIndex, span.VertexEnd);
+    if (minVertexIndex > maxVertexIndex)
+        return;
 
-    // Blend all blend shapes
+    // Blend all blend shapes (only vertices within the span)
     auto vertexCount = (uint32)mesh->GetVertexCount();
     auto data = (VB0SkinnedElementType*)deformation.VertexBuffer.Data.Get();
     for (const auto& q : blendShapes)
@@ -638,6 +663,8 @@ void AnimatedModel::RunBlendShapeDeformer(const MeshBase* mesh, MeshDeformationD
             {
                 const BlendShapeVertex& blendShapeVertex = q.First.Vertices[i];
                 ASSERT_LOW_LAYER(blendShapeVertex.VertexIndex < vertexCount);
+                if (blendShapeVertex.VertexIndex < minVertexIndex || blendShapeVertex.VertexIndex > maxVertexIndex)
+                    continue;
                 VB0SkinnedElementType& vertex = *(data + blendShapeVertex.VertexIndex);
                 vertex.Position = vertex.Position + blendShapeVertex.PositionDelta * q.Second;
                 Float3 normal = (vertex.Normal.ToFloat3() * 2.0f - 1.0f) + blendShapeVertex.NormalDelta * q.Second;
@@ -650,6 +677,8 @@ void AnimatedModel::RunBlendShapeDeformer(const MeshBase* mesh, MeshDeformationD
             {
                 const BlendShapeVertex& blendShapeVertex = q.First.Vertices[i];
                 ASSERT_LOW_LAYER(blendShapeVertex.VertexIndex < vertexCount);
+                if (blendShapeVertex.VertexIndex < minVertexIndex || blendShapeVertex.VertexIndex > maxVertexIndex)
+                    continue;
                 VB0SkinnedElementType& vertex = *(data + blendShapeVertex.VertexIndex);
                 vertex.Position = vertex.Position + blendShapeVertex.PositionDelta * q.Second;
             }
@@ -678,8 +707,8 @@ void AnimatedModel::RunBlendShapeDeformer(const MeshBase* mesh, MeshDeformationD
     }
 
     // Mark as dirty to be cleared before next rendering
-    deformation.DirtyMinIndex = Math::Min(minVertexIndex, deformation.DirtyMinIndex);
-    deformation.DirtyMaxIndex = Math::Max(maxVertexIndex, deformation.DirtyMaxIndex);
+    span.DirtyMinIndex = Math::Min(minVertexIndex, span.DirtyMinIndex);
+    span.DirtyMaxIndex = Math::Max(maxVertexIndex, span.DirtyMaxIndex);
 }
 
 void AnimatedModel::BeginPlay(SceneBeginData* data)
@@ -724,33 +753,72 @@ void AnimatedModel::OnActiveInTreeChanged()
     ModelInstanceActor::OnActiveInTreeChanged();
 }
 
-void AnimatedModel::UpdateBounds()
+bool AnimatedModel::UpdatePoseBounds()
 {
     const auto model = SkinnedModel.Get();
-    if (CustomBounds.GetSize().LengthSquared() > 0.01f)
+    if (CustomBounds.GetSize().LengthSquared() > 0.01f || !model || !model->IsLoaded() || model->LODs.Count() == 0)
     {
-        BoundingBox::Transform(CustomBounds, _transform, _box);
+        const bool changed = _hasPoseBounds;
+        _hasPoseBounds = false;
+        return changed;
     }
-    else if (model && model->IsLoaded() && model->LODs.Count() != 0)
+
+    // Use the model bind pose bounds if pose is not ready
+    const BoundingBox modelBox = model->GetBox();
+    const Vector3 modelBoxSize = modelBox.GetSize();
+    BoundingBox box = modelBox;
+    const auto& skeleton = model->Skeleton;
+    const int32 bonesCount = skeleton.Bones.Count();
+    if (bonesCount != 0 && GraphInstance.NodesPose.Count() == skeleton.Nodes.Count())
     {
-        Matrix world;
-        GetLocalToWorldMatrix(world);
-        const BoundingBox modelBox = model->GetBox(world);
-        BoundingBox box = modelBox;
-        if (GraphInstance.NodesPose.Count() != 0)
+        // Reduce bones positions into the box and extend it by the mesh volume around the bones
+        const Matrix* nodesPose = GraphInstance.NodesPose.Get();
+        const SkeletonBone* bones = skeleton.Bones.Get();
+        SimdVector4 min = SIMD::Splat(MAX_float), max = SIMD::Splat(MIN_float);
+        for (int32 boneIndex = 0; boneIndex < bonesCount; boneIndex++)
         {
-            // Per-bone bounds estimated from positions
-            auto& skeleton = model->Skeleton;
-            const int32 bonesCount = skeleton.Bones.Count();
-            for (int32 boneIndex = 0; boneIndex < bonesCount; boneIndex++)
-                box.Merge(_transform.LocalToWorld(GraphInstance.NodesPose[skeleton.Bones.Get()[boneIndex].NodeIndex].GetTranslation()));
+            const Matrix& node = nodesPose[bones[boneIndex].NodeIndex];
+            const SimdVector4 position = SIMD::Load(node.M41, node.M42, node.M43, 0.0f);
+            min = SIMD::Min(min, position);
+            max = SIMD::Max(max, position);
         }
+        ALIGN_BEGIN(16) float values[8] ALIGN_END(16);
+        SIMD::Store(values, SIMD::Sub(min, SIMD::Load(_bonesBoundsMin.X, _bonesBoundsMin.Y, _bonesBoundsMin.Z, 0.0f)));
+        SIMD::Store(values + 4, SIMD::Add(max, SIMD::Load(_bonesBoundsMax.X, _bonesBoundsMax.Y, _bonesBoundsMax.Z, 0.0f)));
+        box = BoundingBox(Vector3(values[0], values[1], values[2]), Vector3(values[4], values[5], values[6]));
 
-        // Apply margin based on model dimensions
-        const Vector3 modelBoxSize = modelBox.GetSize();
+        // Ensure bounds are not smaller than the model
         const Vector3 center = box.GetCenter();
-        const Vector3 sizeHalf = Vector3::Max(box.GetSize() + modelBoxSize * 0.2f, modelBoxSize) * 0.5f;
-        _box = BoundingBox(center - sizeHalf, center + sizeHalf);
+        const Vector3 sizeHalf = Vector3::Max(box.GetSize(), modelBoxSize) * 0.5f;
+        box = BoundingBox(center - sizeHalf, center + sizeHalf);
+    }
+
+    // Skip update when pose still fits into the cached bounds and they are not too loose
+    const Vector3 margin = modelBoxSize * 0.1f;
+    if (_hasPoseBounds && _poseBounds.Contains(box) == ContainmentType::Contains)
+    {
+        const Vector3 slack = _poseBounds.GetSize() - box.GetSize();
+        if (slack.X <= margin.X * 4 && slack.Y <= margin.Y * 4 && slack.Z <= margin.Z * 4)
+            return false;
+    }
+
+    // Apply margin based on model dimensions
+    _poseBounds = BoundingBox(box.Minimum - margin, box.Maximum + margin);
+    _hasPoseBounds = true;
+    return true;
+}
+
+void AnimatedModel::UpdateWorldBounds()
+{
+    if (CustomBounds.GetSize().LengthSquared() > 0.01f)
+    {
+        BoundingBox::Transform(CustomBounds, _transform, _box);
+    }
+    else if (_hasPoseBounds)
+    {
+        Matrix world;
+        GetLocalToWorldMatrix(world);
+        BoundingBox::Transform(_poseBounds, world, _box);
     }
     else
     {
@@ -761,14 +829,16 @@ void AnimatedModel::UpdateBounds()
         GetSceneRendering()->UpdateActor(this, _sceneRenderingKey);
 }
 
+void AnimatedModel::UpdateBounds()
+{
+    UpdatePoseBounds();
+    UpdateWorldBounds();
+}
+
 void AnimatedModel::UpdateSockets()
 {
-    for (int32 i = 0; i < Children.Count(); i++)
-    {
-        auto socket = dynamic_cast<BoneSocket*>(Children[i]);
-        if (socket)
-            socket->UpdateTransformation();
-    }
+    for (BoneSocket* socket : _sockets)
+        socket->UpdateTransformation();
 }
 
 void AnimatedModel::OnAnimationUpdated_Async()
@@ -804,7 +874,9 @@ void AnimatedModel::OnAnimationUpdated_Async()
         _skinningData.OnDataChanged(!PerBoneMotionBlur);
     }
 
-    UpdateBounds();
+    // Update bounds only if the pose moved outside the cached bounds
+    if (UpdatePoseBounds())
+        UpdateWorldBounds();
 }
 
 void AnimatedModel::OnAnimationUpdated_Sync()
@@ -831,6 +903,8 @@ void AnimatedModel::OnAnimationUpdated()
 void AnimatedModel::OnSkinnedModelChanged()
 {
     Entries.Release();
+    _bonesBoundsMin = _bonesBoundsMax = Float3::Zero;
+    _hasPoseBounds = false;
     if (SkinnedModel && !SkinnedModel->IsLoaded())
     {
         UpdateBounds();
@@ -924,11 +998,7 @@ void AnimatedModel::Draw(RenderContext& renderContext)
     {
         // Flush skinning data with GPU
         if (_skinningData.IsDirty())
-        {
-            RenderContext::GPULocker.Lock();
-            GPUDevice::Instance->GetMainContext()->UpdateBuffer(_skinningData.BoneMatrices, _skinningData.Data.Get(), _skinningData.Data.Count());
-            RenderContext::GPULocker.Unlock();
-        }
+            _skinningData.Flush();
 
         SkinnedMesh::DrawInfo draw;
         draw.Buffer = &Entries;
@@ -967,11 +1037,7 @@ void AnimatedModel::Draw(RenderContextBatch& renderContextBatch)
     {
         // Flush skinning data with GPU
         if (_skinningData.IsDirty())
-        {
-            RenderContext::GPULocker.Lock();
-            GPUDevice::Instance->GetMainContext()->UpdateBuffer(_skinningData.BoneMatrices, _skinningData.Data.Get(), _skinningData.Data.Count());
-            RenderContext::GPULocker.Unlock();
-        }
+            _skinningData.Flush();
 
         SkinnedMesh::DrawInfo draw;
         draw.Buffer = &Entries;
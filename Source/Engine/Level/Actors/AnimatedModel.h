@@ -17,6 +17,7 @@ class FLAXENGINE_API AnimatedModel : public ModelInstanceActor
 {
     DECLARE_SCENE_OBJECT(AnimatedModel);
     friend class AnimationsSystem;
+    friend class BoneSocket;
 
     /// <summary>
     /// Describes the animation graph updates frequency for the animated model.
@@ -73,6 +74,11 @@ class FLAXENGINE_API AnimatedModel : public ModelInstanceActor
     ScriptingObjectReference<AnimatedModel> _masterPose;
     Array<Pair<String, float>> _blendShapeWeights;
     Array<BlendShapeMesh> _blendShapeMeshes;
+    Float3 _bonesBoundsMin = Float3::Zero;
+    Float3 _bonesBoundsMax = Float3::Zero;
+    BoundingBox _poseBounds = BoundingBox::Zero;
+    bool _hasPoseBounds = false;
+    Array<BoneSocket*> _sockets;
 
 public:
     ~AnimatedModel();
@@ -402,9 +408,11 @@ class FLAXENGINE_API AnimatedModel : public ModelInstanceActor
 private:
     void ApplyRootMotion(const Transform& rootMotionDelta);
     void SyncParameters();
-    void RunBlendShapeDeformer(const MeshBase* mesh, struct MeshDeformationData& deformation);
+    void RunBlendShapeDeformer(const MeshBase* mesh, struct MeshDeformationData& deformation, struct MeshDeformationSpan& span);
 
     void Update();
+    bool UpdatePoseBounds();
+    void UpdateWorldBounds();
     void UpdateSockets();
     void OnAnimationUpdated_Async();
     void OnAnimationUpdated_Sync();
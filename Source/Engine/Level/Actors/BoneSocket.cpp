@@ -56,6 +56,18 @@ void BoneSocket::UpdateTransformation()
     }
 }
 
+void BoneSocket::SetModel(AnimatedModel* model)
+{
+    // Register in the parent model to be updated with its pose
+    if (_model == model)
+        return;
+    if (_model)
+        _model->_sockets.Remove(this);
+    _model = model;
+    if (model)
+        model->_sockets.Add(this);
+}
+
 #if USE_EDITOR
 
 #include "Engine/Debug/DebugDraw.h"
@@ -91,6 +103,22 @@ void BoneSocket::Deserialize(DeserializeStream& stream, ISerializeModifier* modi
     DESERIALIZE_MEMBER(UseScale, _useScale);
 }
 
+void BoneSocket::BeginPlay(SceneBeginData* data)
+{
+    // Base
+    Actor::BeginPlay(data);
+
+    SetModel(dynamic_cast<AnimatedModel*>(GetParent()));
+}
+
+void BoneSocket::EndPlay()
+{
+    SetModel(nullptr);
+
+    // Base
+    Actor::EndPlay();
+}
+
 void BoneSocket::OnTransformChanged()
 {
     // Base
@@ -108,6 +136,7 @@ void BoneSocket::OnParentChanged()
     if (!IsDuringPlay())
         return;
 
+    SetModel(dynamic_cast<AnimatedModel*>(GetParent()));
     _index = -1;
     UpdateTransformation();
 }
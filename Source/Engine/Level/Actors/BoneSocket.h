@@ -11,10 +11,12 @@ API_CLASS(Attributes="ActorContextMenu(\"New/Other/Bone Socket\"), ActorToolbox(
 class FLAXENGINE_API BoneSocket : public Actor
 {
     DECLARE_SCENE_OBJECT(BoneSocket);
+    friend class AnimatedModel;
 private:
     String _node;
     int32 _index;
     bool _useScale;
+    AnimatedModel* _model = nullptr;
 
 public:
     /// <summary>
@@ -54,6 +56,9 @@ class FLAXENGINE_API BoneSocket : public Actor
     API_FUNCTION()
     void UpdateTransformation();
 
+private:
+    void SetModel(AnimatedModel* model);
+
 public:
     // [Actor]
 #if USE_EDITOR
@@ -64,6 +69,8 @@ class FLAXENGINE_API BoneSocket : public Actor
 
 protected:
     // [Actor]
+    void BeginPlay(SceneBeginData* data) override;
+    void EndPlay() override;
     void OnTransformChanged() override;
     void OnParentChanged() override;
 };
@@ -226,8 +226,8 @@ void StaticModel::OnModelChanged()
 {
     if (_residencyChangedModel)
     {
+        _residencyChangedModel->ResidencyChanged.Unbind<StaticModel, &StaticModel::OnModelResidencyChanged>(this);
         _residencyChangedModel = nullptr;
-        Model->ResidencyChanged.Unbind<StaticModel, &StaticModel::OnModelResidencyChanged>(this);
     }
     RemoveVertexColors();
     Entries.Release();
@@ -243,28 +243,29 @@ void StaticModel::OnModelLoaded()
 {
     Entries.SetupIfInvalid(Model);
     UpdateBounds();
-    if (_sceneRenderingKey == -1 && _scene && _isActiveInHierarchy && _isEnabled && !_residencyChangedModel)
+    if (_scene && _isActiveInHierarchy && _isEnabled && !_residencyChangedModel)
     {
-        // Register for rendering but once the model has any LOD loaded
-        if (Model->GetLoadedLODs() == 0)
-        {
-            _residencyChangedModel = Model;
-            _residencyChangedModel->ResidencyChanged.Bind<StaticModel, &StaticModel::OnModelResidencyChanged>(this);
-        }
-        else
-        {
+        // Register for rendering but once the model has any LOD loaded (residency changes are tracked to update the scene rendering when LODs get streamed)
+        _residencyChangedModel = Model;
+        _residencyChangedModel->ResidencyChanged.Bind<StaticModel, &StaticModel::OnModelResidencyChanged>(this);
+        if (_sceneRenderingKey == -1 && Model->GetLoadedLODs() != 0)
             GetSceneRendering()->AddActor(this, _sceneRenderingKey);
-        }
     }
 }
 
 void StaticModel::OnModelResidencyChanged()
 {
-    if (_sceneRenderingKey == -1 && _scene && Model && Model->GetLoadedLODs() > 0 && _residencyChangedModel)
+    if (!_scene || !Model || !_residencyChangedModel)
+        return;
+    if (_sceneRenderingKey == -1)
     {
-        GetSceneRendering()->AddActor(this, _sceneRenderingKey);
-        _residencyChangedModel->ResidencyChanged.Unbind<StaticModel, &StaticModel::OnModelResidencyChanged>(this);
-        _residencyChangedModel = nullptr;
+        if (Model->GetLoadedLODs() > 0)
+            GetSceneRendering()->AddActor(this, _sceneRenderingKey);
+    }
+    else
+    {
+        // Notify scene rendering listeners that the drawn geometry has changed (eg. invalidate cached shadow maps)
+        GetSceneRendering()->UpdateActor(this, _sceneRenderingKey);
     }
 }
 
@@ -643,16 +644,11 @@ void StaticModel::OnEnable()
     // If model is set and loaded but we still don't have residency registered do it here (eg. model is streaming LODs right now)
     if (_scene && _sceneRenderingKey == -1 && !_residencyChangedModel && Model && Model->IsLoaded())
     {
-        // Register for rendering but once the model has any LOD loaded
-        if (Model->GetLoadedLODs() == 0)
-        {
-            _residencyChangedModel = Model;
-            _residencyChangedModel->ResidencyChanged.Bind<StaticModel, &StaticModel::OnModelResidencyChanged>(this);
-        }
-        else
-        {
+        // Register for rendering but once the model has any LOD loaded (residency changes are tracked to update the scene rendering when LODs get streamed)
+        _residencyChangedModel = Model;
+        _residencyChangedModel->ResidencyChanged.Bind<StaticModel, &StaticModel::OnModelResidencyChanged>(this);
+        if (Model->GetLoadedLODs() != 0)
             GetSceneRendering()->AddActor(this, _sceneRenderingKey);
-        }
     }
 
     // Skip ModelInstanceActor (add to SceneRendering manually)
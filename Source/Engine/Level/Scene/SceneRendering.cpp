@@ -65,8 +65,15 @@ void SceneRendering::Draw(RenderContextBatch& renderContextBatch, DrawCategory c
     // Setup frustum data
     const int32 frustumsCount = renderContextBatch.Contexts.Count();
     _drawFrustumsData.Resize(frustumsCount);
+    _drawStaticFrustumsData.Clear();
     for (int32 i = 0; i < frustumsCount; i++)
-        _drawFrustumsData.Get()[i] = renderContextBatch.Contexts.Get()[i].View.CullingFrustum;
+    {
+        const RenderView& contextView = renderContextBatch.Contexts.Get()[i].View;
+        _drawFrustumsData.Get()[i] = contextView.CullingFrustum;
+        if (contextView.CanDrawStaticFlags(StaticFlags::Transform))
+            _drawStaticFrustumsData.Add(contextView.CullingFrustum);
+    }
+    _drawStaticFiltered = _drawStaticFrustumsData.Count() != frustumsCount && !view.IsOfflinePass;
 
     // Draw all visual components
     _drawListIndex = -1;
@@ -162,12 +169,66 @@ void SceneRendering::AddActor(Actor* a, int32& key)
         listener->OnSceneRenderingAddActor(a);
 }
 
+namespace
+{
+    struct UpdateActorBatchEntry
+    {
+        SceneRendering* Scene;
+        Actor* Actor;
+        int32 Key;
+    };
+
+    volatile int64 UpdateBatchThreadID = 0;
+    Array<UpdateActorBatchEntry> UpdateBatch;
+}
+
 void SceneRendering::UpdateActor(Actor* a, int32& key)
 {
-    const int32 category = a->_drawCategory;
+    const int64 batchThreadID = Platform::AtomicRead(&UpdateBatchThreadID);
+    if (batchThreadID != 0 && batchThreadID == (int64)Platform::GetCurrentThreadID())
+    {
+        // Defer update until the end of the batch
+        UpdateBatch.Add({ this, a, key });
+        return;
+    }
     ScopeLock lock(Locker);
-    auto& list = Actors[category];
-    if (list.Count() <= key) // Ignore invalid key softly
+    updateActor(a, key);
+}
+
+void SceneRendering::BeginUpdateBatch()
+{
+    ASSERT(Platform::AtomicRead(&UpdateBatchThreadID) == 0);
+    Platform::AtomicStore(&UpdateBatchThreadID, (int64)Platform::GetCurrentThreadID());
+}
+
+void SceneRendering::EndUpdateBatch()
+{
+    Platform::AtomicStore(&UpdateBatchThreadID, 0);
+    if (UpdateBatch.IsEmpty())
+        return;
+    PROFILE_CPU();
+
+    // Apply changes with a single lock per scene (batch entries are mostly grouped by scene)
+    SceneRendering* scene = nullptr;
+    for (const UpdateActorBatchEntry& e : UpdateBatch)
+    {
+        if (e.Scene != scene)
+        {
+            if (scene)
+                scene->Locker.Unlock();
+            scene = e.Scene;
+            scene->Locker.Lock();
+        }
+        scene->updateActor(e.Actor, e.Key);
+    }
+    scene->Locker.Unlock();
+    UpdateBatch.Clear();
+}
+
+void SceneRendering::updateActor(Actor* a, int32 key)
+{
+    auto& list = Actors[a->_drawCategory];
+    if (key < 0 || list.Count() <= key) // Ignore invalid key softly
         return;
     auto& e = list[key];
     if (e.Actor == a)
@@ -200,6 +261,7 @@ void SceneRendering::RemoveActor(Actor* a, int32& key)
 
 #define FOR_EACH_BATCH_ACTOR const int64 count = _drawListSize; while (true) { const int64 index = Platform::InterlockedIncrement(&_drawListIndex); if (index >= count) break; auto e = _drawListData[index];
 #define CHECK_ACTOR ((view.RenderLayersMask.Mask & e.LayerMask) && (e.NoCulling || FrustumsListCull(e.Bounds, _drawFrustumsData)))
+#define CHECK_ACTOR_STATIC_FILTERED ((view.RenderLayersMask.Mask & e.LayerMask) && (e.NoCulling || FrustumsListCull(e.Bounds, EnumHasAnyFlags(e.Actor->GetStaticFlags(), StaticFlags::Transform) ? _drawStaticFrustumsData : _drawFrustumsData)))
 #define CHECK_ACTOR_SINGLE_FRUSTUM ((view.RenderLayersMask.Mask & e.LayerMask) && (e.NoCulling || view.CullingFrustum.Intersects(e.Bounds)))
 #if SCENE_RENDERING_USE_PROFILER_PER_ACTOR
 #define DRAW_ACTOR(mode) PROFILE_CPU_ACTOR(e.Actor); e.Actor->Draw(mode)
@@ -223,6 +285,17 @@ void SceneRendering::DrawActorsJob(int32)
             }
         }
     }
+    else if (_drawStaticFiltered)
+    {
+        // Some views skip static objects (eg. shadow map with cached static objects) so cull static actors only against the remaining views
+        FOR_EACH_BATCH_ACTOR
+            e.Bounds.Center -= view.Origin;
+            if (CHECK_ACTOR_STATIC_FILTERED)
+            {
+                DRAW_ACTOR(*_drawBatch);
+            }
+        }
+    }
     else if (view.Origin.IsZero() && _drawFrustumsData.Count() == 1)
     {
         // Fast path for no origin shifting with a single context
@@ -258,4 +331,5 @@ void SceneRendering::DrawActorsJob(int32)
 
 #undef FOR_EACH_BATCH_ACTOR
 #undef CHECK_ACTOR
+#undef CHECK_ACTOR_STATIC_FILTERED
 #undef DRAW_ACTOR
@@ -104,6 +104,8 @@ class FLAXENGINE_API SceneRendering
     friend ISceneRenderingListener;
     Array<ISceneRenderingListener*, InlinedAllocation<8>> _listeners;
 
+    void updateActor(Actor* a, int32 key);
+
 public:
     /// <summary>
     /// Draws the scene. Performs the optimized actors culling and draw calls submission for the current render pass (defined by the render view).
@@ -128,6 +130,16 @@ class FLAXENGINE_API SceneRendering
     void UpdateActor(Actor* a, int32& key);
     void RemoveActor(Actor* a, int32& key);
 
+    /// <summary>
+    /// Begins the batched actors update on the current thread. UpdateActor calls done by this thread are deferred until EndUpdateBatch which applies them with a single lock per scene (eg. used when syncing many actors after physics simulation).
+    /// </summary>
+    static void BeginUpdateBatch();
+
+    /// <summary>
+    /// Ends the batched actors update and applies the deferred changes.
+    /// </summary>
+    static void EndUpdateBatch();
+
     FORCE_INLINE void AddPostFxProvider(IPostFxSettingsProvider* obj)
     {
         PostFxProviders.Add(obj);
@@ -184,6 +196,8 @@ class FLAXENGINE_API SceneRendering
 
 private:
     Array<BoundingFrustum> _drawFrustumsData;
+    Array<BoundingFrustum> _drawStaticFrustumsData; // Frustums of the views that can draw static objects (StaticFlags::Transform), used only if any view filters them out (eg. shadow map with cached static objects)
+    bool _drawStaticFiltered = false;
     DrawActor* _drawListData;
     int64 _drawListSize;
     volatile int64 _drawListIndex;
@@ -441,7 +441,8 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
 
         auto& velocity = context.Data->Buffer->Layout->Attributes[node->Attributes[0]];
         auto& mass = context.Data->Buffer->Layout->Attributes[node->Attributes[1]];
-        byte* spriteSizePtr = useSpriteSize ? start + context.Data->Buffer->Layout->Attributes[node->Attributes[2]].Offset : nullptr;
+        auto& spriteSize = context.Data->Buffer->Layout->Attributes[node->Attributes[2]];
+        byte* spriteSizePtr = useSpriteSize ? start + spriteSize.Offset : nullptr;
 
         byte* velocityPtr = start + velocity.Offset;
         byte* massPtr = start + mass.Offset;
@@ -451,7 +452,7 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
 #define LOGIC() \
 	float particleDrag = drag; \
     if (useSpriteSize) \
-        particleDrag *= ((Float2*)spriteSizePtr)->MulValues(); \
+        particleDrag *= spriteSize.Read<Float2>(spriteSizePtr).MulValues(); \
     *((Float3*)velocityPtr) *= Math::Max(0.0f, 1.0f - (particleDrag * context.DeltaTime) / Math::Max(*(float*)massPtr, ZeroTolerance)); \
     velocityPtr += stride; \
     massPtr += stride; \
@@ -555,16 +556,19 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
             {
                 context.ParticleIndex = particleIndex;
                 value = GetValue(box, 4).Cast(type);
-                Platform::MemoryCopy(dataPtr, &value.AsPointer, dataSize);
+                attribute.Store(dataPtr, &value.AsPointer);
                 dataPtr += stride;
             }
         }
         else
         {
+            // Encode value once and copy it to all particles
             const Value value = GetValue(box, 4).Cast(type);
+            byte data[16] = {};
+            attribute.Store(data, &value.AsPointer);
             for (int32 particleIndex = particlesStart; particleIndex < particlesEnd; particleIndex++)
             {
-                Platform::MemoryCopy(dataPtr, &value.AsPointer, dataSize);
+                Platform::MemoryCopy(dataPtr, data, dataSize);
                 dataPtr += stride;
             }
         }
@@ -613,16 +617,19 @@ void ParticleEmitterGraphCPUExecutor::ProcessModule(ParticleEmitterGraphCPUNode*
             {
                 context.ParticleIndex = particleIndex;
                 value = GetValue(box, 2).Cast(type);
-                Platform::MemoryCopy(dataPtr, &value.AsPointer, dataSize);
+                attribute.Store(dataPtr, &value.AsPointer);
                 dataPtr += stride;
             }
         }
         else
         {
+            // Encode value once and copy it to all particles
             const Value value = GetValue(box, 2).Cast(type);
+            byte data[16] = {};
+            attribute.Store(data, &value.AsPointer);
             for (int32 particleIndex = particlesStart; particleIndex < particlesEnd; particleIndex++)
             {
-                Platform::MemoryCopy(dataPtr, &value.AsPointer, dataSize);
+                Platform::MemoryCopy(dataPtr, data, dataSize);
                 dataPtr += stride;
             }
         }
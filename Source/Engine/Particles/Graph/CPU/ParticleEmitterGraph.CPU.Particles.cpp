@@ -7,8 +7,9 @@
 #include "Engine/Graphics/RenderTask.h"
 
 #define GET_VIEW() auto mainViewTask = MainRenderTask::Instance && MainRenderTask::Instance->LastUsedFrame != 0 ? MainRenderTask::Instance : nullptr
-#define ACCESS_PARTICLE_ATTRIBUTE(index) (context.Data->Buffer->GetParticleCPU(context.ParticleIndex) + context.Data->Buffer->Layout->Attributes[context.AttributesRemappingTable[node->Attributes[index]]].Offset)
-#define GET_PARTICLE_ATTRIBUTE(index, type) *(type*)ACCESS_PARTICLE_ATTRIBUTE(index)
+#define PARTICLE_ATTRIBUTE(index) context.Data->Buffer->Layout->Attributes[context.AttributesRemappingTable[node->Attributes[index]]]
+#define ACCESS_PARTICLE_ATTRIBUTE(index) (context.Data->Buffer->GetParticleCPU(context.ParticleIndex) + PARTICLE_ATTRIBUTE(index).Offset)
+#define GET_PARTICLE_ATTRIBUTE(index, type) PARTICLE_ATTRIBUTE(index).Read<type>(ACCESS_PARTICLE_ATTRIBUTE(index))
 
 void ParticleEmitterGraphCPUExecutor::ProcessGroupParameters(Box* box, Node* node, Value& value)
 {
@@ -209,20 +210,21 @@ void ParticleEmitterGraphCPUExecutor::ProcessGroupParticles(Box* box, Node* node
     // Particle Attribute
     case 100:
     {
+        const ParticleAttribute& attribute = PARTICLE_ATTRIBUTE(0);
         byte* ptr = ACCESS_PARTICLE_ATTRIBUTE(0);
         switch ((ParticleAttribute::ValueTypes)node->Attributes[1])
         {
         case ParticleAttribute::ValueTypes::Float:
-            value = *(float*)ptr;
+            value = attribute.Read<float>(ptr);
             break;
         case ParticleAttribute::ValueTypes::Float2:
-            value = *(Float2*)ptr;
+            value = attribute.Read<Float2>(ptr);
             break;
         case ParticleAttribute::ValueTypes::Float3:
-            value = *(Float3*)ptr;
+            value = attribute.Read<Float3>(ptr);
             break;
         case ParticleAttribute::ValueTypes::Float4:
-            value = *(Float4*)ptr;
+            value = attribute.Read<Float4>(ptr);
             break;
         case ParticleAttribute::ValueTypes::Int:
             value = *(int32*)ptr;
@@ -238,20 +240,21 @@ void ParticleEmitterGraphCPUExecutor::ProcessGroupParticles(Box* box, Node* node
     case 303:
     {
         const auto particleIndex = tryGetValue(node->GetBox(1), context.ParticleIndex);
-        byte* ptr = (context.Data->Buffer->GetParticleCPU((uint32)particleIndex) + context.Data->Buffer->Layout->Attributes[node->Attributes[0]].Offset);
+        const ParticleAttribute& attribute = context.Data->Buffer->Layout->Attributes[node->Attributes[0]];
+        byte* ptr = context.Data->Buffer->GetParticleCPU((uint32)particleIndex) + attribute.Offset;
         switch ((ParticleAttribute::ValueTypes)node->Attributes[1])
         {
         case ParticleAttribute::ValueTypes::Float:
-            value = *(float*)ptr;
+            value = attribute.Read<float>(ptr);
             break;
         case ParticleAttribute::ValueTypes::Float2:
-            value = *(Float2*)ptr;
+            value = attribute.Read<Float2>(ptr);
             break;
         case ParticleAttribute::ValueTypes::Float3:
-            value = *(Float3*)ptr;
+            value = attribute.Read<Float3>(ptr);
             break;
         case ParticleAttribute::ValueTypes::Float4:
-            value = *(Float4*)ptr;
+            value = attribute.Read<Float4>(ptr);
             break;
         case ParticleAttribute::ValueTypes::Int:
             value = *(int32*)ptr;
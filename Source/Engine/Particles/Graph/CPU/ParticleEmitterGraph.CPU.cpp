@@ -67,16 +67,24 @@ bool ParticleEmitterGraphCPU::Load(ReadStream* stream, bool loadMeta)
         ribbonOrderOffset += Capacity;
     }
 
-    // Initialize default particle data
+    InitDefaultParticleData();
+
+    return false;
+}
+
+void ParticleEmitterGraphCPU::InitDefaultParticleData()
+{
     _defaultParticleData.Resize(Layout.Size);
+    _defaultParticleData.SetAll(0);
     for (int32 i = 0; i < Layout.Attributes.Count(); i++)
     {
         const auto& attr = Layout.Attributes[i];
+        byte* ptr = _defaultParticleData.Get() + attr.Offset;
         switch (attr.ValueType)
         {
 #define SETUP_ATTR(type, valueType, getter) \
         case ParticleAttribute::ValueTypes::valueType: \
-            *(type*)(_defaultParticleData.Get() + attr.Offset) = AttributesDefaults[i].getter; \
+            attr.Write<type>(ptr, AttributesDefaults[i].getter); \
             break
         SETUP_ATTR(float, Float, AsFloat);
         SETUP_ATTR(Float2, Float2, AsFloat2());
@@ -88,8 +96,20 @@ bool ParticleEmitterGraphCPU::Load(ReadStream* stream, bool loadMeta)
         default: ;
         }
     }
+}
 
-    return false;
+void ParticleEmitterGraphCPU::UseQuantizedLayout()
+{
+    // Only attributes accessed via ParticleAttribute::Read/Write in the CPU modules can be quantized (the others are accessed as raw floats)
+    bool modified = false;
+    if (_attrColor != -1)
+        modified |= !Layout.SetAttributeFormat(_attrColor, ParticleAttribute::Formats::Half);
+    if (_attrSpriteSize != -1)
+        modified |= !Layout.SetAttributeFormat(_attrSpriteSize, ParticleAttribute::Formats::Half);
+    if (!modified)
+        return;
+    Layout.UpdateLayout();
+    InitDefaultParticleData();
 }
 
 void ParticleEmitterGraphCPU::InitializeNode(Node* node)
@@ -238,10 +258,11 @@ bool ParticleEmitterGraphCPUExecutor::ComputeBounds(ParticleEmitter* emitter, Pa
                 {
                     // Find the maximum local bounds of the particle sprite
                     Vector2 maxSpriteSize = Vector2::Zero;
-                    byte* spriteSize = bufferPtr + layout->Attributes[_graph._attrSpriteSize].Offset;
+                    const ParticleAttribute& spriteSizeAttr = layout->Attributes[_graph._attrSpriteSize];
+                    byte* spriteSize = bufferPtr + spriteSizeAttr.Offset;
                     for (int32 i = 0; i < count; i++)
                     {
-                        Vector2::Max(*((Vector2*)spriteSize), maxSpriteSize, maxSpriteSize);
+                        Vector2::Max(Vector2(spriteSizeAttr.Read<Float2>(spriteSize)), maxSpriteSize, maxSpriteSize);
                         spriteSize += stride;
                     }
                     ASSERT(!maxSpriteSize.IsNanOrInfinity());
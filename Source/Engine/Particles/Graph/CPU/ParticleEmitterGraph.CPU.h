@@ -75,6 +75,8 @@ class ParticleEmitterGraphCPU : public ParticleEmitterGraph<VisjectGraph<Particl
 
     Array<byte> _defaultParticleData;
 
+    void InitDefaultParticleData();
+
 public:
     // Size of the custom pre-node data buffer used for state tracking (eg. position on spiral arc progression).
     int32 CustomDataSize = 0;
@@ -100,6 +102,11 @@ class ParticleEmitterGraphCPU : public ParticleEmitterGraph<VisjectGraph<Particl
         return _attrAge != -1 ? Layout.Attributes[_attrAge].Offset : -1;
     }
 
+    /// <summary>
+    /// Switches the particle attributes that don't need full precision (color, sprite size) to the half-precision storage format. Used only by CPU particles (GPU particles simulation shaders use full-precision layout).
+    /// </summary>
+    void UseQuantizedLayout();
+
 public:
     // [ParticleEmitterGraph]
     bool Load(ReadStream* stream, bool loadMeta) override;
@@ -68,6 +68,7 @@ bool ParticleEmitterGPUGenerator::Generate(WriteStream& source, BytesContainer&
 
     // Setup and prepare graphs
     _writer.Clear();
+    clearExpressions();
     _includes.Clear();
     _callStack.Clear();
     _parameters.Clear();
@@ -316,6 +317,8 @@ bool ParticleEmitterGPUGenerator::Generate(WriteStream& source, BytesContainer&
 
 void ParticleEmitterGPUGenerator::clearCache()
 {
+    clearExpressions();
+
     // Reset cached boxes values
     for (int32 i = 0; i < _graphs.Count(); i++)
     {
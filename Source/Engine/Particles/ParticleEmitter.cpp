@@ -282,6 +282,12 @@ Asset::LoadResult ParticleEmitter::load()
 	SimulationMode = ParticlesSimulationMode::CPU;
 #endif
 
+    if (SimulationMode == ParticlesSimulationMode::CPU)
+    {
+        // Use smaller particle data for CPU simulation (less memory to update and to upload for rendering)
+        Graph.UseQuantizedLayout();
+    }
+
     return LoadResult::Ok;
 }
 
@@ -5,6 +5,7 @@
 #include "Engine/Content/Assets/Model.h"
 #include "Engine/Core/Collections/Sorting.h"
 #include "Engine/Core/Collections/HashSet.h"
+#include "Engine/Core/SIMD.h"
 #include "Engine/Engine/EngineService.h"
 #include "Engine/Engine/Time.h"
 #include "Engine/Engine/Engine.h"
@@ -18,6 +19,7 @@
 #include "Engine/Renderer/DrawCall.h"
 #include "Engine/Renderer/RenderList.h"
 #include "Engine/Threading/TaskGraph.h"
+#include "Engine/Threading/ThreadLocal.h"
 #if COMPILE_WITH_GPU_PARTICLES
 #include "Engine/Threading/Threading.h"
 #include "Engine/Content/Assets/Shader.h"
@@ -82,12 +84,11 @@ class SpriteParticleRenderer
     }
 };
 
+// Ribbon point order is not stored since it's derived from the vertex index in the shader (2 vertices per point)
 PACK_STRUCT(struct RibbonParticleVertex {
-    uint32 Order;
     uint32 ParticleIndex;
     uint32 PrevParticleIndex;
     float Distance;
-    // TODO: pack into half/uint16 data
     });
 
 struct EmitterCache
@@ -118,9 +119,22 @@ SpriteParticleRenderer SpriteRenderer;
 
 namespace ParticlesDrawCPU
 {
-    Array<uint32> SortingKeys[2];
-    Array<int32> SortingIndices;
-    Array<int32> SortedIndices;
+    struct SortingScratch
+    {
+        Array<uint32> SortingKeys[2];
+        Array<int32> SortingIndices;
+    };
+
+    // Per-thread sorting memory (custom sorting runs in simulation jobs, view sorting runs on draw)
+    ThreadLocal<SortingScratch*> Scratch;
+
+    SortingScratch& GetScratch()
+    {
+        auto& scratch = Scratch.Get();
+        if (!scratch)
+            scratch = New<SortingScratch>();
+        return *scratch;
+    }
 }
 
 class ParticleManagerService : public EngineService
@@ -161,266 +175,364 @@ void Particles::OnEffectDestroy(ParticleEffect* effect)
 
 typedef Array<int32, FixedAllocation<PARTICLE_EMITTER_MAX_MODULES>> RenderModulesIndices;
 
-void DrawEmitterCPU(RenderContext& renderContext, ParticleBuffer* buffer, DrawCall& drawCall, DrawPass drawModes, StaticFlags staticFlags, ParticleEmitterInstance& emitterData, const RenderModulesIndices& renderModulesIndices, int16 sortOrder)
+FORCE_INLINE bool IsViewSortMode(ParticleSortMode sortMode)
 {
-    // Skip if CPU buffer is empty
-    if (buffer->CPU.Count == 0)
-        return;
-    const auto context = GPUDevice::Instance->GetMainContext();
-    auto emitter = buffer->Emitter;
+    return sortMode == ParticleSortMode::ViewDepth || sortMode == ParticleSortMode::ViewDistance;
+}
 
-    // Check if need to perform any particles sorting
-    if (emitter->Graph.SortModules.HasItems() && renderContext.View.Pass != DrawPass::Depth)
+void ComputeViewSortKeys(uint32* keys, const byte* positionPtr, int32 stride, int32 count, const Matrix& transform, bool depth, uint32 sortKeyXor)
+{
+    // Process 4 particles at once (depth uses transformed W component, distance uses transformed position length)
+    int32 i = 0;
+    ALIGN_BEGIN(16) float values[4] ALIGN_END(16);
+    const SimdVector4 m11 = SIMD::Splat(transform.M11), m21 = SIMD::Splat(transform.M21), m31 = SIMD::Splat(transform.M31), m41 = SIMD::Splat(transform.M41);
+    const SimdVector4 m12 = SIMD::Splat(transform.M12), m22 = SIMD::Splat(transform.M22), m32 = SIMD::Splat(transform.M32), m42 = SIMD::Splat(transform.M42);
+    const SimdVector4 m13 = SIMD::Splat(transform.M13), m23 = SIMD::Splat(transform.M23), m33 = SIMD::Splat(transform.M33), m43 = SIMD::Splat(transform.M43);
+    const SimdVector4 m14 = SIMD::Splat(transform.M14), m24 = SIMD::Splat(transform.M24), m34 = SIMD::Splat(transform.M34), m44 = SIMD::Splat(transform.M44);
+    for (; i + 4 <= count; i += 4)
     {
-        // Prepare sorting data
-        if (!buffer->GPU.SortedIndices)
-            buffer->AllocateSortBuffer();
+        const Float3& p0 = *(const Float3*)positionPtr;
+        const Float3& p1 = *(const Float3*)(positionPtr + stride);
+        const Float3& p2 = *(const Float3*)(positionPtr + stride * 2);
+        const Float3& p3 = *(const Float3*)(positionPtr + stride * 3);
+        const SimdVector4 x = SIMD::Load(p0.X, p1.X, p2.X, p3.X);
+        const SimdVector4 y = SIMD::Load(p0.Y, p1.Y, p2.Y, p3.Y);
+        const SimdVector4 z = SIMD::Load(p0.Z, p1.Z, p2.Z, p3.Z);
+        SimdVector4 value;
+        if (depth)
+        {
+            value = SIMD::Add(SIMD::Add(SIMD::Mul(x, m14), SIMD::Mul(y, m24)), SIMD::Add(SIMD::Mul(z, m34), m44));
+        }
+        else
+        {
+            const SimdVector4 tx = SIMD::Add(SIMD::Add(SIMD::Mul(x, m11), SIMD::Mul(y, m21)), SIMD::Add(SIMD::Mul(z, m31), m41));
+            const SimdVector4 ty = SIMD::Add(SIMD::Add(SIMD::Mul(x, m12), SIMD::Mul(y, m22)), SIMD::Add(SIMD::Mul(z, m32), m42));
+            const SimdVector4 tz = SIMD::Add(SIMD::Add(SIMD::Mul(x, m13), SIMD::Mul(y, m23)), SIMD::Add(SIMD::Mul(z, m33), m43));
+            value = SIMD::Add(SIMD::Add(SIMD::Mul(tx, tx), SIMD::Mul(ty, ty)), SIMD::Mul(tz, tz));
+        }
+        SIMD::Store(values, value);
+        keys[i + 0] = RenderTools::ComputeDistanceSortKey(values[0]) ^ sortKeyXor;
+        keys[i + 1] = RenderTools::ComputeDistanceSortKey(values[1]) ^ sortKeyXor;
+        keys[i + 2] = RenderTools::ComputeDistanceSortKey(values[2]) ^ sortKeyXor;
+        keys[i + 3] = RenderTools::ComputeDistanceSortKey(values[3]) ^ sortKeyXor;
+        positionPtr += stride * 4;
+    }
+    for (; i < count; i++)
+    {
+        const Float3& p = *(const Float3*)positionPtr;
+        float value;
+        if (depth)
+            value = p.X * transform.M14 + p.Y * transform.M24 + p.Z * transform.M34 + transform.M44;
+        else
+            value = Float3::Transform(p, transform).LengthSquared();
+        keys[i] = RenderTools::ComputeDistanceSortKey(value) ^ sortKeyXor;
+        positionPtr += stride;
+    }
+}
 
-        // Execute all sorting modules
-        for (int32 moduleIndex = 0; moduleIndex < emitter->Graph.SortModules.Count(); moduleIndex++)
+void SortParticlesCPU(ParticleBuffer* buffer, ParticleEmitterGraphCPUNode* module, const Matrix& transform)
+{
+    auto emitter = buffer->Emitter;
+    const auto sortMode = static_cast<ParticleSortMode>(module->Values[2].AsInt);
+    const int32 stride = buffer->Stride;
+    const int32 listSize = buffer->CPU.Count;
+    auto& scratch = ParticlesDrawCPU::GetScratch();
+    scratch.SortingKeys[0].Resize(listSize, false);
+    scratch.SortingKeys[1].Resize(listSize, false);
+    scratch.SortingIndices.Resize(listSize, false);
+    uint32* sortedKeys = scratch.SortingKeys[0].Get();
+    const uint32 sortKeyXor = sortMode != ParticleSortMode::CustomAscending ? MAX_uint32 : 0;
+    switch (sortMode)
+    {
+    case ParticleSortMode::ViewDepth:
+    case ParticleSortMode::ViewDistance:
+        ComputeViewSortKeys(sortedKeys, buffer->CPU.Buffer.Get() + emitter->Graph.GetPositionAttributeOffset(), stride, listSize, transform, sortMode == ParticleSortMode::ViewDepth, sortKeyXor);
+        break;
+    case ParticleSortMode::CustomAscending:
+    case ParticleSortMode::CustomDescending:
+    {
+        int32 attributeIdx = module->Attributes[0];
+        if (attributeIdx == -1)
         {
-            auto module = emitter->Graph.SortModules[moduleIndex];
-            const int32 sortedIndicesOffset = module->SortedIndicesOffset;
-            const auto sortMode = static_cast<ParticleSortMode>(module->Values[2].AsInt);
-            const int32 stride = buffer->Stride;
-            const int32 listSize = buffer->CPU.Count;
-#define PREPARE_CACHE(list) (ParticlesDrawCPU::list).Clear(); (ParticlesDrawCPU::list).Resize(listSize)
-            PREPARE_CACHE(SortingKeys[0]);
-            PREPARE_CACHE(SortingKeys[1]);
-            PREPARE_CACHE(SortingIndices);
-#undef PREPARE_CACHE
-            uint32* sortedKeys = ParticlesDrawCPU::SortingKeys[0].Get();
-            const uint32 sortKeyXor = sortMode != ParticleSortMode::CustomAscending ? MAX_uint32 : 0;
-            switch (sortMode)
-            {
-            case ParticleSortMode::ViewDepth:
-            {
-                const Matrix viewProjection = renderContext.View.ViewProjection();
-                byte* positionPtr = buffer->CPU.Buffer.Get() + emitter->Graph.GetPositionAttributeOffset();
-                if (emitter->SimulationSpace == ParticlesSimulationSpace::Local)
-                {
-                    for (int32 i = 0; i < buffer->CPU.Count; i++)
-                    {
-                        // TODO: use SIMD
-                        sortedKeys[i] = RenderTools::ComputeDistanceSortKey(Matrix::TransformPosition(viewProjection, Matrix::TransformPosition(drawCall.World, *(Float3*)positionPtr)).W) ^ sortKeyXor;
-                        positionPtr += stride;
-                    }
-                }
-                else
-                {
-                    for (int32 i = 0; i < buffer->CPU.Count; i++)
-                    {
-                        sortedKeys[i] = RenderTools::ComputeDistanceSortKey(Matrix::TransformPosition(viewProjection, *(Float3*)positionPtr).W) ^ sortKeyXor;
-                        positionPtr += stride;
-                    }
-                }
-                break;
-            }
-            case ParticleSortMode::ViewDistance:
-            {
-                const Float3 viewPosition = renderContext.View.Position;
-                byte* positionPtr = buffer->CPU.Buffer.Get() + emitter->Graph.GetPositionAttributeOffset();
-                if (emitter->SimulationSpace == ParticlesSimulationSpace::Local)
-                {
-                    for (int32 i = 0; i < buffer->CPU.Count; i++)
-                    {
-                        // TODO: use SIMD
-                        sortedKeys[i] = RenderTools::ComputeDistanceSortKey((viewPosition - Float3::Transform(*(Float3*)positionPtr, drawCall.World)).LengthSquared()) ^ sortKeyXor;
-                        positionPtr += stride;
-                    }
-                }
-                else
-                {
-                    for (int32 i = 0; i < buffer->CPU.Count; i++)
-                    {
-                        // TODO: use SIMD
-                        sortedKeys[i] = RenderTools::ComputeDistanceSortKey((viewPosition - *(Float3*)positionPtr).LengthSquared()) ^ sortKeyXor;
-                        positionPtr += stride;
-                    }
-                }
-                break;
-            }
-            case ParticleSortMode::CustomAscending:
-            case ParticleSortMode::CustomDescending:
-            {
-                int32 attributeIdx = module->Attributes[0];
-                if (attributeIdx == -1)
-                    break;
-                byte* attributePtr = buffer->CPU.Buffer.Get() + emitter->Graph.Layout.Attributes[attributeIdx].Offset;
-                for (int32 i = 0; i < buffer->CPU.Count; i++)
-                {
-                    sortedKeys[i] = RenderTools::ComputeDistanceSortKey(*(float*)attributePtr) ^ sortKeyXor;
-                    attributePtr += stride;
-                }
-                break;
-            }
+            Platform::MemoryClear(sortedKeys, listSize * sizeof(uint32));
+            break;
+        }
+        byte* attributePtr = buffer->CPU.Buffer.Get() + emitter->Graph.Layout.Attributes[attributeIdx].Offset;
+        for (int32 i = 0; i < listSize; i++)
+        {
+            sortedKeys[i] = RenderTools::ComputeDistanceSortKey(*(float*)attributePtr) ^ sortKeyXor;
+            attributePtr += stride;
+        }
+        break;
+    }
 #if !BUILD_RELEASE
-            default:
-                CRASH;
+    default:
+        CRASH;
 #endif
-            }
+    }
 
-            // Generate sorting indices
-            int32* sortedIndices;
-            {
-                ParticlesDrawCPU::SortedIndices.Resize(listSize);
-                sortedIndices = ParticlesDrawCPU::SortedIndices.Get();
-                for (int i = 0; i < listSize; i++)
-                    sortedIndices[i] = i;
-            }
+    // Generate sorting indices
+    int32* sortedIndicesStart = buffer->CPU.SortedIndices.Get() + module->SortedIndicesOffset / sizeof(int32);
+    int32* sortedIndices = sortedIndicesStart;
+    for (int32 i = 0; i < listSize; i++)
+        sortedIndices[i] = i;
 
-            // Sort keys with indices
-            {
-                Sorting::RadixSort(sortedKeys, sortedIndices, ParticlesDrawCPU::SortingKeys[1].Get(), ParticlesDrawCPU::SortingIndices.Get(), listSize);
-            }
+    // Sort keys with indices
+    Sorting::ParallelRadixSort(sortedKeys, sortedIndices, scratch.SortingKeys[1].Get(), scratch.SortingIndices.Get(), listSize);
+    if (sortedIndices != sortedIndicesStart)
+        Platform::MemoryCopy(sortedIndicesStart, sortedIndices, listSize * sizeof(int32));
+}
 
-            // Upload CPU particles indices
-            {
-                context->UpdateBuffer(buffer->GPU.SortedIndices, sortedIndices, listSize * sizeof(int32), sortedIndicesOffset);
-            }
-        }
-    }
+void BuildRibbonsCPU(ParticleBuffer* buffer)
+{
+    auto emitter = buffer->Emitter;
+    Platform::MemoryClear(buffer->CPU.Ribbons, sizeof(buffer->CPU.Ribbons));
+    if (!buffer->GPU.RibbonIndexBufferDynamic)
+        buffer->GPU.RibbonIndexBufferDynamic = New<DynamicIndexBuffer>(0, (uint32)sizeof(uint16), TEXT("RibbonIndexBufferDynamic"));
+    else
+        buffer->GPU.RibbonIndexBufferDynamic->Clear();
+    if (!buffer->GPU.RibbonVertexBufferDynamic)
+        buffer->GPU.RibbonVertexBufferDynamic = New<DynamicVertexBuffer>(0, (uint32)sizeof(RibbonParticleVertex), TEXT("RibbonVertexBufferDynamic"));
+    else
+        buffer->GPU.RibbonVertexBufferDynamic->Clear();
+    auto& indexBuffer = buffer->GPU.RibbonIndexBufferDynamic->Data;
+    auto& vertexBuffer = buffer->GPU.RibbonVertexBufferDynamic->Data;
 
-    // Upload CPU particles data to GPU
-    {
-        context->UpdateBuffer(buffer->GPU.Buffer, buffer->CPU.Buffer.Get(), buffer->CPU.Count * buffer->Stride);
-    }
+    // Prepare particles buffer access
+    auto positionOffset = emitter->Graph.GetPositionAttributeOffset();
+    if (positionOffset == -1 || buffer->CPU.Count < 2 || buffer->CPU.RibbonOrder.IsEmpty())
+        return;
+    uint32 count = buffer->CPU.Count;
+    ASSERT(buffer->CPU.RibbonOrder.Count() == emitter->Graph.RibbonRenderingModules.Count() * buffer->Capacity);
 
-    // Check if need to setup ribbon modules
-    int32 ribbonModuleIndex = 0;
+    // Setup all ribbon modules
     int32 ribbonModulesDrawIndicesPos = 0;
-    int32 ribbonModulesDrawIndicesStart[PARTICLE_EMITTER_MAX_RIBBONS];
-    int32 ribbonModulesDrawIndicesCount[PARTICLE_EMITTER_MAX_RIBBONS];
-    int32 ribbonModulesSegmentCount[PARTICLE_EMITTER_MAX_RIBBONS];
-    if (emitter->Graph.RibbonRenderingModules.HasItems())
+    for (int32 ribbonModuleIndex = 0; ribbonModuleIndex < emitter->Graph.RibbonRenderingModules.Count() && ribbonModuleIndex < PARTICLE_EMITTER_MAX_RIBBONS; ribbonModuleIndex++)
     {
-        // Prepare ribbon data
-        if (!buffer->GPU.RibbonIndexBufferDynamic)
-            buffer->GPU.RibbonIndexBufferDynamic = New<DynamicIndexBuffer>(0, (uint32)sizeof(uint16), TEXT("RibbonIndexBufferDynamic"));
-        else
-            buffer->GPU.RibbonIndexBufferDynamic->Clear();
-        if (!buffer->GPU.RibbonVertexBufferDynamic)
-            buffer->GPU.RibbonVertexBufferDynamic = New<DynamicVertexBuffer>(0, (uint32)sizeof(RibbonParticleVertex), TEXT("RibbonVertexBufferDynamic"));
-        else
-            buffer->GPU.RibbonVertexBufferDynamic->Clear();
-        auto& indexBuffer = buffer->GPU.RibbonIndexBufferDynamic->Data;
-        auto& vertexBuffer = buffer->GPU.RibbonVertexBufferDynamic->Data;
-
-        // Setup all ribbon modules
-        for (int32 index = 0; index < renderModulesIndices.Count(); index++)
+        auto module = emitter->Graph.RibbonRenderingModules[ribbonModuleIndex];
+        int32* ribbonOrderData = buffer->CPU.RibbonOrder.Get() + module->RibbonOrderOffset;
+        ParticleBufferCPUDataAccessor<Float3> positionData(buffer, emitter->Graph.Layout.GetAttributeOffset(module->Attributes[0]));
+
+        // Write ribbon indices/vertices
+        int32 indices = 0, segmentCount = 0;
+        float totalDistance = 0.0f;
+        int32 firstVertexIndex = vertexBuffer.Count();
+        uint32 idxPrev = ribbonOrderData[0], vertexPrev = 0;
         {
-            const int32 moduleIndex = renderModulesIndices[index];
-            auto module = emitter->Graph.RenderModules[moduleIndex];
-            if (module->TypeID != 404 || ribbonModuleIndex >= PARTICLE_EMITTER_MAX_RIBBONS)
-                continue;
-            ribbonModulesDrawIndicesStart[ribbonModuleIndex] = ribbonModulesDrawIndicesPos;
-            ribbonModulesDrawIndicesCount[ribbonModuleIndex] = 0;
+            uint32 idxThis = ribbonOrderData[0];
 
-            // Prepare particles buffer access
-            auto positionOffset = emitter->Graph.GetPositionAttributeOffset();
-            if (positionOffset == -1 || buffer->CPU.Count < 2 || buffer->CPU.RibbonOrder.IsEmpty())
-                break;
-            uint32 count = buffer->CPU.Count;
-            ASSERT(buffer->CPU.RibbonOrder.Count() == emitter->Graph.RibbonRenderingModules.Count() * buffer->Capacity);
-            int32* ribbonOrderData = buffer->CPU.RibbonOrder.Get() + module->RibbonOrderOffset;
-            ParticleBufferCPUDataAccessor<Float3> positionData(buffer, emitter->Graph.Layout.GetAttributeOffset(module->Attributes[0]));
+            // 2 vertices
+            {
+                vertexBuffer.AddUninitialized(2 * sizeof(RibbonParticleVertex));
+                auto ptr = (RibbonParticleVertex*)(vertexBuffer.Get() + firstVertexIndex);
+
+                RibbonParticleVertex v = { idxThis, idxThis, totalDistance };
 
-            // Write ribbon indices/vertices
-            int32 indices = 0, segmentCount = 0;
-            float totalDistance = 0.0f;
-            int32 firstVertexIndex = vertexBuffer.Count();
-            uint32 idxPrev = ribbonOrderData[0], vertexPrev = 0;
+                *ptr++ = v;
+                *ptr++ = v;
+            }
+
+            idxPrev = idxThis;
+        }
+        for (uint32 i = 1; i < count && vertexPrev + 3 <= MAX_uint16; i++)
+        {
+            uint32 idxThis = ribbonOrderData[i];
+            Float3 direction = positionData[idxThis] - positionData[idxPrev];
+            const float distance = direction.Length();
+            if (distance > 0.002f)
             {
-                uint32 idxThis = ribbonOrderData[0];
+                totalDistance += distance;
 
                 // 2 vertices
                 {
+                    auto idx = vertexBuffer.Count();
                     vertexBuffer.AddUninitialized(2 * sizeof(RibbonParticleVertex));
-                    auto ptr = (RibbonParticleVertex*)(vertexBuffer.Get() + firstVertexIndex);
+                    auto ptr = (RibbonParticleVertex*)(vertexBuffer.Get() + idx);
 
-                    RibbonParticleVertex v = { 0, idxThis, idxThis, totalDistance };
+                    // TODO: this could be optimized by manually fetching per-particle data in vertex shader (2x less data to send and fetch)
+                    RibbonParticleVertex v = { idxThis, idxPrev, totalDistance };
 
                     *ptr++ = v;
                     *ptr++ = v;
                 }
 
+                // 2 triangles
+                {
+                    auto idx = indexBuffer.Count();
+                    indexBuffer.AddUninitialized(6 * sizeof(uint16));
+                    auto ptr = (uint16*)(indexBuffer.Get() + idx);
+
+                    uint32 i0 = vertexPrev;
+                    uint32 i1 = vertexPrev + 2;
+
+                    *ptr++ = i0;
+                    *ptr++ = i0 + 1;
+                    *ptr++ = i1;
+
+                    *ptr++ = i0 + 1;
+                    *ptr++ = i1 + 1;
+                    *ptr++ = i1;
+
+                    indices += 6;
+                }
+
                 idxPrev = idxThis;
+                segmentCount++;
+                vertexPrev += 2;
             }
-            for (uint32 i = 1; i < count; i++)
-            {
-                uint32 idxThis = ribbonOrderData[i];
-                Float3 direction = positionData[idxThis] - positionData[idxPrev];
-                const float distance = direction.Length();
-                if (distance > 0.002f)
-                {
-                    totalDistance += distance;
+        }
+        if (segmentCount == 0)
+            continue;
+        {
+            // Fix first particle vertex data to have proper direction
+            auto ptr0 = (RibbonParticleVertex*)(vertexBuffer.Get() + firstVertexIndex);
+            auto ptr1 = ptr0 + 1;
+            auto ptr2 = ptr1 + 1;
+            ptr0->PrevParticleIndex = ptr1->PrevParticleIndex = ptr2->ParticleIndex;
+        }
 
-                    // 2 vertices
-                    {
-                        auto idx = vertexBuffer.Count();
-                        vertexBuffer.AddUninitialized(2 * sizeof(RibbonParticleVertex));
-                        auto ptr = (RibbonParticleVertex*)(vertexBuffer.Get() + idx);
+        // Setup ribbon data
+        auto& ribbon = buffer->CPU.Ribbons[ribbonModuleIndex];
+        ribbon.VerticesOffset = firstVertexIndex;
+        ribbon.IndicesStart = ribbonModulesDrawIndicesPos;
+        ribbon.IndicesCount = indices;
+        ribbon.SegmentCount = segmentCount;
+        ribbonModulesDrawIndicesPos += indices;
+    }
+}
 
-                        // TODO: this could be optimized by manually fetching per-particle data in vertex shader (2x less data to send and fetch)
-                        RibbonParticleVertex v = { i, idxThis, idxPrev, totalDistance };
+void BuildEmitterDrawCPU(ParticleBuffer* buffer)
+{
+    buffer->CPU.DrawDataVersion = buffer->CPU.DataVersion;
+    if (buffer->CPU.Count == 0)
+        return;
+    auto emitter = buffer->Emitter;
 
-                        *ptr++ = v;
-                        *ptr++ = v;
-                    }
+    // Sort particles by the custom attributes (view-independent so can be done once after simulation for all views)
+    const auto& sortModules = emitter->Graph.SortModules;
+    if (sortModules.HasItems())
+    {
+        PROFILE_CPU_NAMED("Sort");
+        buffer->CPU.SortedIndices.Resize(buffer->Capacity * sortModules.Count(), false);
+        if (buffer->CPU.Sorting.Count() != sortModules.Count())
+        {
+            buffer->CPU.Sorting.Resize(sortModules.Count(), false);
+            Platform::MemoryClear(buffer->CPU.Sorting.Get(), buffer->CPU.Sorting.Count() * sizeof(ParticleBuffer::SortingCache));
+        }
+        for (int32 i = 0; i < sortModules.Count(); i++)
+        {
+            const auto module = sortModules[i];
+            if (!IsViewSortMode(static_cast<ParticleSortMode>(module->Values[2].AsInt)))
+            {
+                SortParticlesCPU(buffer, module, Matrix::Identity);
+                buffer->CPU.Sorting[i].DataVersion = buffer->CPU.DataVersion;
+            }
+        }
+    }
 
-                    // 2 triangles
-                    {
-                        auto idx = indexBuffer.Count();
-                        indexBuffer.AddUninitialized(6 * sizeof(uint16));
-                        auto ptr = (uint16*)(indexBuffer.Get() + idx);
+    // Build ribbons geometry (shared by all views)
+    if (emitter->Graph.RibbonRenderingModules.HasItems())
+    {
+        PROFILE_CPU_NAMED("Ribbons");
+        BuildRibbonsCPU(buffer);
+    }
+}
 
-                        uint32 i0 = vertexPrev;
-                        uint32 i1 = vertexPrev + 2;
+void UpdateEmitterDrawCPU(ParticleBuffer* buffer)
+{
+    // Invalidate GPU data and sorting
+    buffer->CPU.DataVersion++;
 
-                        *ptr++ = i0;
-                        *ptr++ = i0 + 1;
-                        *ptr++ = i1;
+    // Build drawing data once after simulation for all views but only if emitter is visible (otherwise it's built on the next draw)
+    if (Engine::FrameCount - buffer->CPU.LastFrameDrawn <= 2)
+        BuildEmitterDrawCPU(buffer);
+}
 
-                        *ptr++ = i0 + 1;
-                        *ptr++ = i1 + 1;
-                        *ptr++ = i1;
+void DrawEmitterCPU(RenderContext& renderContext, ParticleBuffer* buffer, DrawCall& drawCall, DrawPass drawModes, StaticFlags staticFlags, ParticleEmitterInstance& emitterData, const RenderModulesIndices& renderModulesIndices, int16 sortOrder)
+{
+    // Skip if CPU buffer is empty
+    buffer->CPU.LastFrameDrawn = Engine::FrameCount; // Mark as visible before the early exit so newly spawned particles are prepared after simulation
+    if (buffer->CPU.Count == 0)
+        return;
+    const auto context = GPUDevice::Instance->GetMainContext();
+    auto emitter = buffer->Emitter;
 
-                        indices += 6;
-                    }
+    // Build drawing data if it was skipped after the simulation update (emitter was not visible)
+    if (buffer->CPU.DrawDataVersion != buffer->CPU.DataVersion)
+        BuildEmitterDrawCPU(buffer);
+    const bool uploadData = buffer->GPU.UploadedDataVersion != buffer->CPU.DataVersion;
+    buffer->GPU.UploadedDataVersion = buffer->CPU.DataVersion;
 
-                    idxPrev = idxThis;
-                    segmentCount++;
-                    vertexPrev += 2;
-                }
-            }
-            if (segmentCount == 0)
+    // Check if need to perform any particles sorting
+    const auto& sortModules = emitter->Graph.SortModules;
+    if (sortModules.HasItems() && buffer->CPU.Sorting.Count() == sortModules.Count())
+    {
+        // Prepare sorting data
+        if (!buffer->GPU.SortedIndices)
+            buffer->AllocateSortBuffer();
+        bool uploadSorting = uploadData;
+
+        // Execute view-dependent sorting modules (sorting results are reused by views with the same sorting input)
+        for (int32 moduleIndex = 0; moduleIndex < sortModules.Count(); moduleIndex++)
+        {
+            auto module = sortModules[moduleIndex];
+            const auto sortMode = static_cast<ParticleSortMode>(module->Values[2].AsInt);
+            if (!IsViewSortMode(sortMode))
                 continue;
+
+            // Get the particle position transformation used to compute the sort keys
+            Matrix transform;
+            if (sortMode == ParticleSortMode::ViewDepth)
+            {
+                const Matrix viewProjection = renderContext.View.ViewProjection();
+                if (emitter->SimulationSpace == ParticlesSimulationSpace::Local)
+                    Matrix::Multiply(drawCall.World, viewProjection, transform);
+                else
+                    transform = viewProjection;
+            }
+            else
             {
-                // Fix first particle vertex data to have proper direction
-                auto ptr0 = (RibbonParticleVertex*)(vertexBuffer.Get() + firstVertexIndex);
-                auto ptr1 = ptr0 + 1;
-                auto ptr2 = ptr1 + 1;
-                ptr0->PrevParticleIndex = ptr1->PrevParticleIndex = ptr2->ParticleIndex;
+                const Matrix viewTranslation = Matrix::Translation(-renderContext.View.Position);
+                if (emitter->SimulationSpace == ParticlesSimulationSpace::Local)
+                    Matrix::Multiply(drawCall.World, viewTranslation, transform);
+                else
+                    transform = viewTranslation;
             }
 
-            // Setup ribbon data
-            ribbonModulesSegmentCount[ribbonModuleIndex] = segmentCount;
-            ribbonModulesDrawIndicesCount[index] = indices;
-            ribbonModulesDrawIndicesPos += indices;
+            auto& sorting = buffer->CPU.Sorting[moduleIndex];
+            if (sorting.DataVersion == buffer->CPU.DataVersion && sorting.Transform == transform)
+                continue;
+            if (renderContext.View.Pass == DrawPass::Depth && sorting.DataVersion == buffer->CPU.DataVersion)
+                continue; // Depth-only rendering doesn't need proper order (just indices valid for the current particles data)
+            PROFILE_CPU_NAMED("Sort");
+            SortParticlesCPU(buffer, module, transform);
+            sorting.DataVersion = buffer->CPU.DataVersion;
+            sorting.Transform = transform;
+            uploadSorting = true;
+        }
 
-            ribbonModuleIndex++;
+        // Upload CPU particles indices (all sorting modules at once)
+        if (uploadSorting)
+        {
+            const int32 sortedIndicesCount = (sortModules.Count() - 1) * buffer->Capacity + buffer->CPU.Count;
+            context->UpdateBuffer(buffer->GPU.SortedIndices, buffer->CPU.SortedIndices.Get(), sortedIndicesCount * sizeof(int32));
         }
+    }
 
-        if (ribbonModuleIndex != 0)
+    if (uploadData)
+    {
+        // Upload CPU particles data to GPU
+        context->UpdateBuffer(buffer->GPU.Buffer, buffer->CPU.Buffer.Get(), buffer->CPU.Count * buffer->Stride);
+
+        // Upload ribbons geometry
+        if (buffer->GPU.RibbonIndexBufferDynamic && buffer->GPU.RibbonIndexBufferDynamic->Data.HasItems())
         {
-            // Upload data to the GPU buffer
             buffer->GPU.RibbonIndexBufferDynamic->Flush(context);
             buffer->GPU.RibbonVertexBufferDynamic->Flush(context);
         }
     }
 
     // Execute all rendering modules
-    ribbonModuleIndex = 0;
     for (int32 index = 0; index < renderModulesIndices.Count(); index++)
     {
         const int32 moduleIndex = renderModulesIndices[index];
@@ -478,8 +590,10 @@ void DrawEmitterCPU(RenderContext& renderContext, ParticleBuffer* buffer, DrawCa
         // Ribbon Rendering
         case 404:
         {
-            if (ribbonModulesDrawIndicesCount[ribbonModuleIndex] == 0)
+            const int32 ribbonModuleIndex = emitter->Graph.RibbonRenderingModules.Find(module);
+            if (ribbonModuleIndex == -1 || ribbonModuleIndex >= PARTICLE_EMITTER_MAX_RIBBONS || buffer->CPU.Ribbons[ribbonModuleIndex].IndicesCount == 0)
                 break;
+            const auto& ribbonData = buffer->CPU.Ribbons[ribbonModuleIndex];
             const auto material = (MaterialBase*)module->Assets[0].Get();
             const auto moduleDrawModes = module->Values.Count() > 6 ? (DrawPass)module->Values[6].AsInt : DrawPass::Default;
             auto dp = drawModes & moduleDrawModes & material->GetDrawModes();
@@ -499,7 +613,7 @@ void DrawEmitterCPU(RenderContext& renderContext, ParticleBuffer* buffer, DrawCa
             // Setup ribbon data
             auto& ribbon = drawCall.Particle.Ribbon;
             ribbon.UVTilingDistance = uvTilingDistance;
-            ribbon.SegmentCount = ribbonModulesSegmentCount[ribbonModuleIndex];
+            ribbon.SegmentCount = ribbonData.SegmentCount;
             ribbon.UVScaleX = uvScale.X;
             ribbon.UVScaleY = uvScale.Y;
             ribbon.UVOffsetX = uvOffset.X;
@@ -523,16 +637,14 @@ void DrawEmitterCPU(RenderContext& renderContext, ParticleBuffer* buffer, DrawCa
             drawCall.Geometry.VertexBuffers[0] = buffer->GPU.RibbonVertexBufferDynamic->GetBuffer();
             drawCall.Geometry.VertexBuffers[1] = nullptr;
             drawCall.Geometry.VertexBuffers[2] = nullptr;
-            drawCall.Geometry.VertexBuffersOffsets[0] = 0;
+            drawCall.Geometry.VertexBuffersOffsets[0] = ribbonData.VerticesOffset;
             drawCall.Geometry.VertexBuffersOffsets[1] = 0;
             drawCall.Geometry.VertexBuffersOffsets[2] = 0;
-            drawCall.Draw.StartIndex = ribbonModulesDrawIndicesStart[ribbonModuleIndex];
-            drawCall.Draw.IndicesCount = ribbonModulesDrawIndicesCount[ribbonModuleIndex];
+            drawCall.Draw.StartIndex = ribbonData.IndicesStart;
+            drawCall.Draw.IndicesCount = ribbonData.IndicesCount;
             drawCall.InstanceCount = 1;
             renderContext.List->AddDrawCall(renderContext, dp, staticFlags, drawCall, false, sortOrder);
 
-            ribbonModuleIndex++;
-
             break;
         }
         // Volumetric Fog Rendering
@@ -1208,10 +1320,12 @@ void ParticleManagerService::Dispose()
     }
     CleanupGPUParticlesSorting();
 #endif
-    ParticlesDrawCPU::SortingKeys[0].SetCapacity(0);
-    ParticlesDrawCPU::SortingKeys[1].SetCapacity(0);
-    ParticlesDrawCPU::SortingIndices.SetCapacity(0);
-    ParticlesDrawCPU::SortedIndices.SetCapacity(0);
+    {
+        Array<ParticlesDrawCPU::SortingScratch*> scratches;
+        ParticlesDrawCPU::Scratch.GetValues(scratches);
+        scratches.ClearDelete();
+        ParticlesDrawCPU::Scratch.Clear();
+    }
 
     PoolLocker.Lock();
     for (auto i = Pool.Begin(); i.IsNotEnd(); ++i)
@@ -1356,6 +1470,7 @@ void ParticlesSystem::Job(int32 index)
         {
         case ParticlesSimulationMode::CPU:
             emitter->GraphExecutorCPU.Update(emitter, effect, data, dt, canSpawn);
+            UpdateEmitterDrawCPU(data.Buffer);
             updateBounds |= emitter->UseAutoBounds;
             break;
 #if COMPILE_WITH_GPU_PARTICLES
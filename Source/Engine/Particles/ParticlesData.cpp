@@ -6,6 +6,141 @@
 #include "Engine/Graphics/GPUDevice.h"
 #include "Engine/Graphics/DynamicBuffer.h"
 
+uint16 ParticleAttribute::HalfBaseTable[512];
+byte ParticleAttribute::HalfShiftTable[512];
+uint32 ParticleAttribute::HalfMantissaTable[2048];
+uint32 ParticleAttribute::HalfExponentTable[64];
+uint16 ParticleAttribute::HalfOffsetTable[64];
+
+namespace
+{
+    // Reference: Jeroen van der Zijp, "Fast Half Float Conversions"
+    struct HalfTablesInitializer
+    {
+        HalfTablesInitializer()
+        {
+            for (int32 i = 0; i < 256; i++)
+            {
+                const int32 e = i - 127;
+                uint16 base;
+                byte shift;
+                if (e < -24)
+                {
+                    // Too small, flush to zero
+                    base = 0x0000;
+                    shift = 24;
+                }
+                else if (e < -14)
+                {
+                    // Denormalized half
+                    base = (uint16)(0x0400 >> (-e - 14));
+                    shift = (byte)(-e - 1);
+                }
+                else if (e <= 15)
+                {
+                    // Normalized half
+                    base = (uint16)((e + 15) << 10);
+                    shift = 13;
+                }
+                else if (e < 128)
+                {
+                    // Too large, map to infinity
+                    base = 0x7C00;
+                    shift = 24;
+                }
+                else
+                {
+                    // Infinity and NaN
+                    base = 0x7C00;
+                    shift = 13;
+                }
+                ParticleAttribute::HalfBaseTable[i] = base;
+                ParticleAttribute::HalfBaseTable[i | 0x100] = base | 0x8000;
+                ParticleAttribute::HalfShiftTable[i] = shift;
+                ParticleAttribute::HalfShiftTable[i | 0x100] = shift;
+            }
+            ParticleAttribute::HalfMantissaTable[0] = 0;
+            for (uint32 i = 1; i < 1024; i++)
+            {
+                // Renormalize the denormalized half
+                uint32 m = i << 13, e = 0;
+                while (!(m & 0x00800000))
+                {
+                    e -= 0x00800000;
+                    m <<= 1;
+                }
+                m &= ~0x00800000;
+                e += 0x38800000;
+                ParticleAttribute::HalfMantissaTable[i] = m | e;
+            }
+            for (uint32 i = 1024; i < 2048; i++)
+                ParticleAttribute::HalfMantissaTable[i] = 0x38000000 + ((i - 1024) << 13);
+            for (uint32 i = 0; i < 64; i++)
+            {
+                uint32 exponent;
+                if (i == 0 || i == 32)
+                    exponent = i << 26;
+                else if (i == 31 || i == 63)
+                    exponent = ((i & 32) << 26) | 0x47800000;
+                else
+                    exponent = ((i & 32) << 26) | ((i & 31) << 23);
+                ParticleAttribute::HalfExponentTable[i] = exponent;
+                ParticleAttribute::HalfOffsetTable[i] = i == 0 || i == 32 ? 0 : 1024;
+            }
+        }
+    };
+
+    HalfTablesInitializer HalfTablesInit;
+}
+
+void ParticleAttribute::Load(const byte* src, void* value) const
+{
+    float* dst = (float*)value;
+    const int32 count = GetComponentsCount();
+    switch (Format)
+    {
+    case Formats::Half:
+        for (int32 i = 0; i < count; i++)
+            dst[i] = DecodeHalf(((const uint16*)src)[i]);
+        break;
+    case Formats::UNorm8:
+        for (int32 i = 0; i < count; i++)
+            dst[i] = (float)src[i] * (1.0f / MAX_uint8);
+        break;
+    case Formats::UNorm16:
+        for (int32 i = 0; i < count; i++)
+            dst[i] = (float)((const uint16*)src)[i] * (1.0f / MAX_uint16);
+        break;
+    default:
+        Platform::MemoryCopy(value, src, GetValueSize());
+        break;
+    }
+}
+
+void ParticleAttribute::Store(byte* dst, const void* value) const
+{
+    const float* src = (const float*)value;
+    const int32 count = GetComponentsCount();
+    switch (Format)
+    {
+    case Formats::Half:
+        for (int32 i = 0; i < count; i++)
+            ((uint16*)dst)[i] = EncodeHalf(src[i]);
+        break;
+    case Formats::UNorm8:
+        for (int32 i = 0; i < count; i++)
+            dst[i] = (byte)Math::RoundToInt(Math::Saturate(src[i]) * MAX_uint8);
+        break;
+    case Formats::UNorm16:
+        for (int32 i = 0; i < count; i++)
+            ((uint16*)dst)[i] = (uint16)Math::RoundToInt(Math::Saturate(src[i]) * MAX_uint16);
+        break;
+    default:
+        Platform::MemoryCopy(dst, value, GetValueSize());
+        break;
+    }
+}
+
 ParticleBuffer::ParticleBuffer()
 {
 }
@@ -40,6 +175,13 @@ bool ParticleBuffer::Init(ParticleEmitter* emitter)
         CPU.Count = 0;
         CPU.Buffer.Resize(size);
         CPU.RibbonOrder.Resize(0);
+        Platform::MemoryClear(CPU.Ribbons, sizeof(CPU.Ribbons));
+        CPU.SortedIndices.Resize(0);
+        CPU.Sorting.Resize(0);
+        CPU.DataVersion = 1;
+        CPU.DrawDataVersion = 0;
+        CPU.LastFrameDrawn = 0;
+        GPU.UploadedDataVersion = 0;
         GPU.Buffer = GPUDevice::Instance->CreateBuffer(TEXT("ParticleBuffer"));
         if (GPU.Buffer->Init(GPUBufferDescription::Raw(size, GPUBufferFlags::ShaderResource, GPUResourceUsage::Dynamic)))
             return true;
@@ -121,6 +263,7 @@ void ParticleBuffer::Clear()
     {
         CPU.Count = 0;
         CPU.RibbonOrder.Clear();
+        CPU.DataVersion++;
         break;
     }
 #if COMPILE_WITH_GPU_PARTICLES
@@ -5,6 +5,7 @@
 #include "Engine/Core/Types/String.h"
 #include "Engine/Core/Types/StringView.h"
 #include "Engine/Core/Collections/Array.h"
+#include "Engine/Core/Math/Matrix.h"
 #include "Types.h"
 
 // The maximum amount of particle attributes to use
@@ -34,11 +35,31 @@ struct ParticleAttribute
         Uint,
     };
 
+    /// <summary>
+    /// The attribute data storage formats. Quantized formats are supported only by the floating-point attributes on CPU particles and are decoded to floats on access.
+    /// </summary>
+    enum class Formats
+    {
+        // Full 32-bit components (value stored as-is).
+        Default,
+        // 16-bit floating-point components.
+        Half,
+        // 8-bit unsigned normalized components (values clamped to 0-1 range).
+        UNorm8,
+        // 16-bit unsigned normalized components (values clamped to 0-1 range).
+        UNorm16,
+    };
+
     /// <summary>
     /// The attribute value container type.
     /// </summary>
     ValueTypes ValueType;
 
+    /// <summary>
+    /// The attribute data storage format.
+    /// </summary>
+    Formats Format;
+
     /// <summary>
     /// The attribute offset from particle data start (in bytes).
     /// </summary>
@@ -50,27 +71,145 @@ struct ParticleAttribute
     String Name;
 
     /// <summary>
-    /// Gets the size of the attribute (in bytes).
+    /// Gets the amount of the attribute value components.
     /// </summary>
-    /// <returns>The size (in bytes).</returns>
-    int32 GetSize() const
+    /// <returns>The components count.</returns>
+    int32 GetComponentsCount() const
     {
         switch (ValueType)
         {
         case ValueTypes::Float2:
-            return 8;
+            return 2;
         case ValueTypes::Float3:
-            return 12;
+            return 3;
         case ValueTypes::Float4:
-            return 16;
+            return 4;
         case ValueTypes::Float:
         case ValueTypes::Int:
         case ValueTypes::Uint:
-            return 4;
+            return 1;
         default:
             return 0;
         }
     }
+
+    /// <summary>
+    /// Gets the size of the attribute value (in bytes) when decoded from the storage format.
+    /// </summary>
+    /// <returns>The size (in bytes).</returns>
+    int32 GetValueSize() const
+    {
+        return GetComponentsCount() * 4;
+    }
+
+    /// <summary>
+    /// Gets the size of the attribute data (in bytes) in the particle buffer. Aligned to 4 bytes so GPU can read it from the raw buffer.
+    /// </summary>
+    /// <returns>The size (in bytes).</returns>
+    int32 GetSize() const
+    {
+        switch (Format)
+        {
+        case Formats::Half:
+        case Formats::UNorm16:
+            return (GetComponentsCount() * 2 + 3) & ~3;
+        case Formats::UNorm8:
+            return 4;
+        default:
+            return GetValueSize();
+        }
+    }
+
+    /// <summary>
+    /// Gets the attribute offset for the particle material shaders. The storage format is encoded in the upper 8 bits (decoded by the GetParticle* functions in shaders).
+    /// </summary>
+    /// <returns>The encoded offset.</returns>
+    FORCE_INLINE int32 GetShaderOffset() const
+    {
+        return Offset | ((int32)Format << 24);
+    }
+
+    // Lookup tables for the half precision conversion (initialized in ParticlesData.cpp)
+    static FLAXENGINE_API uint16 HalfBaseTable[512];
+    static FLAXENGINE_API byte HalfShiftTable[512];
+    static FLAXENGINE_API uint32 HalfMantissaTable[2048];
+    static FLAXENGINE_API uint32 HalfExponentTable[64];
+    static FLAXENGINE_API uint16 HalfOffsetTable[64];
+
+    /// <summary>
+    /// Converts the single precision float into the half precision float (rounds towards zero, out of range values become infinity). Table-based to keep the per-particle cost low.
+    /// </summary>
+    FORCE_INLINE static uint16 EncodeHalf(float value)
+    {
+        const uint32 bits = *(const uint32*)&value;
+        const uint32 index = bits >> 23;
+        return (uint16)(HalfBaseTable[index] + ((bits & 0x007fffff) >> HalfShiftTable[index]));
+    }
+
+    /// <summary>
+    /// Converts the half precision float into the single precision float.
+    /// </summary>
+    FORCE_INLINE static float DecodeHalf(uint16 value)
+    {
+        const uint32 bits = HalfMantissaTable[HalfOffsetTable[value >> 10] + (value & 0x3ff)] + HalfExponentTable[value >> 10];
+        return *(const float*)&bits;
+    }
+
+    /// <summary>
+    /// Decodes the attribute value from the storage format.
+    /// </summary>
+    /// <param name="src">The attribute data (in the particle buffer).</param>
+    /// <param name="value">The output value (GetValueSize bytes).</param>
+    void Load(const byte* src, void* value) const;
+
+    /// <summary>
+    /// Encodes the attribute value into the storage format.
+    /// </summary>
+    /// <param name="dst">The attribute data (in the particle buffer).</param>
+    /// <param name="value">The input value (GetValueSize bytes).</param>
+    void Store(byte* dst, const void* value) const;
+
+    /// <summary>
+    /// Reads the attribute value (decodes it if uses quantized storage format).
+    /// </summary>
+    /// <param name="src">The attribute data (in the particle buffer).</param>
+    /// <returns>The value.</returns>
+    template<typename T>
+    FORCE_INLINE T Read(const byte* src) const
+    {
+        if (Format == Formats::Default)
+            return *(const T*)src;
+        T result;
+        if (Format == Formats::Half)
+        {
+            for (int32 i = 0; i < (int32)(sizeof(T) / sizeof(float)); i++)
+                ((float*)&result)[i] = DecodeHalf(((const uint16*)src)[i]);
+        }
+        else
+            Load(src, &result);
+        return result;
+    }
+
+    /// <summary>
+    /// Writes the attribute value (encodes it if uses quantized storage format).
+    /// </summary>
+    /// <param name="dst">The attribute data (in the particle buffer).</param>
+    /// <param name="value">The value.</param>
+    template<typename T>
+    FORCE_INLINE void Write(byte* dst, const T& value) const
+    {
+        if (Format == Formats::Default)
+        {
+            *(T*)dst = value;
+        }
+        else if (Format == Formats::Half)
+        {
+            for (int32 i = 0; i < (int32)(sizeof(T) / sizeof(float)); i++)
+                ((uint16*)dst)[i] = EncodeHalf(((const float*)&value)[i]);
+        }
+        else
+            Store(dst, &value);
+    }
 };
 
 /// <summary>
@@ -195,6 +334,31 @@ class ParticleLayout
         return index != -1 ? Attributes[index].Offset : fallbackValue;
     }
 
+    /// <summary>
+    /// Finds the attribute offset (with encoded storage format) for the particle material shaders by the name.
+    /// </summary>
+    /// <param name="name">The name.</param>
+    /// <param name="fallbackValue">The fallback value to return if attribute is missing.</param>
+    /// <returns>The attribute shader offset or fallback value if cannot find it.</returns>
+    int32 FindAttributeShaderOffset(const StringView& name, int32 fallbackValue = 0) const
+    {
+        const int32 index = FindAttribute(name);
+        return index != -1 ? Attributes[index].GetShaderOffset() : fallbackValue;
+    }
+
+    /// <summary>
+    /// Finds the attribute offset (with encoded storage format) for the particle material shaders by the name and type.
+    /// </summary>
+    /// <param name="name">The name.</param>
+    /// <param name="valueType">The type.</param>
+    /// <param name="fallbackValue">The fallback value to return if attribute is missing.</param>
+    /// <returns>The attribute shader offset or fallback value if cannot find it.</returns>
+    int32 FindAttributeShaderOffset(const StringView& name, ParticleAttribute::ValueTypes valueType, int32 fallbackValue = 0) const
+    {
+        const int32 index = FindAttribute(name, valueType);
+        return index != -1 ? Attributes[index].GetShaderOffset() : fallbackValue;
+    }
+
     /// <summary>
     /// Adds the attribute with the given name and value type.
     /// </summary>
@@ -206,8 +370,24 @@ class ParticleLayout
         auto& a = Attributes.AddOne();
         a.Name = String(*name, name.Length());
         a.ValueType = valueType;
+        a.Format = ParticleAttribute::Formats::Default;
         return Attributes.Count() - 1;
     }
+
+    /// <summary>
+    /// Sets the attribute data storage format. Call UpdateLayout after to refresh the attributes offsets.
+    /// </summary>
+    /// <param name="index">The attribute index.</param>
+    /// <param name="format">The storage format.</param>
+    /// <returns>True if failed (quantized formats are supported only by the floating-point attributes), otherwise false.</returns>
+    bool SetAttributeFormat(int32 index, ParticleAttribute::Formats format)
+    {
+        auto& a = Attributes[index];
+        if (format != ParticleAttribute::Formats::Default && (a.ValueType == ParticleAttribute::ValueTypes::Int || a.ValueType == ParticleAttribute::ValueTypes::Uint))
+            return true;
+        a.Format = format;
+        return false;
+    }
 };
 
 /// <summary>
@@ -246,6 +426,28 @@ class FLAXENGINE_API ParticleBuffer
     /// </summary>
     ParticleLayout* Layout = nullptr;
 
+    /// <summary>
+    /// The ribbon module geometry range.
+    /// </summary>
+    struct RibbonDrawData
+    {
+        uint32 VerticesOffset;
+        int32 IndicesStart;
+        int32 IndicesCount;
+        int32 SegmentCount;
+    };
+
+    /// <summary>
+    /// The CPU particles sorting state.
+    /// </summary>
+    struct SortingCache
+    {
+        // The particles data version that has been sorted.
+        uint32 DataVersion;
+        // The particle position transformation used to compute sort keys (view-dependent sorting only).
+        Matrix Transform;
+    };
+
     struct
     {
         /// <summary>
@@ -262,6 +464,36 @@ class FLAXENGINE_API ParticleBuffer
         /// The sorted ribbon particles indices (CPU side). Cached after system update and reused during rendering (batched for all ribbon modules).
         /// </summary>
         Array<int32> RibbonOrder;
+
+        /// <summary>
+        /// The ribbon modules geometry ranges within the ribbon index buffer (per ribbon module). Built after system update and reused during rendering by all views.
+        /// </summary>
+        RibbonDrawData Ribbons[PARTICLE_EMITTER_MAX_RIBBONS];
+
+        /// <summary>
+        /// The sorted particles indices (CPU side). Each sorting module from the emitter uses a dedicated range of Capacity elements (the same as GPU.SortedIndices).
+        /// </summary>
+        Array<int32> SortedIndices;
+
+        /// <summary>
+        /// The sorting state of each sorting module. Used to skip sorting for views that share the same sorting input.
+        /// </summary>
+        Array<SortingCache> Sorting;
+
+        /// <summary>
+        /// The particles data version. Incremented after every simulation update. Used to upload data to the GPU only once after it gets modified.
+        /// </summary>
+        uint32 DataVersion;
+
+        /// <summary>
+        /// The particles data version used to build the view-independent drawing data (custom sorting and ribbons geometry). Building is skipped after simulation update for the emitters that were not drawn recently and done on the next draw instead.
+        /// </summary>
+        uint32 DrawDataVersion;
+
+        /// <summary>
+        /// The last frame when the particles were drawn (see Engine::FrameCount).
+        /// </summary>
+        uint64 LastFrameDrawn;
     } CPU;
 
     struct
@@ -322,6 +554,11 @@ class FLAXENGINE_API ParticleBuffer
         /// </summary>
         uint32 ParticleCounterOffset;
 
+        /// <summary>
+        /// The version of the CPU particles data uploaded to the GPU buffers (see CPU.DataVersion).
+        /// </summary>
+        uint32 UploadedDataVersion;
+
         /// <summary>
         /// The maximum amount of particles that 'might' be in the buffer. During every simulation update we spawn a certain amount of particles and update existing ones. We can estimate limit for the current particles count to dispatch less threads for particles update.
         /// </summary>
@@ -2,6 +2,9 @@
 
 #pragma once
 
+#include "Engine/Core/Math/Vector3.h"
+#include "Engine/Core/Math/Quaternion.h"
+
 /// <summary>
 /// A base interface for all physical actors types/owners that can responds on transformation changed event.
 /// </summary>
@@ -25,4 +28,17 @@ class FLAXENGINE_API IPhysicsActor
     /// This event is called internally by the Physics service and should not be used by the others.
     /// </remarks>
     virtual void OnActiveTransformChanged() = 0;
+
+    /// <summary>
+    /// Called when actor's active transformation gets changed after the physics simulation step. Receives the simulated world-space pose that was gathered by the physics backend (can be done in parallel for many actors).
+    /// </summary>
+    /// <remarks>
+    /// This event is called internally by the Physics service and should not be used by the others.
+    /// </remarks>
+    /// <param name="position">The world-space position of the physics actor.</param>
+    /// <param name="orientation">The world-space orientation of the physics actor.</param>
+    virtual void OnActiveTransformChanged(const Vector3& position, const Quaternion& orientation)
+    {
+        OnActiveTransformChanged();
+    }
 };
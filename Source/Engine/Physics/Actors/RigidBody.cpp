@@ -443,13 +443,19 @@ void* RigidBody::GetPhysicsActor() const
 }
 
 void RigidBody::OnActiveTransformChanged()
+{
+    Vector3 position;
+    Quaternion orientation;
+    PhysicsBackend::GetRigidActorPose(_actor, position, orientation);
+    OnActiveTransformChanged(position, orientation);
+}
+
+void RigidBody::OnActiveTransformChanged(const Vector3& position, const Quaternion& orientation)
 {
     // Change actor transform (but with locking)
     ASSERT(!_isUpdatingTransform);
     _isUpdatingTransform = true;
-    Transform transform;
-    PhysicsBackend::GetRigidActorPose(_actor, transform.Translation, transform.Orientation);
-    transform.Scale = _transform.Scale;
+    Transform transform(position, orientation, _transform.Scale);
     if (_parent)
     {
         _parent->GetTransform().WorldToLocal(transform, _localTransform);
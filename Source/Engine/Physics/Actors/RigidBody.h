@@ -491,6 +491,7 @@ class FLAXENGINE_API RigidBody : public Actor, public IPhysicsActor
     // [IPhysicsActor]
     void* GetPhysicsActor() const override;
     void OnActiveTransformChanged() override;
+    void OnActiveTransformChanged(const Vector3& position, const Quaternion& orientation) override;
 
 protected:
     // [Actor]
@@ -450,6 +450,8 @@ void WheeledVehicle::Serialize(SerializeStream& stream, const void* otherObj)
     SERIALIZE_MEMBER(DriveControl, _driveControl);
     SERIALIZE(UseReverseAsBrake);
     SERIALIZE(UseAnalogSteering);
+    SERIALIZE(UpdateInterval);
+    SERIALIZE(UpdateIntervalDistance);
     SERIALIZE_MEMBER(Engine, _engine);
     SERIALIZE_MEMBER(Differential, _differential);
     SERIALIZE_MEMBER(Gearbox, _gearbox);
@@ -465,6 +467,8 @@ void WheeledVehicle::Deserialize(DeserializeStream& stream, ISerializeModifier*
     DESERIALIZE_MEMBER(DriveControl, _driveControl);
     DESERIALIZE(UseReverseAsBrake);
     DESERIALIZE(UseAnalogSteering);
+    DESERIALIZE(UpdateInterval);
+    DESERIALIZE(UpdateIntervalDistance);
     DESERIALIZE_MEMBER(Engine, _engine);
     DESERIALIZE_MEMBER(Differential, _differential);
     DESERIALIZE_MEMBER(Gearbox, _gearbox);
@@ -509,6 +513,9 @@ void WheeledVehicle::OnPhysicsSceneChanged(PhysicsScene* previous)
 
 void WheeledVehicle::OnTransformChanged()
 {
+    // Wheels transformation gets updated within the hierarchy
+    _wheelsTransformDirty = false;
+
     RigidBody::OnTransformChanged();
 
     // Initially vehicles were using X axis as forward which was kind of bad idea as engine uses Z as forward
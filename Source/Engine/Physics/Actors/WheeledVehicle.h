@@ -13,6 +13,7 @@
 API_CLASS(Attributes="ActorContextMenu(\"New/Physics/Wheeled Vehicle\"), ActorToolbox(\"Physics\")") class FLAXENGINE_API WheeledVehicle : public RigidBody
 {
     friend class PhysicsBackend;
+    friend struct ScenePhysX;
     DECLARE_SCENE_OBJECT(WheeledVehicle);
 
     /// <summary>
@@ -449,6 +450,9 @@ API_CLASS(Attributes="ActorContextMenu(\"New/Physics/Wheeled Vehicle\"), ActorTo
     GearboxSettings _gearbox;
     bool _fixInvalidForwardDir = false; // [Deprecated on 13.06.2023, expires on 13.06.2025]
     bool _useWheelsUpdates = true;
+    bool _wheelsTransformDirty = false;
+    int32 _simulationFrame = 0;
+    float _simulationTime = 0.0f;
 
 public:
     /// <summary>
@@ -463,6 +467,18 @@ API_CLASS(Attributes="ActorContextMenu(\"New/Physics/Wheeled Vehicle\"), ActorTo
     API_FIELD(Attributes="EditorOrder(1), EditorDisplay(\"Vehicle\")")
     bool UseAnalogSteering = false;
 
+    /// <summary>
+    /// The vehicle simulation update interval (in physics steps) used when the vehicle is further than UpdateIntervalDistance from the main camera. Can be increased for less important vehicles (eg. traffic) to simulate them less frequently (with accumulated time step). Suspension and tire forces are applied only on the vehicle update steps while the body is simulated every step, so such vehicles can sag and jitter slightly. Sleeping vehicles without any input are not simulated at all.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(3), Limit(1, 60), EditorDisplay(\"Vehicle\")")
+    int32 UpdateInterval = 1;
+
+    /// <summary>
+    /// The minimum distance from the main camera at which the vehicle uses UpdateInterval. Closer vehicles (or all vehicles if there is no main camera) are simulated every physics step.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(4), Limit(0), EditorDisplay(\"Vehicle\")")
+    float UpdateIntervalDistance = 5000.0f;
+
     /// <summary>
     /// Gets the vehicle driving model type.
     /// </summary>
@@ -206,6 +206,7 @@ class FLAXENGINE_API CharacterController : public Collider, public IPhysicsActor
     RigidBody* GetAttachedRigidBody() const override;
 
     // [IPhysicsActor]
+    using IPhysicsActor::OnActiveTransformChanged;
     void OnActiveTransformChanged() override;
     void* GetPhysicsActor() const override;
 
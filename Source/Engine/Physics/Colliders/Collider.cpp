@@ -31,6 +31,14 @@ void* Collider::GetPhysicsShape() const
     return _shape;
 }
 
+bool Collider::SetSimulatedLocalTransform(const Transform& value)
+{
+    if (Vector3::NearEqual(_localTransform.Translation, value.Translation) && Quaternion::NearEqual(_localTransform.Orientation, value.Orientation, ACTOR_ORIENTATION_EPSILON) && Float3::NearEqual(_localTransform.Scale, value.Scale))
+        return false;
+    _localTransform = value;
+    return true;
+}
+
 void Collider::SetIsTrigger(bool value)
 {
     if (value == _isTrigger || !CanBeTrigger())
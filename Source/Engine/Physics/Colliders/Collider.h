@@ -35,6 +35,13 @@ API_CLASS(Abstract) class FLAXENGINE_API Collider : public PhysicsColliderActor
     /// </summary>
     void* GetPhysicsShape() const;
 
+    /// <summary>
+    /// Sets the local transformation of the collider that has been already applied to the physics shape by the simulation (eg. vehicle wheel). Doesn't call transform changed event so the actor hierarchy update needs to propagate it. Can be called from the job thread.
+    /// </summary>
+    /// <param name="value">The local transformation.</param>
+    /// <returns>True if transformation has been modified, otherwise false.</returns>
+    bool SetSimulatedLocalTransform(const Transform& value);
+
     /// <summary>
     /// Gets the 'IsTrigger' flag. A trigger doesn't register a collision with an incoming Rigidbody. Instead, it sends OnTriggerEnter and OnTriggerExit message when a rigidbody enters or exits the trigger volume.
     /// </summary>
@@ -9,6 +9,243 @@
 #include "Engine/Threading/Threading.h"
 #include "Engine/Profiler/ProfilerCPU.h"
 #include "Engine/Core/Log.h"
+#include "Engine/Engine/Globals.h"
+#include "Engine/Physics/PhysicsSettings.h"
+#include "Engine/Platform/CriticalSection.h"
+#include "Engine/Platform/File.h"
+#include "Engine/Platform/FileSystem.h"
+#include "Engine/Core/Collections/Sorting.h"
+#include "FlaxEngine.Gen.h"
+
+// Version of the cooked collision cache entries format (increment to invalidate all cached data)
+#define COLLISION_CACHE_VERSION 2
+
+// Maximum size of the cooked collision cache on disk (oldest entries are removed when it's exceeded)
+#define COLLISION_CACHE_MAX_SIZE (256ull * 1024 * 1024)
+
+namespace
+{
+    // Cache entry file header. Followed by the source vertices, source indices and the cooked data.
+    struct CollisionCacheHeader
+    {
+        int32 EngineVersion;
+        int32 CacheVersion;
+        uint64 CookingParamsHash;
+        int32 Type;
+        int32 ConvexFlags;
+        int32 ConvexVertexLimit;
+        int32 VertexCount;
+        int32 IndexCount;
+        int32 IndexStride;
+    };
+
+    // MurmurHash64A (streamed over many buffers).
+    struct CollisionCacheHasher
+    {
+        static constexpr uint64 M = 0xc6a4a7935bd1e995ull;
+        uint64 Hash = 0x8445d61a4e774912ull;
+
+        void Mix(uint64 k)
+        {
+            k *= M;
+            k ^= k >> 47;
+            k *= M;
+            Hash ^= k;
+            Hash *= M;
+        }
+
+        void Update(const void* data, uint64 size)
+        {
+            const byte* ptr = (const byte*)data;
+            for (; size >= 8; size -= 8, ptr += 8)
+            {
+                uint64 k;
+                Platform::MemoryCopy(&k, ptr, 8);
+                Mix(k);
+            }
+            if (size != 0)
+            {
+                uint64 k = 0;
+                Platform::MemoryCopy(&k, ptr, size);
+                Mix(k ^ (size << 56));
+            }
+        }
+
+        uint64 Finalize()
+        {
+            uint64 h = Hash;
+            h ^= h >> 47;
+            h *= M;
+            h ^= h >> 47;
+            return h;
+        }
+    };
+
+    CriticalSection CollisionCacheLocker;
+    String CollisionCacheFolder;
+    int64 CollisionCacheSize = -1;
+    volatile int64 CollisionCacheTrimming = 0;
+
+    void GetCollisionCacheHeader(CollisionDataType type, const CollisionCooking::CookingInput& input, CollisionCacheHeader& header)
+    {
+        Platform::MemoryClear(&header, sizeof(header));
+        header.EngineVersion = FLAXENGINE_VERSION_BUILD;
+        header.CacheVersion = COLLISION_CACHE_VERSION;
+        header.CookingParamsHash = CollisionCooking::GetCookingParamsHash();
+        header.Type = (int32)type;
+        header.ConvexFlags = (int32)input.ConvexFlags;
+        header.ConvexVertexLimit = input.ConvexVertexLimit;
+        header.VertexCount = input.VertexCount;
+        header.IndexCount = input.IndexData ? input.IndexCount : 0;
+        header.IndexStride = input.Is16bitIndexData ? sizeof(uint16) : sizeof(uint32);
+    }
+
+    String GetCollisionCachePath(const CollisionCacheHeader& header, const CollisionCooking::CookingInput& input, String& folder)
+    {
+        PROFILE_CPU();
+        CollisionCacheLocker.Lock();
+        if (CollisionCacheFolder.IsEmpty())
+        {
+#if USE_EDITOR
+            CollisionCacheFolder = Globals::ProjectCacheFolder / TEXT("Physics/Cache");
+#else
+            CollisionCacheFolder = Globals::ProductLocalFolder / TEXT("Physics/Cache");
+#endif
+        }
+        folder = CollisionCacheFolder;
+        CollisionCacheLocker.Unlock();
+
+        // Hash the whole cooking input (header includes the cooking options and params)
+        CollisionCacheHasher hasher;
+        hasher.Update(&header, sizeof(header));
+        hasher.Update(input.VertexData, (uint64)header.VertexCount * sizeof(Float3));
+        hasher.Update(input.IndexData, (uint64)header.IndexCount * header.IndexStride);
+        return folder / String::Format(TEXT("{0:016x}"), hasher.Finalize());
+    }
+
+    bool LoadCachedCollision(CollisionDataType type, const CollisionCooking::CookingInput& input, BytesContainer& output)
+    {
+        PROFILE_CPU();
+        CollisionCacheHeader header;
+        GetCollisionCacheHeader(type, input, header);
+        String folder;
+        const String path = GetCollisionCachePath(header, input, folder);
+        if (!FileSystem::FileExists(path))
+            return true;
+        Array<byte> data;
+        if (File::ReadAllBytes(path, data))
+            return true;
+
+        // Verify the source geometry to never use the data cooked from a different input (eg. on hash collision)
+        const int32 vertexSize = header.VertexCount * sizeof(Float3);
+        const int32 indexSize = header.IndexCount * header.IndexStride;
+        const int32 sourceSize = sizeof(header) + vertexSize + indexSize;
+        if (data.Count() <= sourceSize ||
+            Platform::MemoryCompare(data.Get(), &header, sizeof(header)) != 0 ||
+            Platform::MemoryCompare(data.Get() + sizeof(header), input.VertexData, vertexSize) != 0 ||
+            (indexSize != 0 && Platform::MemoryCompare(data.Get() + sizeof(header) + vertexSize, input.IndexData, indexSize) != 0))
+            return true;
+        output.Copy(data.Get() + sourceSize, data.Count() - sourceSize);
+        return false;
+    }
+
+    void TrimCollisionCache(const String& folder)
+    {
+        PROFILE_CPU();
+        Array<String> files;
+        FileSystem::DirectoryGetFiles(files, folder, TEXT("*"), DirectorySearchOption::TopDirectoryOnly);
+        struct Entry
+        {
+            String Path;
+            DateTime Time;
+            uint64 Size;
+
+            bool operator<(const Entry& other) const
+            {
+                return Time < other.Time;
+            }
+        };
+        Array<Entry> entries;
+        entries.EnsureCapacity(files.Count());
+        uint64 size = 0;
+        for (const String& file : files)
+        {
+            Entry& e = entries.AddOne();
+            e.Path = file;
+            e.Time = FileSystem::GetFileLastEditTime(file);
+            e.Size = FileSystem::GetFileSize(file);
+            size += e.Size;
+        }
+
+        // Remove the oldest entries to go below 75% of the limit
+        if (size > COLLISION_CACHE_MAX_SIZE)
+        {
+            Sorting::QuickSort(entries);
+            for (int32 i = 0; i < entries.Count() && size > COLLISION_CACHE_MAX_SIZE * 3 / 4; i++)
+            {
+                if (!FileSystem::DeleteFile(entries[i].Path))
+                    size -= entries[i].Size;
+            }
+        }
+
+        CollisionCacheLocker.Lock();
+        CollisionCacheSize = (int64)size;
+        CollisionCacheLocker.Unlock();
+    }
+
+    void SaveCachedCollision(CollisionDataType type, const CollisionCooking::CookingInput& input, const BytesContainer& cooked)
+    {
+        PROFILE_CPU();
+        CollisionCacheHeader header;
+        GetCollisionCacheHeader(type, input, header);
+        String folder;
+        const String path = GetCollisionCachePath(header, input, folder);
+        if (!FileSystem::DirectoryExists(folder) && FileSystem::CreateDirectory(folder))
+        {
+            LOG(Warning, "Failed to create the cooked collision cache directory.");
+            return;
+        }
+
+        // Store the source geometry next to the cooked data to verify it when loading
+        const int32 vertexSize = header.VertexCount * sizeof(Float3);
+        const int32 indexSize = header.IndexCount * header.IndexStride;
+        Array<byte> data;
+        data.Resize(sizeof(header) + vertexSize + indexSize + cooked.Length());
+        byte* ptr = data.Get();
+        Platform::MemoryCopy(ptr, &header, sizeof(header));
+        ptr += sizeof(header);
+        Platform::MemoryCopy(ptr, input.VertexData, vertexSize);
+        ptr += vertexSize;
+        if (indexSize != 0)
+            Platform::MemoryCopy(ptr, input.IndexData, indexSize);
+        ptr += indexSize;
+        Platform::MemoryCopy(ptr, cooked.Get(), cooked.Length());
+
+        // Write to the temporary file and then move it so other threads or processes never read a partially written entry
+        const String tmpPath = path + String::Format(TEXT(".{0}.tmp"), Platform::GetCurrentThreadID());
+        if (File::WriteAllBytes(tmpPath, data) || FileSystem::MoveFile(path, tmpPath, true))
+        {
+            FileSystem::DeleteFile(tmpPath);
+            LOG(Warning, "Failed to save the cooked collision to cache.");
+            return;
+        }
+
+        // Keep the cache size bounded (size is calculated on the first save in the session)
+        CollisionCacheLocker.Lock();
+        bool trim = CollisionCacheSize < 0;
+        if (!trim)
+        {
+            CollisionCacheSize += data.Count();
+            trim = CollisionCacheSize > (int64)COLLISION_CACHE_MAX_SIZE;
+        }
+        CollisionCacheLocker.Unlock();
+        if (trim && Platform::InterlockedCompareExchange(&CollisionCacheTrimming, 1, 0) == 0)
+        {
+            TrimCollisionCache(folder);
+            Platform::AtomicStore(&CollisionCacheTrimming, 0);
+        }
+    }
+}
 
 bool CollisionCooking::CookCollision(const Argument& arg, CollisionData::SerializedOptions& outputOptions, BytesContainer& outputData)
 {
@@ -257,21 +494,28 @@ bool CollisionCooking::CookCollision(const Argument& arg, CollisionData::Seriali
     cookingInput.ConvexFlags = arg.ConvexFlags;
     cookingInput.ConvexVertexLimit = convexVertexLimit;
 
-    // Cook!
-    if (arg.Type == CollisionDataType::ConvexMesh)
+    // Try to reuse collision cooked from the same geometry (eg. in the previous game session)
+    const bool useCache = PhysicsSettings::Get()->CacheCookingAtRuntime && arg.Type != CollisionDataType::None && cookingInput.VertexCount != 0;
+    if (!useCache || LoadCachedCollision(arg.Type, cookingInput, outputData))
     {
-        if (CookConvexMesh(cookingInput, outputData))
-            return true;
-    }
-    else if (arg.Type == CollisionDataType::TriangleMesh)
-    {
-        if (CookTriangleMesh(cookingInput, outputData))
+        // Cook!
+        if (arg.Type == CollisionDataType::ConvexMesh)
+        {
+            if (CookConvexMesh(cookingInput, outputData))
+                return true;
+        }
+        else if (arg.Type == CollisionDataType::TriangleMesh)
+        {
+            if (CookTriangleMesh(cookingInput, outputData))
+                return true;
+        }
+        else
+        {
+            LOG(Warning, "Invalid collision data type.");
             return true;
-    }
-    else
-    {
-        LOG(Warning, "Invalid collision data type.");
-        return true;
+        }
+        if (useCache)
+            SaveCachedCollision(arg.Type, cookingInput, outputData);
     }
 
     // Setup options
@@ -62,6 +62,12 @@ class CollisionCooking
     /// <returns>True if failed, otherwise false.</returns>
     static bool CookTriangleMesh(CookingInput& input, BytesContainer& output);
 
+    /// <summary>
+    /// Gets the hash of the physics backend cooking parameters and version. Used to invalidate collision cooked with different settings.
+    /// </summary>
+    /// <returns>The cooking parameters hash (0 if cooking is not supported).</returns>
+    static uint64 GetCookingParamsHash();
+
     /// <summary>
     /// Cooks a heightfield. The results are written to the stream. To create a heightfield object there is an option to precompute some of calculations done while loading the heightfield data.
     /// </summary>
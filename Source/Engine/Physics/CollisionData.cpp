@@ -10,6 +10,8 @@
 #include "Engine/Physics/CollisionCooking.h"
 #include "Engine/Profiler/ProfilerCPU.h"
 #include "Engine/Threading/Threading.h"
+#include "Engine/Threading/ThreadPoolTask.h"
+#include "Engine/Threading/MainThreadTask.h"
 
 REGISTER_BINARY_ASSET(CollisionData, "FlaxEngine.CollisionData", true);
 
@@ -51,14 +53,7 @@ bool CollisionData::CookCollision(CollisionDataType type, ModelBase* modelObj, i
     if (CollisionCooking::CookCollision(arg, options, outputData))
         return true;
 
-    // Load data
-    unload(true);
-    if (load(&options, outputData.Get(), outputData.Length()) != LoadResult::Ok)
-        return true;
-
-    // Mark as loaded (eg. Mesh Colliders using this asset will update shape for physics simulation)
-    onLoaded();
-    return false;
+    return setCookedData(options, outputData);
 }
 
 bool CollisionData::CookCollision(CollisionDataType type, const Span<Float3>& vertices, const Span<uint32>& triangles, ConvexMeshGenerationFlags convexFlags, int32 convexVertexLimit)
@@ -113,15 +108,49 @@ bool CollisionData::CookCollision(CollisionDataType type, ModelData* modelData,
     if (CollisionCooking::CookCollision(arg, options, outputData))
         return true;
 
-    // Clear state
-    unload(true);
+    return setCookedData(options, outputData);
+}
 
-    // Load data
-    if (load(&options, outputData.Get(), outputData.Length()) != LoadResult::Ok)
-        return true;
+Task* CollisionData::CookCollisionAsync(CollisionDataType type, const Span<Float3>& vertices, const Span<uint32>& triangles, ConvexMeshGenerationFlags convexFlags, int32 convexVertexLimit)
+{
+    CHECK_RETURN(vertices.Length() != 0, nullptr);
+    CHECK_RETURN(triangles.Length() != 0 && triangles.Length() % 3 == 0, nullptr);
+    if (!IsVirtual())
+    {
+        LOG(Warning, "Only virtual assets can be modified at runtime.");
+        return nullptr;
+    }
+
+    // Copy geometry to be used by the cooking job (many tasks can cook collision at once)
+    Array<Float3> vertexData(vertices.Get(), vertices.Length());
+    Array<uint32> indexData(triangles.Get(), triangles.Length());
+    Function<bool()> action = [this, type, vertexData, indexData, convexFlags, convexVertexLimit]
+    {
+        return CookCollision(type, ToSpan(vertexData), ToSpan(indexData), convexFlags, convexVertexLimit);
+    };
+    return New<ThreadPoolActionTask>(action, this);
+}
 
-    // Mark as loaded (eg. Mesh Colliders using this asset will update shape for physics simulation)
-    onLoaded();
+bool CollisionData::setCookedData(const SerializedOptions& options, BytesContainer& data)
+{
+    // Swap the cooked data under the lock so other threads never see the collision unloaded or partially created
+    {
+        ScopeLock lock(Locker);
+        unload(true);
+        if (load(&options, data.Get(), data.Length()) != LoadResult::Ok)
+            return true;
+    }
+
+    // Mark as loaded (eg. Mesh Colliders using this asset will update shape for physics simulation), event is fired on a main thread
+    if (IsInMainThread())
+    {
+        onLoaded();
+    }
+    else
+    {
+        Function<void()> action = [this] { onLoaded(); };
+        Task::StartNew(New<MainThreadActionTask>(action, this));
+    }
     return false;
 }
 
@@ -22,9 +22,12 @@
 #include "Engine/Physics/Joints/D6Joint.h"
 #include "Engine/Physics/Colliders/Collider.h"
 #include "Engine/Platform/CPUInfo.h"
+#include "Engine/Level/Scene/SceneRendering.h"
 #include "Engine/Platform/CriticalSection.h"
 #include "Engine/Profiler/ProfilerCPU.h"
 #include "Engine/Serialization/WriteStream.h"
+#include "Engine/Utilities/Crc.h"
+#include "Engine/Threading/JobSystem.h"
 #include <ThirdParty/PhysX/PxPhysicsAPI.h>
 #include <ThirdParty/PhysX/PxQueryFiltering.h>
 #include <ThirdParty/PhysX/extensions/PxFixedJoint.h>
@@ -32,6 +35,7 @@
 #if WITH_VEHICLE
 #include "Engine/Core/Collections/Sorting.h"
 #include "Engine/Physics/Actors/WheeledVehicle.h"
+#include "Engine/Level/Actors/Camera.h"
 #include <ThirdParty/PhysX/vehicle/PxVehicleSDK.h>
 #include <ThirdParty/PhysX/vehicle/PxVehicleUpdate.h>
 #include <ThirdParty/PhysX/vehicle/PxVehicleNoDrive.h>
@@ -44,7 +48,6 @@
 #endif
 #if WITH_CLOTH
 #include "Engine/Physics/Actors/Cloth.h"
-#include "Engine/Threading/JobSystem.h"
 #include "Engine/Threading/Threading.h"
 #include <ThirdParty/NvCloth/Callbacks.h>
 #include <ThirdParty/NvCloth/Factory.h>
@@ -55,6 +58,7 @@
 #define MAX_CLOTH_SPHERE_COUNT 32
 #define MAX_CLOTH_PLANE_COUNT 32
 #define CLOTH_COLLISIONS_UPDATE_RATE 10 // Frames between cloth collisions updates
+#define CLOTH_MAX_HEIGHTFIELD_TRIANGLES 256 // Limit of triangles gathered from heightfields around the cloth
 #endif
 #if WITH_PVD
 #include <ThirdParty/PhysX/pvd/PxPvd.h>
@@ -72,12 +76,23 @@
 // Temporary result buffer size
 #define PHYSX_HIT_BUFFER_SIZE 128
 
+// Amount of active actors processed by a single job when gathering simulation results (and minimum amount to use jobs at all)
+#define PHYSX_ACTIVE_ACTORS_JOB_BATCH 128
+#define PHYSX_VEHICLES_JOB_BATCH 16
+
 struct ActionDataPhysX
 {
     PhysicsBackend::ActionType Type;
     PxActor* Actor;
 };
 
+struct ActiveTransformPhysX
+{
+    IPhysicsActor* Actor;
+    Vector3 Position;
+    Quaternion Orientation;
+};
+
 struct ScenePhysX
 {
     PxScene* Scene = nullptr;
@@ -92,6 +107,9 @@ struct ScenePhysX
     Array<PhysicsColliderActor*> RemoveColliders;
     Array<Joint*> RemoveJoints;
     Array<ActionDataPhysX> Actions;
+    PxActor** ActiveActors = nullptr;
+    uint32 ActiveActorsCount = 0;
+    Array<ActiveTransformPhysX> ActiveTransforms;
 #if WITH_VEHICLE
     Array<WheeledVehicle*> WheelVehicles;
     PxBatchQueryExt* WheelRaycastBatchQuery = nullptr;
@@ -102,6 +120,11 @@ struct ScenePhysX
     Array<nv::cloth::Cloth*> ClothsList;
 #endif
 
+    void GatherActiveTransforms(int32 i);
+#if WITH_VEHICLE
+    void UpdateVehicles(int32 i);
+    void SyncVehicles(int32 i);
+#endif
 #if WITH_CLOTH
     void PreSimulateCloth(int32 i);
     void SimulateCloth(int32 i);
@@ -189,6 +212,7 @@ struct ClothSettings
     float GravityScale = 1.0f;
     float CollisionThickness = 0.0f;
     Cloth* Actor;
+    Array<PxVec3> CollisionTriangles; // Reused between collisions updates to not allocate memory every time
 
     bool UpdateBounds(const nv::cloth::Cloth* clothPhysX) const
     {
@@ -572,6 +596,11 @@ namespace
     Array<PxVehicleWheels*> WheelVehiclesCache;
     Array<PxWheelQueryResult> WheelVehiclesResultsPerWheel;
     Array<PxVehicleWheelQueryResult> WheelVehiclesResultsPerVehicle;
+    Array<PxVehicleWheelConcurrentUpdateData> WheelVehiclesConcurrentPerWheel;
+    Array<PxVehicleConcurrentUpdateData> WheelVehiclesConcurrentPerVehicle;
+    Array<WheeledVehicle*> WheelVehiclesActive;
+    Array<float> WheelVehiclesDeltaTimes;
+    PxVec3 WheelVehiclesGravity;
     PxVehicleDrivableSurfaceToTireFrictionPairs* WheelTireFrictions = nullptr;
     bool WheelTireFrictionsDirty = false;
     Array<float> WheelTireTypes;
@@ -719,6 +748,90 @@ void InitVehicleSDK()
 
 #endif
 
+void ScenePhysX::GatherActiveTransforms(int32 i)
+{
+    PROFILE_CPU();
+    const uint32 start = (uint32)i * PHYSX_ACTIVE_ACTORS_JOB_BATCH;
+    const uint32 end = Math::Min<uint32>(start + PHYSX_ACTIVE_ACTORS_JOB_BATCH, ActiveActorsCount);
+    for (uint32 index = start; index < end; index++)
+    {
+        const auto pxActor = (PxRigidActor*)ActiveActors[index];
+        auto& e = ActiveTransforms.Get()[index];
+        e.Actor = static_cast<IPhysicsActor*>(pxActor->userData);
+        const PxTransform pose = pxActor->getGlobalPose();
+        e.Position = P2C(pose.p) + Origin;
+        e.Orientation = P2C(pose.q);
+    }
+}
+
+#if WITH_VEHICLE
+
+void ScenePhysX::UpdateVehicles(int32 i)
+{
+    PROFILE_CPU();
+    const int32 start = i * PHYSX_VEHICLES_JOB_BATCH;
+    const int32 end = Math::Min(start + PHYSX_VEHICLES_JOB_BATCH, WheelVehiclesCache.Count());
+    for (int32 index = start; index < end; index++)
+    {
+        PxVehicleUpdates(WheelVehiclesDeltaTimes[index], WheelVehiclesGravity, *WheelTireFrictions, 1, &WheelVehiclesCache[index], &WheelVehiclesResultsPerVehicle[index], &WheelVehiclesConcurrentPerVehicle[index]);
+    }
+}
+
+void ScenePhysX::SyncVehicles(int32 i)
+{
+    PROFILE_CPU();
+    const int32 start = i * PHYSX_VEHICLES_JOB_BATCH;
+    const int32 end = Math::Min(start + PHYSX_VEHICLES_JOB_BATCH, WheelVehiclesCache.Count());
+    for (int32 index = start; index < end; index++)
+    {
+        auto wheelVehicle = WheelVehiclesActive[index];
+        auto drive = WheelVehiclesCache[index];
+        auto& perVehicle = WheelVehiclesResultsPerVehicle[index];
+#if PHYSX_VEHICLE_DEBUG_TELEMETRY
+        LOG(Info, "Vehicle[{}] Gear={}, RPM={}", index, wheelVehicle->GetCurrentGear(), (int32)wheelVehicle->GetEngineRotationSpeed());
+#endif
+
+        // Update wheels
+        const Float3 vehicleScale = wheelVehicle->GetScale();
+        for (int32 j = 0; j < wheelVehicle->_wheelsData.Count(); j++)
+        {
+            auto& wheelData = wheelVehicle->_wheelsData[j];
+            auto& perWheel = perVehicle.wheelQueryResults[j];
+#if PHYSX_VEHICLE_DEBUG_TELEMETRY
+            LOG(Info, "Vehicle[{}] Wheel[{}] longitudinalSlip={}, lateralSlip={}, suspSpringForce={}", index, j, Utilities::RoundTo2DecimalPlaces(perWheel.longitudinalSlip), Utilities::RoundTo2DecimalPlaces(perWheel.lateralSlip), (int32)perWheel.suspSpringForce);
+#endif
+
+            auto& state = wheelData.State;
+            state.IsInAir = perWheel.isInAir;
+            state.TireContactCollider = perWheel.tireContactShape ? static_cast<PhysicsColliderActor*>(perWheel.tireContactShape->userData) : nullptr;
+            state.TireContactPoint = P2C(perWheel.tireContactPoint) + Origin;
+            state.TireContactNormal = P2C(perWheel.tireContactNormal);
+            state.TireFriction = perWheel.tireFriction;
+            state.SteerAngle = RadiansToDegrees * perWheel.steerAngle;
+            state.RotationAngle = -RadiansToDegrees * drive->mWheelsDynData.getWheelRotationAngle(j);
+            state.SuspensionOffset = perWheel.suspJounce;
+#if USE_EDITOR
+            state.SuspensionTraceStart = P2C(perWheel.suspLineStart) + Origin;
+            state.SuspensionTraceEnd = P2C(perWheel.suspLineStart + perWheel.suspLineDir * perWheel.suspLineLength) + Origin;
+#endif
+
+            if (!wheelData.Collider)
+                continue;
+            auto shape = (PxShape*)wheelData.Collider->GetPhysicsShape();
+
+            // Update wheel collider transformation (shape pose is already set by the vehicle so skip transform changed event, vehicle hierarchy update will propagate it)
+            const PxTransform localPose = shape->getLocalPose();
+            Transform t = wheelData.Collider->GetLocalTransform();
+            t.Orientation = Quaternion::Euler(-state.RotationAngle, state.SteerAngle, 0) * wheelData.LocalOrientation;
+            t.Translation = P2C(localPose.p) / vehicleScale - t.Orientation * wheelData.Collider->GetCenter();
+            if (wheelData.Collider->SetSimulatedLocalTransform(t))
+                wheelVehicle->_wheelsTransformDirty = true;
+        }
+    }
+}
+
+#endif
+
 #if WITH_CLOTH
 
 void ScenePhysX::PreSimulateCloth(int32 i)
@@ -758,11 +871,6 @@ void ScenePhysX::PreSimulateCloth(int32 i)
             clothSettings.CollisionsUpdateFramesLeft = i % CLOTH_COLLISIONS_UPDATE_RATE;
         }
 
-        // Reset existing colliders
-        clothPhysX->setSpheres(nv::cloth::Range<const PxVec4>(), 0, clothPhysX->getNumSpheres());
-        clothPhysX->setPlanes(nv::cloth::Range<const PxVec4>(), 0, clothPhysX->getNumPlanes());
-        clothPhysX->setTriangles(nv::cloth::Range<const PxVec3>(), 0, clothPhysX->getNumTriangles());
-
         // Setup environment query
         const bool hitTriggers = false;
         const bool blockSingle = false;
@@ -778,6 +886,15 @@ void ScenePhysX::PreSimulateCloth(int32 i)
         const float boundsMargin = 1.6f; // Pick nearby objects
         const PxSphereGeometry overlapGeo(clothBoundsSize.magnitude() * boundsMargin);
 
+        // Gather colliders into local buffers to submit them at once
+        PxVec4 spheres[MAX_CLOTH_SPHERE_COUNT];
+        uint32_t capsules[MAX_CLOTH_SPHERE_COUNT];
+        PxPlane planes[MAX_CLOTH_PLANE_COUNT];
+        PxU32 convexes[MAX_CLOTH_PLANE_COUNT];
+        uint32_t spheresCount = 0, capsulesCount = 0, planesCount = 0, convexesCount = 0;
+        Array<PxVec3>& triangles = clothSettings.CollisionTriangles;
+        triangles.Clear();
+
         // Find any colliders around the cloth
         DynamicHitBuffer<PxOverlapHit> buffer;
         if (Scene->overlap(overlapGeo, overlapPose, buffer, filterData, &QueryFilter))
@@ -789,79 +906,123 @@ void ScenePhysX::PreSimulateCloth(int32 i)
                 if (hit.shape)
                 {
                     const PxGeometry& geo = hit.shape->getGeometry();
-                    const PxTransform shapeToCloth = clothPose.transformInv(hit.actor->getGlobalPose().transform(hit.shape->getLocalPose()));
-                    // TODO: maybe use shared spheres/planes buffers for batched assigning?
+                    const PxTransform shapePose = hit.actor->getGlobalPose().transform(hit.shape->getLocalPose());
+                    const PxTransform shapeToCloth = clothPose.transformInv(shapePose);
                     switch (geo.getType())
                     {
                     case PxGeometryType::eSPHERE:
                     {
                         const PxSphereGeometry& geoSphere = (const PxSphereGeometry&)geo;
-                        const PxVec4 packedSphere(shapeToCloth.p, geoSphere.radius + collisionThickness);
-                        const nv::cloth::Range<const PxVec4> sphereRange(&packedSphere, &packedSphere + 1);
-                        const uint32_t spheresCount = clothPhysX->getNumSpheres();
                         if (spheresCount + 1 > MAX_CLOTH_SPHERE_COUNT)
                             break;
-                        clothPhysX->setSpheres(sphereRange, spheresCount, spheresCount);
+                        spheres[spheresCount++] = PxVec4(shapeToCloth.p, geoSphere.radius + collisionThickness);
                         break;
                     }
                     case PxGeometryType::eCAPSULE:
                     {
                         const PxCapsuleGeometry& geomCapsule = (const PxCapsuleGeometry&)geo;
-                        const PxVec4 packedSpheres[2] = {
-                            PxVec4(shapeToCloth.transform(PxVec3(+geomCapsule.halfHeight, 0, 0)), geomCapsule.radius + collisionThickness),
-                            PxVec4(shapeToCloth.transform(PxVec3(-geomCapsule.halfHeight, 0, 0)), geomCapsule.radius + collisionThickness)
-                        };
-                        const nv::cloth::Range<const PxVec4> sphereRange(packedSpheres, packedSpheres + 2);
-                        const uint32_t spheresCount = clothPhysX->getNumSpheres();
                         if (spheresCount + 2 > MAX_CLOTH_SPHERE_COUNT)
                             break;
-                        clothPhysX->setSpheres(sphereRange, spheresCount, spheresCount);
-                        const uint32_t packedCapsules[2] = { spheresCount, spheresCount + 1 };
-                        const int32 capsulesCount = clothPhysX->getNumCapsules();
-                        clothPhysX->setCapsules(nv::cloth::Range<const uint32_t>(packedCapsules, packedCapsules + 2), capsulesCount, capsulesCount);
+                        spheres[spheresCount] = PxVec4(shapeToCloth.transform(PxVec3(+geomCapsule.halfHeight, 0, 0)), geomCapsule.radius + collisionThickness);
+                        spheres[spheresCount + 1] = PxVec4(shapeToCloth.transform(PxVec3(-geomCapsule.halfHeight, 0, 0)), geomCapsule.radius + collisionThickness);
+                        capsules[capsulesCount++] = spheresCount;
+                        capsules[capsulesCount++] = spheresCount + 1;
+                        spheresCount += 2;
                         break;
                     }
                     case PxGeometryType::eBOX:
                     {
                         const PxBoxGeometry& geomBox = (const PxBoxGeometry&)geo;
-                        const uint32_t planesCount = clothPhysX->getNumPlanes();
                         if (planesCount + 6 > MAX_CLOTH_PLANE_COUNT)
                             break;
-                        const PxPlane packedPlanes[6] = {
-                            PxPlane(PxVec3(1, 0, 0), -geomBox.halfExtents.x - collisionThickness).transform(shapeToCloth),
-                            PxPlane(PxVec3(-1, 0, 0), -geomBox.halfExtents.x - collisionThickness).transform(shapeToCloth),
-                            PxPlane(PxVec3(0, 1, 0), -geomBox.halfExtents.y - collisionThickness).transform(shapeToCloth),
-                            PxPlane(PxVec3(0, -1, 0), -geomBox.halfExtents.y - collisionThickness).transform(shapeToCloth),
-                            PxPlane(PxVec3(0, 0, 1), -geomBox.halfExtents.z - collisionThickness).transform(shapeToCloth),
-                            PxPlane(PxVec3(0, 0, -1), -geomBox.halfExtents.z - collisionThickness).transform(shapeToCloth)
-                        };
-                        clothPhysX->setPlanes(nv::cloth::Range<const PxVec4>((const PxVec4*)packedPlanes, (const PxVec4*)packedPlanes + 6), planesCount, planesCount);
-                        const PxU32 convexMask = PxU32(0x3f << planesCount);
-                        const uint32_t convexesCount = clothPhysX->getNumConvexes();
-                        clothPhysX->setConvexes(nv::cloth::Range<const PxU32>(&convexMask, &convexMask + 1), convexesCount, convexesCount);
+                        PxPlane* boxPlanes = planes + planesCount;
+                        boxPlanes[0] = PxPlane(PxVec3(1, 0, 0), -geomBox.halfExtents.x - collisionThickness).transform(shapeToCloth);
+                        boxPlanes[1] = PxPlane(PxVec3(-1, 0, 0), -geomBox.halfExtents.x - collisionThickness).transform(shapeToCloth);
+                        boxPlanes[2] = PxPlane(PxVec3(0, 1, 0), -geomBox.halfExtents.y - collisionThickness).transform(shapeToCloth);
+                        boxPlanes[3] = PxPlane(PxVec3(0, -1, 0), -geomBox.halfExtents.y - collisionThickness).transform(shapeToCloth);
+                        boxPlanes[4] = PxPlane(PxVec3(0, 0, 1), -geomBox.halfExtents.z - collisionThickness).transform(shapeToCloth);
+                        boxPlanes[5] = PxPlane(PxVec3(0, 0, -1), -geomBox.halfExtents.z - collisionThickness).transform(shapeToCloth);
+                        convexes[convexesCount++] = PxU32(0x3f << planesCount);
+                        planesCount += 6;
                         break;
                     }
                     case PxGeometryType::eCONVEXMESH:
                     {
                         const PxConvexMeshGeometry& geomConvexMesh = (const PxConvexMeshGeometry&)geo;
                         const PxU32 convexPlanesCount = geomConvexMesh.convexMesh->getNbPolygons();
-                        const uint32_t planesCount = clothPhysX->getNumPlanes();
                         if (planesCount + convexPlanesCount > MAX_CLOTH_PLANE_COUNT)
                             break;
                         const PxMat33 convexToShapeInv = geomConvexMesh.scale.toMat33().getInverse();
                         // TODO: merge convexToShapeInv with shapeToCloth to have a single matrix multiplication
-                        PxPlane planes[MAX_CLOTH_PLANE_COUNT];
                         for (PxU32 k = 0; k < convexPlanesCount; k++)
                         {
                             PxHullPolygon polygon;
                             geomConvexMesh.convexMesh->getPolygonData(k, polygon);
                             polygon.mPlane[3] -= collisionThickness;
-                            planes[k] = transform(reinterpret_cast<const PxPlane&>(polygon.mPlane), convexToShapeInv).transform(shapeToCloth);
+                            planes[planesCount + k] = transform(reinterpret_cast<const PxPlane&>(polygon.mPlane), convexToShapeInv).transform(shapeToCloth);
+                        }
+                        convexes[convexesCount++] = PxU32(((1 << convexPlanesCount) - 1) << planesCount);
+                        planesCount += convexPlanesCount;
+                        break;
+                    }
+                    case PxGeometryType::eHEIGHTFIELD:
+                    {
+                        // Gather only triangles nearby the cloth to not blow the solver performance
+                        const PxHeightFieldGeometry& geomHeightField = (const PxHeightFieldGeometry&)geo;
+                        const PxHeightField* heightField = geomHeightField.heightField;
+                        const PxVec3 overlapCenter = shapePose.transformInv(overlapPose.p);
+                        const float overlapRadius = overlapGeo.radius;
+                        const float rowScale = Math::Abs(geomHeightField.rowScale), columnScale = Math::Abs(geomHeightField.columnScale);
+                        const float rowCenter = overlapCenter.x / geomHeightField.rowScale, columnCenter = overlapCenter.z / geomHeightField.columnScale;
+                        const int32 rowsCount = (int32)heightField->getNbRows(), columnsCount = (int32)heightField->getNbColumns();
+                        const int32 rowStart = Math::Max(Math::FloorToInt(rowCenter - overlapRadius / rowScale), 0);
+                        const int32 rowEnd = Math::Min(Math::CeilToInt(rowCenter + overlapRadius / rowScale), rowsCount - 1);
+                        const int32 columnStart = Math::Max(Math::FloorToInt(columnCenter - overlapRadius / columnScale), 0);
+                        const int32 columnEnd = Math::Min(Math::CeilToInt(columnCenter + overlapRadius / columnScale), columnsCount - 1);
+                        const float heightMin = overlapCenter.y - overlapRadius, heightMax = overlapCenter.y + overlapRadius;
+                        for (int32 row = rowStart; row < rowEnd; row++)
+                        {
+                            for (int32 column = columnStart; column < columnEnd; column++)
+                            {
+                                if (triangles.Count() + 6 > CLOTH_MAX_HEIGHTFIELD_TRIANGLES * 3)
+                                    break;
+                                const PxHeightFieldSample& sample = heightField->getSample(row, column);
+                                if (sample.materialIndex0 == PxHeightFieldMaterial::eHOLE && sample.materialIndex1 == PxHeightFieldMaterial::eHOLE)
+                                    continue;
+                                PxVec3 p00(row * geomHeightField.rowScale, sample.height * geomHeightField.heightScale, column * geomHeightField.columnScale);
+                                PxVec3 p10((row + 1) * geomHeightField.rowScale, heightField->getSample(row + 1, column).height * geomHeightField.heightScale, column * geomHeightField.columnScale);
+                                PxVec3 p01(row * geomHeightField.rowScale, heightField->getSample(row, column + 1).height * geomHeightField.heightScale, (column + 1) * geomHeightField.columnScale);
+                                PxVec3 p11((row + 1) * geomHeightField.rowScale, heightField->getSample(row + 1, column + 1).height * geomHeightField.heightScale, (column + 1) * geomHeightField.columnScale);
+                                if (Math::Max(p00.y, p10.y, p01.y, p11.y) < heightMin || Math::Min(p00.y, p10.y, p01.y, p11.y) > heightMax)
+                                    continue;
+                                p00 = shapeToCloth.transform(p00);
+                                p10 = shapeToCloth.transform(p10);
+                                p01 = shapeToCloth.transform(p01);
+                                p11 = shapeToCloth.transform(p11);
+
+                                // Split cell into 2 triangles (tessellation flag picks the diagonal), front faces point up
+                                const PxVec3 up = shapeToCloth.q.rotate(PxVec3(0, 1, 0));
+                                const PxVec3 cell[2][3] = {
+                                    { p00, p10, sample.tessFlag() ? p11 : p01 },
+                                    { p11, p01, sample.tessFlag() ? p00 : p10 },
+                                };
+                                const PxU8 cellMaterials[2] = { sample.materialIndex0, sample.materialIndex1 };
+                                for (int32 k = 0; k < 2; k++)
+                                {
+                                    if (cellMaterials[k] == PxHeightFieldMaterial::eHOLE)
+                                        continue;
+                                    const PxVec3* t = cell[k];
+                                    if ((t[1] - t[0]).cross(t[2] - t[0]).dot(up) >= 0.0f)
+                                        triangles.Add(t, 3);
+                                    else
+                                    {
+                                        triangles.Add(t[0]);
+                                        triangles.Add(t[2]);
+                                        triangles.Add(t[1]);
+                                    }
+                                }
+                            }
                         }
-                        clothPhysX->setPlanes(nv::cloth::Range<const PxVec4>((const PxVec4*)planes, (const PxVec4*)planes + convexPlanesCount), planesCount, planesCount);
-                        const PxU32 convexMask = PxU32(((1 << convexPlanesCount) - 1) << planesCount);
-                        const uint32_t convexesCount = clothPhysX->getNumConvexes();
-                        clothPhysX->setConvexes(nv::cloth::Range<const PxU32>(&convexMask, &convexMask + 1), convexesCount, convexesCount);
                         break;
                     }
                     // Cloth vs Triangle collisions are too slow for real-time use
@@ -871,38 +1032,24 @@ void ScenePhysX::PreSimulateCloth(int32 i)
                         const PxTriangleMeshGeometry& geomTriangleMesh = (const PxTriangleMeshGeometry&)geo;
                         if (geomTriangleMesh.triangleMesh->getNbTriangles() >= 1024)
                             break; // Ignore too-tessellated meshes due to poor solver performance
-                        // TODO: use shared memory allocators maybe? maybe per-frame stack allocator?
-                        Array<PxVec3> vertices;
-                        vertices.Add(geomTriangleMesh.triangleMesh->getVertices(), geomTriangleMesh.triangleMesh->getNbVertices());
+                        const PxVec3* vertices = geomTriangleMesh.triangleMesh->getVertices();
                         const PxMat33 triangleMeshToShape = geomTriangleMesh.scale.toMat33();
                         // TODO: merge triangleMeshToShape with shapeToCloth to have a single matrix multiplication
-                        for (int32 k = 0; k < vertices.Count(); k++)
-                        {
-                            PxVec3& v = vertices.Get()[k];
-                            v = shapeToCloth.transform(triangleMeshToShape.transform(v));
-                        }
-                        Array<PxVec3> triangles;
-                        triangles.Resize(geomTriangleMesh.triangleMesh->getNbTriangles() * 3);
+                        const int32 trianglesStart = triangles.Count();
+                        triangles.AddUninitialized(geomTriangleMesh.triangleMesh->getNbTriangles() * 3);
+                        PxVec3* trianglesPtr = triangles.Get() + trianglesStart;
                         if (geomTriangleMesh.triangleMesh->getTriangleMeshFlags() & PxTriangleMeshFlag::e16_BIT_INDICES)
                         {
                             auto indices = (const uint16*)geomTriangleMesh.triangleMesh->getTriangles();
-                            for (int32 k = 0; k < triangles.Count(); k++)
-                                triangles.Get()[k] = vertices.Get()[indices[k]];
+                            for (int32 k = trianglesStart; k < triangles.Count(); k++)
+                                *trianglesPtr++ = shapeToCloth.transform(triangleMeshToShape.transform(vertices[indices[k - trianglesStart]]));
                         }
                         else
                         {
                             auto indices = (const uint32*)geomTriangleMesh.triangleMesh->getTriangles();
-                            for (int32 k = 0; k < triangles.Count(); k++)
-                                triangles.Get()[k] = vertices.Get()[indices[k]];
+                            for (int32 k = trianglesStart; k < triangles.Count(); k++)
+                                *trianglesPtr++ = shapeToCloth.transform(triangleMeshToShape.transform(vertices[indices[k - trianglesStart]]));
                         }
-                        const uint32_t trianglesCount = clothPhysX->getNumTriangles();
-	                    clothPhysX->setTriangles(nv::cloth::Range<const PxVec3>(triangles.begin(), triangles.end()), trianglesCount, trianglesCount);
-                        break;
-                    }
-                    case PxGeometryType::eHEIGHTFIELD:
-                    {
-                        const PxHeightFieldGeometry& geomHeightField = (const PxHeightFieldGeometry&)geo;
-                        // TODO: heightfield collisions (gather triangles only nearby cloth to not blow sim perf)
                         break;
                     }
 #endif
@@ -910,6 +1057,13 @@ void ScenePhysX::PreSimulateCloth(int32 i)
                 }
             }
         }
+
+        // Replace existing colliders
+        clothPhysX->setSpheres(nv::cloth::Range<const PxVec4>(spheres, spheres + spheresCount), 0, clothPhysX->getNumSpheres());
+        clothPhysX->setCapsules(nv::cloth::Range<const uint32_t>(capsules, capsules + capsulesCount), 0, clothPhysX->getNumCapsules());
+        clothPhysX->setPlanes(nv::cloth::Range<const PxVec4>((const PxVec4*)planes, (const PxVec4*)planes + planesCount), 0, clothPhysX->getNumPlanes());
+        clothPhysX->setConvexes(nv::cloth::Range<const PxU32>(convexes, convexes + convexesCount), 0, clothPhysX->getNumConvexes());
+        clothPhysX->setTriangles(nv::cloth::Range<const PxVec3>(triangles.Get(), triangles.Get() + triangles.Count()), 0, clothPhysX->getNumTriangles());
     }
     clothSettings.CollisionsUpdateFramesLeft--;
 }
@@ -974,6 +1128,30 @@ void PhysicalMaterial::UpdatePhysicsMaterial()
 		return true; \
 	}
 
+uint64 CollisionCooking::GetCookingParamsHash()
+{
+    auto cooking = Cooking;
+    if (cooking == nullptr)
+        return 0;
+    const PxCookingParams& params = cooking->getParams();
+    const float values[] =
+    {
+        params.areaTestEpsilon,
+        params.planeTolerance,
+        (float)params.convexMeshCookingType,
+        (float)params.suppressTriangleMeshRemapTable,
+        (float)params.buildTriangleAdjacencies,
+        (float)params.buildGPUData,
+        params.scale.length,
+        params.scale.speed,
+        (float)(uint32)params.meshPreprocessParams,
+        params.meshWeldTolerance,
+        (float)params.midphaseDesc.getType(),
+        (float)params.gaussMapLimit,
+    };
+    return ((uint64)PX_PHYSICS_VERSION << 32) | Crc::MemCrc32(values, sizeof(values));
+}
+
 bool CollisionCooking::CookConvexMesh(CookingInput& input, BytesContainer& output)
 {
     PROFILE_CPU();
@@ -999,14 +1177,14 @@ bool CollisionCooking::CookConvexMesh(CookingInput& input, BytesContainer& outpu
         desc.flags |= PxConvexFlag::Enum::eFAST_INERTIA_COMPUTATION;
     if (EnumHasAnyFlags(input.ConvexFlags, ConvexMeshGenerationFlags::ShiftVertices))
         desc.flags |= PxConvexFlag::Enum::eSHIFT_VERTICES;
+    // Note: use local copy of the params with immediate cooking API (shared cooking object state is not modified so it can run from many threads at once)
     PxCookingParams cookingParams = cooking->getParams();
     cookingParams.suppressTriangleMeshRemapTable = EnumHasAnyFlags(input.ConvexFlags, ConvexMeshGenerationFlags::SuppressFaceRemapTable);
-    cooking->setParams(cookingParams);
 
     // Perform cooking
     PxDefaultMemoryOutputStream outputStream;
     PxConvexMeshCookingResult::Enum result;
-    if (!cooking->cookConvexMesh(desc, outputStream, &result))
+    if (!PxCookConvexMesh(cookingParams, desc, outputStream, &result))
     {
         LOG(Warning, "Convex Mesh cooking failed. Error code: {0}, Input vertices count: {1}", (int32)result, input.VertexCount);
         return true;
@@ -1034,14 +1212,14 @@ bool CollisionCooking::CookTriangleMesh(CookingInput& input, BytesContainer& out
     desc.triangles.stride = 3 * (input.Is16bitIndexData ? sizeof(uint16) : sizeof(uint32));
     desc.triangles.data = input.IndexData;
     desc.flags = input.Is16bitIndexData ? PxMeshFlag::e16_BIT_INDICES : (PxMeshFlag::Enum)0;
+    // Note: use local copy of the params with immediate cooking API (shared cooking object state is not modified so it can run from many threads at once)
     PxCookingParams cookingParams = cooking->getParams();
     cookingParams.suppressTriangleMeshRemapTable = EnumHasAnyFlags(input.ConvexFlags, ConvexMeshGenerationFlags::SuppressFaceRemapTable);
-    cooking->setParams(cookingParams);
 
     // Perform cooking
     PxDefaultMemoryOutputStream outputStream;
     PxTriangleMeshCookingResult::Enum result;
-    if (!cooking->cookTriangleMesh(desc, outputStream, &result))
+    if (!PxCookTriangleMesh(cookingParams, desc, outputStream, &result))
     {
         LOG(Warning, "Triangle Mesh cooking failed. Error code: {0}, Input vertices count: {1}, indices count: {2}", (int32)result, input.VertexCount, input.IndexCount);
         return true;
@@ -1183,6 +1361,10 @@ void PhysicsBackend::Shutdown()
     RELEASE_PHYSX(WheelTireFrictions);
     WheelVehiclesResultsPerWheel.Resize(0);
     WheelVehiclesResultsPerVehicle.Resize(0);
+    WheelVehiclesConcurrentPerWheel.Resize(0);
+    WheelVehiclesConcurrentPerVehicle.Resize(0);
+    WheelVehiclesActive.Resize(0);
+    WheelVehiclesDeltaTimes.Resize(0);
 #endif
     RELEASE_PHYSX(DefaultMaterial);
 
@@ -1391,14 +1573,39 @@ void PhysicsBackend::EndSimulateScene(void* scene)
         // Update vehicles steering
         WheelVehiclesCache.Clear();
         WheelVehiclesCache.EnsureCapacity(scenePhysX->WheelVehicles.Count());
+        WheelVehiclesActive.Clear();
+        WheelVehiclesDeltaTimes.Clear();
         int32 wheelsCount = 0;
+        const Camera* mainCamera = Camera::GetMainCamera();
+        const Vector3 mainCameraPosition = mainCamera ? mainCamera->GetPosition() : Vector3::Zero;
         for (auto wheelVehicle : scenePhysX->WheelVehicles)
         {
             if (!wheelVehicle->IsActiveInHierarchy() || !wheelVehicle->GetEnableSimulation())
                 continue;
             auto drive = (PxVehicleWheels*)wheelVehicle->_vehicle;
             ASSERT(drive);
+
+            // Skip distant vehicles that are updated at the lower rate (time step gets accumulated)
+            wheelVehicle->_simulationTime += scenePhysX->LastDeltaTime;
+            const bool useInterval = wheelVehicle->UpdateInterval > 1 && mainCamera && Vector3::DistanceSquared(wheelVehicle->GetPosition(), mainCameraPosition) > Math::Square(wheelVehicle->UpdateIntervalDistance);
+            if (useInterval && ++wheelVehicle->_simulationFrame < wheelVehicle->UpdateInterval)
+                continue;
+            wheelVehicle->_simulationFrame = 0;
+
+            // Skip sleeping vehicles without any input
+            const bool hasInput = wheelVehicle->_throttle != 0.0f || wheelVehicle->_steering != 0.0f || wheelVehicle->_brake != 0.0f || wheelVehicle->_handBrake != 0.0f ||
+                                  wheelVehicle->_tankLeftThrottle != 0.0f || wheelVehicle->_tankRightThrottle != 0.0f || wheelVehicle->_tankLeftBrake != 0.0f || wheelVehicle->_tankRightBrake != 0.0f;
+            if (!hasInput && ((PxRigidDynamic*)wheelVehicle->GetPhysicsActor())->isSleeping())
+            {
+                wheelVehicle->_simulationTime = 0.0f;
+                continue;
+            }
+            const float deltaTime = wheelVehicle->_simulationTime;
+            wheelVehicle->_simulationTime = 0.0f;
+
             WheelVehiclesCache.Add(drive);
+            WheelVehiclesActive.Add(wheelVehicle);
+            WheelVehiclesDeltaTimes.Add(deltaTime);
             wheelsCount += drive->mWheelsSimData.getNbWheels();
 
             const float deadZone = 0.1f;
@@ -1640,7 +1847,7 @@ void PhysicsBackend::EndSimulateScene(void* scene)
                     rawInputData.setAnalogBrake(brake);
                     rawInputData.setAnalogSteer(wheelVehicle->_steering);
                     rawInputData.setAnalogHandbrake(wheelVehicle->_handBrake);
-                    PxVehicleDrive4WSmoothAnalogRawInputsAndSetAnalogInputs(padSmoothing, steerVsForwardSpeed, rawInputData, scenePhysX->LastDeltaTime, false, *(PxVehicleDrive4W*)drive);
+                    PxVehicleDrive4WSmoothAnalogRawInputsAndSetAnalogInputs(padSmoothing, steerVsForwardSpeed, rawInputData, deltaTime, false, *(PxVehicleDrive4W*)drive);
                     break;
                 }
                 case WheeledVehicle::DriveTypes::DriveNW:
@@ -1650,7 +1857,7 @@ void PhysicsBackend::EndSimulateScene(void* scene)
                     rawInputData.setAnalogBrake(brake);
                     rawInputData.setAnalogSteer(wheelVehicle->_steering);
                     rawInputData.setAnalogHandbrake(wheelVehicle->_handBrake);
-                    PxVehicleDriveNWSmoothAnalogRawInputsAndSetAnalogInputs(padSmoothing, steerVsForwardSpeed, rawInputData, scenePhysX->LastDeltaTime, false, *(PxVehicleDriveNW*)drive);
+                    PxVehicleDriveNWSmoothAnalogRawInputsAndSetAnalogInputs(padSmoothing, steerVsForwardSpeed, rawInputData, deltaTime, false, *(PxVehicleDriveNW*)drive);
                     break;
                 }
                 case WheeledVehicle::DriveTypes::Tank:
@@ -1662,7 +1869,7 @@ void PhysicsBackend::EndSimulateScene(void* scene)
                     rawInputData.setAnalogRightBrake(rightBrake);
                     rawInputData.setAnalogLeftThrust(leftThrottle);
                     rawInputData.setAnalogRightThrust(rightThrottle);
-                    PxVehicleDriveTankSmoothAnalogRawInputsAndSetAnalogInputs(padSmoothing, rawInputData, scenePhysX->LastDeltaTime, *(PxVehicleDriveTank*)drive);
+                    PxVehicleDriveTankSmoothAnalogRawInputsAndSetAnalogInputs(padSmoothing, rawInputData, deltaTime, *(PxVehicleDriveTank*)drive);
                     break;
                 }
                 }
@@ -1679,7 +1886,7 @@ void PhysicsBackend::EndSimulateScene(void* scene)
                     rawInputData.setDigitalSteerLeft(wheelVehicle->_steering < -deadZone);
                     rawInputData.setDigitalSteerRight(wheelVehicle->_steering > deadZone);
                     rawInputData.setDigitalHandbrake(wheelVehicle->_handBrake > deadZone);
-                    PxVehicleDrive4WSmoothDigitalRawInputsAndSetAnalogInputs(keySmoothing, steerVsForwardSpeed, rawInputData, scenePhysX->LastDeltaTime, false, *(PxVehicleDrive4W*)drive);
+                    PxVehicleDrive4WSmoothDigitalRawInputsAndSetAnalogInputs(keySmoothing, steerVsForwardSpeed, rawInputData, deltaTime, false, *(PxVehicleDrive4W*)drive);
                     break;
                 }
                 case WheeledVehicle::DriveTypes::DriveNW:
@@ -1690,7 +1897,7 @@ void PhysicsBackend::EndSimulateScene(void* scene)
                     rawInputData.setDigitalSteerLeft(wheelVehicle->_steering < -deadZone);
                     rawInputData.setDigitalSteerRight(wheelVehicle->_steering > deadZone);
                     rawInputData.setDigitalHandbrake(wheelVehicle->_handBrake > deadZone);
-                    PxVehicleDriveNWSmoothDigitalRawInputsAndSetAnalogInputs(keySmoothing, steerVsForwardSpeed, rawInputData, scenePhysX->LastDeltaTime, false, *(PxVehicleDriveNW*)drive);
+                    PxVehicleDriveNWSmoothDigitalRawInputsAndSetAnalogInputs(keySmoothing, steerVsForwardSpeed, rawInputData, deltaTime, false, *(PxVehicleDriveNW*)drive);
                     break;
                 }
                 case WheeledVehicle::DriveTypes::Tank:
@@ -1710,7 +1917,7 @@ void PhysicsBackend::EndSimulateScene(void* scene)
                     rawInputData.setAnalogRightThrust(rightThrottle);
 
                     // Needs to pass analog values to vehicle to maintain current movement direction because digital inputs accept only true/false values to tracks thrust instead of -1 to 1 
-                    PxVehicleDriveTankSmoothAnalogRawInputsAndSetAnalogInputs(padSmoothing, rawInputData, scenePhysX->LastDeltaTime, *(PxVehicleDriveTank*)drive);
+                    PxVehicleDriveTankSmoothAnalogRawInputsAndSetAnalogInputs(padSmoothing, rawInputData, deltaTime, *(PxVehicleDriveTank*)drive);
                     break;
                 }
                 }
@@ -1756,74 +1963,51 @@ void PhysicsBackend::EndSimulateScene(void* scene)
         // Setup cache for wheel states
         WheelVehiclesResultsPerVehicle.Resize(WheelVehiclesCache.Count(), false);
         WheelVehiclesResultsPerWheel.Resize(wheelsCount, false);
+        WheelVehiclesConcurrentPerVehicle.Resize(WheelVehiclesCache.Count(), false);
+        WheelVehiclesConcurrentPerWheel.Resize(wheelsCount, false);
         wheelsCount = 0;
-        for (int32 i = 0, ii = 0; i < scenePhysX->WheelVehicles.Count(); i++)
+        for (int32 i = 0; i < WheelVehiclesCache.Count(); i++)
         {
-            auto wheelVehicle = scenePhysX->WheelVehicles[i];
-            if (!wheelVehicle->IsActiveInHierarchy() || !wheelVehicle->GetEnableSimulation())
-                continue;
-            auto drive = (PxVehicleWheels*)scenePhysX->WheelVehicles[ii]->_vehicle;
-            auto& perVehicle = WheelVehiclesResultsPerVehicle[ii];
-            ii++;
-            perVehicle.nbWheelQueryResults = drive->mWheelsSimData.getNbWheels();
+            const PxU32 nbWheels = WheelVehiclesCache[i]->mWheelsSimData.getNbWheels();
+            auto& perVehicle = WheelVehiclesResultsPerVehicle[i];
+            perVehicle.nbWheelQueryResults = nbWheels;
             perVehicle.wheelQueryResults = WheelVehiclesResultsPerWheel.Get() + wheelsCount;
-            wheelsCount += perVehicle.nbWheelQueryResults;
+            auto& concurrent = WheelVehiclesConcurrentPerVehicle[i];
+            concurrent = PxVehicleConcurrentUpdateData();
+            concurrent.nbConcurrentWheelUpdates = nbWheels;
+            concurrent.concurrentWheelUpdates = WheelVehiclesConcurrentPerWheel.Get() + wheelsCount;
+            wheelsCount += (int32)nbWheels;
         }
 
         // Update vehicles
         if (WheelVehiclesCache.Count() != 0)
         {
-            PxVehicleSuspensionRaycasts(scenePhysX->WheelRaycastBatchQuery, WheelVehiclesCache.Count(), WheelVehiclesCache.Get());
-            PxVehicleUpdates(scenePhysX->LastDeltaTime, scenePhysX->Scene->getGravity(), *WheelTireFrictions, WheelVehiclesCache.Count(), WheelVehiclesCache.Get(), WheelVehiclesResultsPerVehicle.Get());
-        }
-
-        // Synchronize state
-        for (int32 i = 0, ii = 0; i < scenePhysX->WheelVehicles.Count(); i++)
-        {
-            auto wheelVehicle = scenePhysX->WheelVehicles[i];
-            if (!wheelVehicle->IsActiveInHierarchy() || !wheelVehicle->GetEnableSimulation())
-                continue;
-            auto drive = WheelVehiclesCache[ii];
-            auto& perVehicle = WheelVehiclesResultsPerVehicle[ii];
-            ii++;
-#if PHYSX_VEHICLE_DEBUG_TELEMETRY
-            LOG(Info, "Vehicle[{}] Gear={}, RPM={}", ii, wheelVehicle->GetCurrentGear(), (int32)wheelVehicle->GetEngineRotationSpeed());
-#endif
-
-            // Update wheels
-            for (int32 j = 0; j < wheelVehicle->_wheelsData.Count(); j++)
             {
-                auto& wheelData = wheelVehicle->_wheelsData[j];
-                auto& perWheel = perVehicle.wheelQueryResults[j];
-#if PHYSX_VEHICLE_DEBUG_TELEMETRY
-                LOG(Info, "Vehicle[{}] Wheel[{}] longitudinalSlip={}, lateralSlip={}, suspSpringForce={}", ii, j, Utilities::RoundTo2DecimalPlaces(perWheel.longitudinalSlip), Utilities::RoundTo2DecimalPlaces(perWheel.lateralSlip), (int32)perWheel.suspSpringForce);
-#endif
-
-                auto& state = wheelData.State;
-                state.IsInAir = perWheel.isInAir;
-                state.TireContactCollider = perWheel.tireContactShape ? static_cast<PhysicsColliderActor*>(perWheel.tireContactShape->userData) : nullptr;
-                state.TireContactPoint = P2C(perWheel.tireContactPoint) + scenePhysX->Origin;
-                state.TireContactNormal = P2C(perWheel.tireContactNormal);
-                state.TireFriction = perWheel.tireFriction;
-                state.SteerAngle = RadiansToDegrees * perWheel.steerAngle;
-                state.RotationAngle = -RadiansToDegrees * drive->mWheelsDynData.getWheelRotationAngle(j);
-                state.SuspensionOffset = perWheel.suspJounce;
-#if USE_EDITOR
-                state.SuspensionTraceStart = P2C(perWheel.suspLineStart) + scenePhysX->Origin;
-                state.SuspensionTraceEnd = P2C(perWheel.suspLineStart + perWheel.suspLineDir * perWheel.suspLineLength) + scenePhysX->Origin;
-#endif
+                PROFILE_CPU_NAMED("Raycasts");
+                PxVehicleSuspensionRaycasts(scenePhysX->WheelRaycastBatchQuery, WheelVehiclesCache.Count(), WheelVehiclesCache.Get());
+            }
 
-                if (!wheelData.Collider)
-                    continue;
-                auto shape = (PxShape*)wheelData.Collider->GetPhysicsShape();
-
-                // Update wheel collider transformation
-                auto localPose = shape->getLocalPose();
-                Transform t = wheelData.Collider->GetLocalTransform();
-                t.Orientation = Quaternion::Euler(-state.RotationAngle, state.SteerAngle, 0) * wheelData.LocalOrientation;
-                t.Translation = P2C(localPose.p) / wheelVehicle->GetScale() - t.Orientation * wheelData.Collider->GetCenter();
-                wheelData.Collider->SetLocalTransform(t);
+            // Simulate vehicles in batches (actors modifications are stored in the concurrent data and applied later on a single thread)
+            WheelVehiclesGravity = scenePhysX->Scene->getGravity();
+            const int32 jobsCount = Math::DivideAndRoundUp<int32>(WheelVehiclesCache.Count(), PHYSX_VEHICLES_JOB_BATCH);
+            Function<void(int32)> updateJob;
+            updateJob.Bind<ScenePhysX, &ScenePhysX::UpdateVehicles>(scenePhysX);
+            if (jobsCount > 1)
+                JobSystem::Execute(updateJob, jobsCount);
+            else
+                scenePhysX->UpdateVehicles(0);
+            {
+                PROFILE_CPU_NAMED("PostUpdates");
+                PxVehiclePostUpdates(WheelVehiclesConcurrentPerVehicle.Get(), WheelVehiclesCache.Count(), WheelVehiclesCache.Get());
             }
+
+            // Synchronize wheels state
+            Function<void(int32)> syncJob;
+            syncJob.Bind<ScenePhysX, &ScenePhysX::SyncVehicles>(scenePhysX);
+            if (jobsCount > 1)
+                JobSystem::Execute(syncJob, jobsCount);
+            else
+                scenePhysX->SyncVehicles(0);
         }
     }
 #endif
@@ -1836,18 +2020,51 @@ void PhysicsBackend::EndSimulateScene(void* scene)
         PxActor** activeActors = scenePhysX->Scene->getActiveActors(activeActorsCount);
         if (activeActorsCount > 0)
         {
-            // Update changed transformations
-            // TODO: use jobs system if amount if huge
-            for (uint32 i = 0; i < activeActorsCount; i++)
+            // Read simulated poses (can run in parallel as it only reads the simulation results)
+            scenePhysX->ActiveActors = activeActors;
+            scenePhysX->ActiveActorsCount = activeActorsCount;
+            scenePhysX->ActiveTransforms.Resize((int32)activeActorsCount, false);
+            const int32 jobsCount = Math::DivideAndRoundUp<int32>((int32)activeActorsCount, PHYSX_ACTIVE_ACTORS_JOB_BATCH);
+            if (jobsCount > 1)
+            {
+                Function<void(int32)> job;
+                job.Bind<ScenePhysX, &ScenePhysX::GatherActiveTransforms>(scenePhysX);
+                JobSystem::Execute(job, jobsCount);
+            }
+            else
             {
-                const auto pxActor = (PxRigidActor*)*activeActors++;
-                auto actor = static_cast<IPhysicsActor*>(pxActor->userData);
-                if (actor)
-                    actor->OnActiveTransformChanged();
+                scenePhysX->GatherActiveTransforms(0);
             }
+
+            // Update changed transformations (actors hierarchy is not thread-safe, scene rendering updates are batched)
+            SceneRendering::BeginUpdateBatch();
+            for (const ActiveTransformPhysX& e : scenePhysX->ActiveTransforms)
+            {
+                if (e.Actor)
+                    e.Actor->OnActiveTransformChanged(e.Position, e.Orientation);
+            }
+            SceneRendering::EndUpdateBatch();
+            scenePhysX->ActiveActors = nullptr;
+            scenePhysX->ActiveActorsCount = 0;
         }
     }
 
+#if WITH_VEHICLE
+    // Update wheels of vehicles that didn't move (moving vehicles updated wheels within the hierarchy transform update)
+    for (WheeledVehicle* wheelVehicle : WheelVehiclesActive)
+    {
+        if (!wheelVehicle->_wheelsTransformDirty)
+            continue;
+        wheelVehicle->_wheelsTransformDirty = false;
+        for (const auto& wheelData : wheelVehicle->_wheelsData)
+        {
+            if (wheelData.Collider)
+                ((Actor*)wheelData.Collider)->OnTransformChanged();
+        }
+    }
+    WheelVehiclesActive.Clear();
+#endif
+
 #if WITH_CLOTH
     nv::cloth::Solver* clothSolver = scenePhysX->ClothSolver;
     if (clothSolver && scenePhysX->ClothsList.Count() != 0)
@@ -65,6 +65,7 @@ void PhysicsSettings::Deserialize(DeserializeStream& stream, ISerializeModifier*
     DESERIALIZE(MaxSubsteps);
     DESERIALIZE(QueriesHitTriggers);
     DESERIALIZE(SupportCookingAtRuntime);
+    DESERIALIZE(CacheCookingAtRuntime);
 
     const auto layers = stream.FindMember("LayerMasks");
     if (layers != stream.MemberEnd())
@@ -47,6 +47,11 @@ bool CollisionCooking::CookHeightField(int32 cols, int32 rows, const PhysicsBack
     return true;
 }
 
+uint64 CollisionCooking::GetCookingParamsHash()
+{
+    return 0;
+}
+
 #endif
 
 bool PhysicsBackend::Init()
@@ -130,6 +130,12 @@ API_CLASS(sealed, Namespace="FlaxEditor.Content.Settings", NoConstructor) class
     API_FIELD(Attributes="EditorOrder(1100), EditorDisplay(\"Other\")")
     bool SupportCookingAtRuntime = false;
 
+    /// <summary>
+    /// Enables caching of the collision meshes cooked at runtime (convex and triangle meshes) on disk. Identical geometry is loaded from the cache instead of being cooked again, also across game sessions.
+    /// </summary>
+    API_FIELD(Attributes="EditorOrder(1101), EditorDisplay(\"Other\"), VisibleIf(nameof(SupportCookingAtRuntime))")
+    bool CacheCookingAtRuntime = true;
+
     /// <summary>
     /// Triangles from triangle meshes (CSG) with an area less than or equal to this value will be removed from physics collision data. Set to less than or equal 0 to disable.
     /// </summary>
@@ -301,13 +301,7 @@ void FontManager::Invalidate(FontCharacterEntry& entry)
 {
     if (entry.TextureIndex == MAX_uint8)
         return;
-    auto atlas = Atlases[entry.TextureIndex];
-    const uint32 padding = atlas->GetPaddingAmount();
-    const uint32 slotX = static_cast<uint32>(entry.UV.X - padding);
-    const uint32 slotY = static_cast<uint32>(entry.UV.Y - padding);
-    const uint32 slotSizeX = static_cast<uint32>(entry.UVSize.X + 2 * padding);
-    const uint32 slotSizeY = static_cast<uint32>(entry.UVSize.Y + 2 * padding);
-    atlas->Invalidate(slotX, slotY, slotSizeX, slotSizeY);
+    Atlases[entry.TextureIndex]->Invalidate(entry.Slot);
 }
 
 void FontManager::Flush()
@@ -16,7 +16,6 @@ FontTextureAtlas::FontTextureAtlas(const SpawnParams& params, const AssetInfo* i
     , _width(0)
     , _height(0)
     , _isDirty(true)
-    , _root(nullptr)
 {
 }
 
@@ -34,13 +33,11 @@ void FontTextureAtlas::Setup(PixelFormat format, PaddingStyle paddingStyle)
 
 void FontTextureAtlas::Init(uint32 width, uint32 height)
 {
-    ASSERT(_root == nullptr);
-
     // Setup
     uint32 padding = GetPaddingAmount();
     _width = width;
     _height = height;
-    _root = New<FontTextureAtlasSlot>(padding, padding, _width - padding, _height - padding);
+    _atlas.Init(padding, padding, _width - padding, _height - padding);
     _isDirty = false;
 
     // Reserve upload data memory
@@ -55,23 +52,7 @@ FontTextureAtlasSlot* FontTextureAtlas::AddEntry(uint32 targetWidth, uint32 targ
         return nullptr;
 
     // Try to find slot for the texture
-    FontTextureAtlasSlot* slot = nullptr;
-    const uint32 padding = GetPaddingAmount();
-    const uint32 allPadding = padding * 2;
-    for (int32 i = 0; i < _freeSlots.Count(); i++)
-    {
-        FontTextureAtlasSlot* e = _freeSlots[i];
-        if (e->Width == targetWidth + allPadding && e->Height == targetHeight + allPadding)
-        {
-            slot = e;
-            _freeSlots.RemoveAt(i);
-            break;
-        }
-    }
-    if (!slot)
-    {
-        slot = _root->Insert(targetWidth, targetHeight, GetPaddingAmount() * 2);
-    }
+    FontTextureAtlasSlot* slot = _atlas.Insert(targetWidth, targetHeight, GetPaddingAmount() * 2);
 
     // Check if can fit it
     if (slot)
@@ -87,14 +68,9 @@ FontTextureAtlasSlot* FontTextureAtlas::AddEntry(uint32 targetWidth, uint32 targ
     return slot;
 }
 
-bool FontTextureAtlas::Invalidate(uint32 x, uint32 y, uint32 width, uint32 height)
+void FontTextureAtlas::Invalidate(const FontTextureAtlasSlot* slot)
 {
-    FontTextureAtlasSlot* slot = invalidate(_root, x, y, width, height);
-    if (slot)
-    {
-        _freeSlots.Add(slot);
-    }
-    return slot != nullptr;
+    _atlas.Free(const_cast<FontTextureAtlasSlot*>(slot));
 }
 
 void FontTextureAtlas::CopyDataIntoSlot(const FontTextureAtlasSlot* slot, const Array<byte>& data)
@@ -210,8 +186,7 @@ void FontTextureAtlas::unload(bool isReloading)
 
 void FontTextureAtlas::Clear()
 {
-    SAFE_DELETE(_root);
-    _freeSlots.Clear();
+    _atlas.Clear();
 }
 
 void FontTextureAtlas::Flush()
@@ -249,18 +224,6 @@ bool FontTextureAtlas::HasDataSyncWithGPU() const
     return _isDirty == false;
 }
 
-FontTextureAtlasSlot* FontTextureAtlas::invalidate(FontTextureAtlasSlot* parent, uint32 x, uint32 y, uint32 width, uint32 height)
-{
-    if (parent->X == x && parent->Y == y && parent->Width == width && parent->Height == height)
-    {
-        return parent;
-    }
-    FontTextureAtlasSlot* result = parent->Left ? invalidate(parent->Left, x, y, width, height) : nullptr;
-    if (result)
-        return result;
-    return parent->Right ? invalidate(parent->Right, x, y, width, height) : nullptr;
-}
-
 void FontTextureAtlas::markAsDirty()
 {
     _isDirty = true;
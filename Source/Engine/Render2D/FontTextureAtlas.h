@@ -11,16 +11,20 @@
 /// <summary>
 /// Contains information about single texture atlas slot.
 /// </summary>
-struct FontTextureAtlasSlot : RectPack<FontTextureAtlasSlot>
+struct FontTextureAtlasSlot : RectPackNode<uint32>
 {
     FontTextureAtlasSlot(uint32 x, uint32 y, uint32 width, uint32 height)
-        : RectPack<FontTextureAtlasSlot>(x, y, width, height)
+        : RectPackNode<uint32>(x, y, width, height)
     {
     }
 
     void OnInsert()
     {
     }
+
+    void OnFree()
+    {
+    }
 };
 
 /// <summary>
@@ -74,8 +78,7 @@ DECLARE_BINARY_ASSET_HEADER(FontTextureAtlas, TexturesSerializedVersion);
     uint32 _bytesPerPixel;
     PaddingStyle _paddingStyle;
     bool _isDirty;
-    FontTextureAtlasSlot* _root;
-    Array<FontTextureAtlasSlot*> _freeSlots;
+    RectPackAtlas<FontTextureAtlasSlot> _atlas;
 
 public:
 
@@ -160,14 +163,10 @@ DECLARE_BINARY_ASSET_HEADER(FontTextureAtlas, TexturesSerializedVersion);
     FontTextureAtlasSlot* AddEntry(uint32 targetWidth, uint32 targetHeight, const Array<byte>& data);
 
     /// <summary>
-    /// Invalidates the cached dynamic entry from the atlas.
+    /// Invalidates the cached dynamic entry from the atlas. Frees the slot space so it can be reused by other entries.
     /// </summary>
-    /// <param name="x">The slot location (X coordinate in atlas pixels).</param>
-    /// <param name="y">The slot location (Y coordinate in atlas pixels).</param>
-    /// <param name="width">The slot width (size in atlas pixels).</param>
-    /// <param name="height">The slot height (size in atlas pixels).</param>
-    /// <returns>True if slot has been freed, otherwise false.</returns>
-    bool Invalidate(uint32 x, uint32 y, uint32 width, uint32 height);
+    /// <param name="slot">The atlas slot occupied by the entry.</param>
+    void Invalidate(const FontTextureAtlasSlot* slot);
 
     /// <summary>
     /// Copies the data into the slot.
@@ -214,7 +213,6 @@ DECLARE_BINARY_ASSET_HEADER(FontTextureAtlas, TexturesSerializedVersion);
 
 private:
 
-    FontTextureAtlasSlot* invalidate(FontTextureAtlasSlot* parent, uint32 x, uint32 y, uint32 width, uint32 height);
     void markAsDirty();
     void copyRow(const RowData& copyRowData) const;
     void zeroRow(const RowData& copyRowData) const;
@@ -34,6 +34,9 @@
 #define GLOBAL_SURFACE_ATLAS_TILE_SIZE_MIN 8 // The minimum size of the tile
 #define GLOBAL_SURFACE_ATLAS_TILE_SIZE_MAX 192 // The maximum size of the tile
 #define GLOBAL_SURFACE_ATLAS_TILE_PROJ_PLANE_OFFSET 0.1f // Small offset to prevent clipping with the closest triangles (shifts near and far planes)
+#define GLOBAL_SURFACE_ATLAS_OBJECTS_GRID_CELL_SIZE 1000.0f // Size of the spatial grid cell (in world units) used to query objects within the area (eg. light range)
+#define GLOBAL_SURFACE_ATLAS_OBJECTS_GRID_MAX_CELLS 64 // Maximum amount of the grid cells covered by a single object (larger objects are kept in a separate list checked by every query)
+#define GLOBAL_SURFACE_ATLAS_OBJECTS_GRID_MAX_COORD 1000000 // Limit for the grid cell coordinates (prevents overflows on huge bounds)
 #define GLOBAL_SURFACE_ATLAS_DEBUG_FORCE_REDRAW_TILES 0 // Forces to redraw all object tiles every frame
 #define GLOBAL_SURFACE_ATLAS_DEBUG_DRAW_OBJECTS 0 // Debug draws object bounds on redraw (and tile draw projection locations)
 #define GLOBAL_SURFACE_ATLAS_DEBUG_DRAW_CHUNKS 0 // Debug draws culled chunks bounds (non-empty)
@@ -64,7 +67,7 @@ PACK_STRUCT(struct AtlasTileVertex
     uint32 TileAddress;
     });
 
-struct GlobalSurfaceAtlasTile : RectPack<GlobalSurfaceAtlasTile, uint16>
+struct GlobalSurfaceAtlasTile : RectPackNode<uint16>
 {
     Float3 ViewDirection;
     Float3 ViewPosition;
@@ -72,9 +75,10 @@ struct GlobalSurfaceAtlasTile : RectPack<GlobalSurfaceAtlasTile, uint16>
     Matrix ViewMatrix;
     uint32 Address;
     uint32 ObjectAddressOffset;
+    void* ActorObject;
 
     GlobalSurfaceAtlasTile(uint16 x, uint16 y, uint16 width, uint16 height)
-        : RectPack<GlobalSurfaceAtlasTile, uint16>(x, y, width, height)
+        : RectPackNode<uint16>(x, y, width, height)
     {
     }
 
@@ -91,9 +95,13 @@ struct GlobalSurfaceAtlasObject
     uint64 LastFrameUpdated;
     uint64 LightingUpdateFrame; // Index of the frame to update lighting for this object (calculated when object gets dirty or overriden by dynamic lights)
     Actor* Actor;
+    uint64 LastQuery; // Index of the last objects grid query that visited this object (to skip duplicates from overlapping cells)
     GlobalSurfaceAtlasTile* Tiles[6];
     float Radius;
     OrientedBoundingBox Bounds;
+    Int3 GridMin, GridMax; // Range of the objects grid cells that contain this object
+    bool InGrid;
+    bool InOversizedList; // True if object covers too many grid cells and is kept in the oversized objects list instead
 
     GlobalSurfaceAtlasObject()
     {
@@ -146,8 +154,11 @@ class GlobalSurfaceAtlasCustomBuffer : public RenderBuffers::CustomBuffer, publi
     DynamicTypedBuffer ObjectsBuffer;
     int32 CulledObjectsCounterIndex = -1;
     GlobalSurfaceAtlasPass::BindingData Result;
-    GlobalSurfaceAtlasTile* AtlasTiles = nullptr; // TODO: optimize with a single allocation for atlas tiles
+    RectPackAtlas<GlobalSurfaceAtlasTile> Atlas;
     Dictionary<void*, GlobalSurfaceAtlasObject> Objects;
+    Dictionary<Int3, Array<void*>> ObjectsGrid;
+    Array<void*> ObjectsOversized;
+    uint64 ObjectsGridQuery = 0;
     Dictionary<Guid, GlobalSurfaceAtlasLight> Lights;
     SamplesBuffer<uint32, 30> CulledObjectsUsageHistory;
 
@@ -170,11 +181,131 @@ class GlobalSurfaceAtlasCustomBuffer : public RenderBuffers::CustomBuffer, publi
         CulledObjectsCounterIndex = -1;
         CulledObjectsUsageHistory.Clear();
         LastFrameAtlasDefragmentation = Engine::FrameCount;
-        SAFE_DELETE(AtlasTiles);
+        Atlas.Clear();
         Objects.Clear();
+        ObjectsGrid.Clear();
+        ObjectsOversized.Clear();
         Lights.Clear();
     }
 
+    static void GetGridCells(const Float3& center, float radius, Int3& min, Int3& max)
+    {
+        const float cellSizeInv = 1.0f / GLOBAL_SURFACE_ATLAS_OBJECTS_GRID_CELL_SIZE;
+        const Float3 limit((float)GLOBAL_SURFACE_ATLAS_OBJECTS_GRID_MAX_COORD);
+        min = Int3(Float3::Clamp(Float3::Floor((center - radius) * cellSizeInv), -limit, limit));
+        max = Int3(Float3::Clamp(Float3::Floor((center + radius) * cellSizeInv), -limit, limit));
+    }
+
+    static int64 GetGridCellsCount(const Int3& min, const Int3& max)
+    {
+        const Int3 size = max - min + 1;
+        return (int64)size.X * size.Y * size.Z;
+    }
+
+    void AddToGrid(void* actorObject, GlobalSurfaceAtlasObject& object)
+    {
+        Int3 min, max;
+        GetGridCells(object.Bounds.GetCenter(), object.Radius, min, max);
+        if (object.InGrid)
+        {
+            if (min == object.GridMin && max == object.GridMax)
+                return; // Object cells didn't change
+            RemoveFromGrid(actorObject, object);
+        }
+        object.GridMin = min;
+        object.GridMax = max;
+        object.InGrid = true;
+        object.InOversizedList = GetGridCellsCount(min, max) > GLOBAL_SURFACE_ATLAS_OBJECTS_GRID_MAX_CELLS;
+        if (object.InOversizedList)
+        {
+            ObjectsOversized.Add(actorObject);
+            return;
+        }
+        for (int32 z = min.Z; z <= max.Z; z++)
+        {
+            for (int32 y = min.Y; y <= max.Y; y++)
+            {
+                for (int32 x = min.X; x <= max.X; x++)
+                    ObjectsGrid[Int3(x, y, z)].Add(actorObject);
+            }
+        }
+    }
+
+    void RemoveFromGrid(void* actorObject, GlobalSurfaceAtlasObject& object)
+    {
+        if (!object.InGrid)
+            return;
+        object.InGrid = false;
+        if (object.InOversizedList)
+        {
+            object.InOversizedList = false;
+            ObjectsOversized.Remove(actorObject);
+            return;
+        }
+        for (int32 z = object.GridMin.Z; z <= object.GridMax.Z; z++)
+        {
+            for (int32 y = object.GridMin.Y; y <= object.GridMax.Y; y++)
+            {
+                for (int32 x = object.GridMin.X; x <= object.GridMax.X; x++)
+                {
+                    const Int3 key(x, y, z);
+                    auto cell = ObjectsGrid.Find(key);
+                    if (cell.IsEnd())
+                        continue;
+                    cell->Value.Remove(actorObject);
+                    if (cell->Value.IsEmpty())
+                        ObjectsGrid.Remove(cell);
+                }
+            }
+        }
+    }
+
+    // Calls the function for each object which cells overlap the given sphere (each object is visited once). Caller performs the exact intersection test.
+    template<typename Func>
+    void QueryObjects(const Float3& center, float radius, Func func)
+    {
+        Int3 min, max;
+        GetGridCells(center, radius, min, max);
+        if (GetGridCellsCount(min, max) >= ObjectsGrid.Count())
+        {
+            // Query covers more cells than there are in the grid so iterate over all objects
+            for (auto& e : Objects)
+                func(e.Value);
+            return;
+        }
+        const uint64 query = ++ObjectsGridQuery;
+        for (void* actorObject : ObjectsOversized)
+        {
+            GlobalSurfaceAtlasObject* object = Objects.TryGet(actorObject);
+            if (object)
+            {
+                object->LastQuery = query;
+                func(*object);
+            }
+        }
+        for (int32 z = min.Z; z <= max.Z; z++)
+        {
+            for (int32 y = min.Y; y <= max.Y; y++)
+            {
+                for (int32 x = min.X; x <= max.X; x++)
+                {
+                    const Array<void*>* cell = ObjectsGrid.TryGet(Int3(x, y, z));
+                    if (!cell)
+                        continue;
+                    for (void* actorObject : *cell)
+                    {
+                        GlobalSurfaceAtlasObject* object = Objects.TryGet(actorObject);
+                        if (object && object->LastQuery != query)
+                        {
+                            object->LastQuery = query;
+                            func(*object);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
     FORCE_INLINE void Clear()
     {
         RenderTargetPool::Release(AtlasDepth);
@@ -229,6 +360,7 @@ class GlobalSurfaceAtlasCustomBuffer : public RenderBuffers::CustomBuffer, publi
 
 void GlobalSurfaceAtlasTile::OnInsert(GlobalSurfaceAtlasCustomBuffer* buffer, void* actorObject, int32 tileIndex)
 {
+    ActorObject = actorObject;
     buffer->Objects[actorObject].Tiles[tileIndex] = this;
 }
 
@@ -426,13 +558,28 @@ bool GlobalSurfaceAtlasPass::Render(RenderContext& renderContext, GPUContext* co
         if (currentFrame - surfaceAtlasData.LastFrameAtlasInsertFail < 10 &&
             currentFrame - surfaceAtlasData.LastFrameAtlasDefragmentation > 60)
         {
-            surfaceAtlasData.ClearObjects();
+            // Compact atlas tiles and redraw the relocated objects, otherwise start from scratch
+            Array<RectPackAtlas<GlobalSurfaceAtlasTile>::Relocation> relocations;
+            if (surfaceAtlasData.Atlas.Defragment(relocations))
+            {
+                surfaceAtlasData.ClearObjects();
+            }
+            else
+            {
+                surfaceAtlasData.LastFrameAtlasDefragmentation = currentFrame;
+                for (const auto& e : relocations)
+                {
+                    GlobalSurfaceAtlasObject* object = surfaceAtlasData.Objects.TryGet(e.Node->ActorObject);
+                    if (object)
+                        object->LastFrameUpdated = 0;
+                }
+            }
         }
     }
     for (SceneRendering* scene : renderContext.List->Scenes)
         surfaceAtlasData.ListenSceneRendering(scene);
-    if (!surfaceAtlasData.AtlasTiles)
-        surfaceAtlasData.AtlasTiles = New<GlobalSurfaceAtlasTile>(0, 0, resolution, resolution);
+    if (surfaceAtlasData.Atlas.GetWidth() != resolution)
+        surfaceAtlasData.Atlas.Init(0, 0, resolution, resolution);
     if (!_vertexBuffer)
         _vertexBuffer = New<DynamicVertexBuffer>(0u, (uint32)sizeof(AtlasTileVertex), TEXT("GlobalSurfaceAtlas.VertexBuffer"));
 
@@ -516,8 +663,9 @@ bool GlobalSurfaceAtlasPass::Render(RenderContext& renderContext, GPUContext* co
                 for (auto& tile : it->Value.Tiles)
                 {
                     if (tile)
-                        tile->Free();
+                        surfaceAtlasData.Atlas.Free(tile);
                 }
+                surfaceAtlasData.RemoveFromGrid(it->Key, it->Value);
                 surfaceAtlasData.Objects.Remove(it);
             }
         }
@@ -878,14 +1026,12 @@ bool GlobalSurfaceAtlasPass::Render(RenderContext& renderContext, GPUContext* co
             if (!allLightingDirty)
             {
                 // Mark objects to shade
-                for (auto& e : surfaceAtlasData.Objects)
+                surfaceAtlasData.QueryObjects(light.Position, light.Radius, [&](GlobalSurfaceAtlasObject& object)
                 {
-                    auto& object = e.Value;
                     Float3 lightToObject = object.Bounds.GetCenter() - light.Position;
-                    if (lightToObject.LengthSquared() >= Math::Square(object.Radius + light.Radius))
-                        continue;
-                    object.LightingUpdateFrame = currentFrame;
-                }
+                    if (lightToObject.LengthSquared() < Math::Square(object.Radius + light.Radius))
+                        object.LightingUpdateFrame = currentFrame;
+                });
             }
         }
         for (auto& light : renderContext.List->SpotLights)
@@ -900,14 +1046,12 @@ bool GlobalSurfaceAtlasPass::Render(RenderContext& renderContext, GPUContext* co
             if (!allLightingDirty)
             {
                 // Mark objects to shade
-                for (auto& e : surfaceAtlasData.Objects)
+                surfaceAtlasData.QueryObjects(light.Position, light.Radius, [&](GlobalSurfaceAtlasObject& object)
                 {
-                    auto& object = e.Value;
                     Float3 lightToObject = object.Bounds.GetCenter() - light.Position;
-                    if (lightToObject.LengthSquared() >= Math::Square(object.Radius + light.Radius))
-                        continue;
-                    object.LightingUpdateFrame = currentFrame;
-                }
+                    if (lightToObject.LengthSquared() < Math::Square(object.Radius + light.Radius))
+                        object.LightingUpdateFrame = currentFrame;
+                });
             }
         }
 
@@ -972,14 +1116,13 @@ bool GlobalSurfaceAtlasPass::Render(RenderContext& renderContext, GPUContext* co
         {
             // Collect tiles to shade
             _vertexBuffer->Clear();
-            for (const auto& e : surfaceAtlasData.Objects)
+            surfaceAtlasData.QueryObjects(light.Position, light.Radius, [&](const GlobalSurfaceAtlasObject& object)
             {
-                const auto& object = e.Value;
                 if (!allLightingDirty && object.LightingUpdateFrame != currentFrame)
-                    continue;
+                    return;
                 Float3 lightToObject = object.Bounds.GetCenter() - light.Position;
                 if (lightToObject.LengthSquared() >= Math::Square(object.Radius + light.Radius))
-                    continue;
+                    return;
                 for (int32 tileIndex = 0; tileIndex < 6; tileIndex++)
                 {
                     auto* tile = object.Tiles[tileIndex];
@@ -987,7 +1130,7 @@ bool GlobalSurfaceAtlasPass::Render(RenderContext& renderContext, GPUContext* co
                         continue;
                     VB_WRITE_TILE(tile);
                 }
-            }
+            });
             if (_vertexBuffer->Data.Count() == 0)
                 continue;
 
@@ -1005,14 +1148,13 @@ bool GlobalSurfaceAtlasPass::Render(RenderContext& renderContext, GPUContext* co
         {
             // Collect tiles to shade
             _vertexBuffer->Clear();
-            for (const auto& e : surfaceAtlasData.Objects)
+            surfaceAtlasData.QueryObjects(light.Position, light.Radius, [&](const GlobalSurfaceAtlasObject& object)
             {
-                const auto& object = e.Value;
                 if (!allLightingDirty && object.LightingUpdateFrame != currentFrame)
-                    continue;
+                    return;
                 Float3 lightToObject = object.Bounds.GetCenter() - light.Position;
                 if (lightToObject.LengthSquared() >= Math::Square(object.Radius + light.Radius))
-                    continue;
+                    return;
                 for (int32 tileIndex = 0; tileIndex < 6; tileIndex++)
                 {
                     auto* tile = object.Tiles[tileIndex];
@@ -1020,7 +1162,7 @@ bool GlobalSurfaceAtlasPass::Render(RenderContext& renderContext, GPUContext* co
                         continue;
                     VB_WRITE_TILE(tile);
                 }
-            }
+            });
             if (_vertexBuffer->Data.Count() == 0)
                 continue;
 
@@ -1217,7 +1359,7 @@ void GlobalSurfaceAtlasPass::RasterizeActor(Actor* actor, void* actorObject, con
             // Skip too small surfaces
             if (object && object->Tiles[tileIndex])
             {
-                object->Tiles[tileIndex]->Free();
+                surfaceAtlasData.Atlas.Free(object->Tiles[tileIndex]);
                 object->Tiles[tileIndex] = nullptr;
             }
             continue;
@@ -1240,11 +1382,11 @@ void GlobalSurfaceAtlasPass::RasterizeActor(Actor* actor, void* actorObject, con
                 anyTile = true;
                 continue;
             }
-            object->Tiles[tileIndex]->Free();
+            surfaceAtlasData.Atlas.Free(object->Tiles[tileIndex]);
         }
 
         // Insert tile into atlas
-        auto* tile = surfaceAtlasData.AtlasTiles->Insert(tileResolution, tileResolution, 0, &surfaceAtlasData, actorObject, tileIndex);
+        auto* tile = surfaceAtlasData.Atlas.Insert(tileResolution, tileResolution, 0, &surfaceAtlasData, actorObject, tileIndex);
         if (tile)
         {
             if (!object)
@@ -1274,6 +1416,7 @@ void GlobalSurfaceAtlasPass::RasterizeActor(Actor* actor, void* actorObject, con
     object->Bounds = OrientedBoundingBox(localBounds);
     object->Bounds.Transform(localToWorld);
     object->Radius = (float)actorObjectBounds.Radius;
+    surfaceAtlasData.AddToGrid(actorObject, *object);
     if (dirty || GLOBAL_SURFACE_ATLAS_DEBUG_FORCE_REDRAW_TILES)
     {
         object->LastFrameUpdated = surfaceAtlasData.CurrentFrame;
@@ -392,6 +392,192 @@ void RenderList::Init(RenderContext& renderContext)
         Float3::Transform(FrustumCornersWs[i], renderContext.View.View, FrustumCornersVs[i]);
 }
 
+void RenderLocalLightsGrid::Build(const RenderView& view, const RenderList& list)
+{
+    if (_isBuilt && _pointLightsCount == list.PointLights.Count() && _spotLightsCount == list.SpotLights.Count() && _view == view.View && _projection == view.Projection)
+        return;
+    PROFILE_CPU();
+    _isBuilt = true;
+    _view = view.View;
+    _projection = view.Projection;
+    _near = Math::Max(view.Near, ZeroTolerance);
+    _far = Math::Max(view.Far, _near * 2.0f);
+    _depthSliceScale = (float)SizeZ / Math::Log(_far / _near);
+    _pointLightsCount = list.PointLights.Count();
+    _spotLightsCount = list.SpotLights.Count();
+
+    // Gather lights
+    const int32 lightsCount = _pointLightsCount + _spotLightsCount;
+    _lights.Resize(lightsCount, false);
+    for (int32 i = 0; i < _pointLightsCount; i++)
+    {
+        const auto& light = list.PointLights.Get()[i];
+        _lights.Get()[i] = { light.Position, light.Radius, Float3::Dot(light.Color, Float3(0.2126f, 0.7152f, 0.0722f)) };
+    }
+    for (int32 i = 0; i < _spotLightsCount; i++)
+    {
+        const auto& light = list.SpotLights.Get()[i];
+        _lights.Get()[_pointLightsCount + i] = { light.Position, light.Radius, Float3::Dot(light.Color, Float3(0.2126f, 0.7152f, 0.0722f)) };
+    }
+
+    // Count lights per cell (counting sort into the cells)
+    Array<Int3, RendererAllocation> lightCells;
+    lightCells.Resize(lightsCount * 2);
+    _cellOffsets.Resize(CellsCount + 1, false);
+    Platform::MemoryClear(_cellOffsets.Get(), _cellOffsets.Count() * sizeof(int32));
+    int32* cellCounts = _cellOffsets.Get() + 1;
+    for (int32 i = 0; i < lightsCount; i++)
+    {
+        const LightInfo& light = _lights.Get()[i];
+        Int3& min = lightCells.Get()[i * 2];
+        Int3& max = lightCells.Get()[i * 2 + 1];
+        if (!GetCells(light.Position, light.Radius, min, max))
+        {
+            min = Int3::Zero;
+            max = Int3(-1);
+            continue;
+        }
+        for (int32 z = min.Z; z <= max.Z; z++)
+            for (int32 y = min.Y; y <= max.Y; y++)
+                for (int32 x = min.X; x <= max.X; x++)
+                    cellCounts[(z * SizeY + y) * SizeX + x]++;
+    }
+    for (int32 i = 1; i <= CellsCount; i++)
+        _cellOffsets.Get()[i] += _cellOffsets.Get()[i - 1];
+
+    // Write lights to cells
+    _cellLights.Resize(_cellOffsets.Last(), false);
+    Array<int32, RendererAllocation> cellWrite;
+    cellWrite.Set(_cellOffsets.Get(), CellsCount);
+    for (int32 i = 0; i < lightsCount; i++)
+    {
+        const Int3& min = lightCells.Get()[i * 2];
+        const Int3& max = lightCells.Get()[i * 2 + 1];
+        for (int32 z = min.Z; z <= max.Z; z++)
+            for (int32 y = min.Y; y <= max.Y; y++)
+                for (int32 x = min.X; x <= max.X; x++)
+                    _cellLights.Get()[cellWrite.Get()[(z * SizeY + y) * SizeX + x]++] = i;
+    }
+}
+
+bool RenderLocalLightsGrid::GetCells(const Float3& center, float radius, Int3& min, Int3& max) const
+{
+    // Depth slices (exponential distribution from the near plane)
+    Float3 centerVS;
+    Float3::Transform(center, _view, centerVS);
+    const float zMin = centerVS.Z - radius;
+    const float zMax = centerVS.Z + radius;
+    if (zMax < _near || zMin > _far)
+        return false;
+    min.Z = zMin <= _near ? 0 : Math::Clamp((int32)(Math::Log(zMin / _near) * _depthSliceScale), 0, SizeZ - 1);
+    max.Z = Math::Clamp((int32)(Math::Log(zMax / _near) * _depthSliceScale), 0, SizeZ - 1);
+
+    // Screen tiles (project view-space bounding box corners)
+    Float2 ndcMin(MAX_float), ndcMax(MIN_float);
+    for (int32 i = 0; i < 8; i++)
+    {
+        const Float3 corner(centerVS.X + (i & 1 ? radius : -radius), centerVS.Y + (i & 2 ? radius : -radius), i & 4 ? zMax : zMin);
+        const float w = corner.X * _projection.M14 + corner.Y * _projection.M24 + corner.Z * _projection.M34 + _projection.M44;
+        if (w <= ZeroTolerance)
+        {
+            // Bounds cross the camera plane
+            ndcMin = Float2(-1.0f);
+            ndcMax = Float2(1.0f);
+            break;
+        }
+        const float invW = 1.0f / w;
+        const Float2 ndc((corner.X * _projection.M11 + corner.Y * _projection.M21 + corner.Z * _projection.M31 + _projection.M41) * invW,
+                         (corner.X * _projection.M12 + corner.Y * _projection.M22 + corner.Z * _projection.M32 + _projection.M42) * invW);
+        ndcMin = Float2::Min(ndcMin, ndc);
+        ndcMax = Float2::Max(ndcMax, ndc);
+    }
+    if (ndcMax.X < -1.0f || ndcMin.X > 1.0f || ndcMax.Y < -1.0f || ndcMin.Y > 1.0f)
+        return false;
+    min.X = Math::Clamp((int32)((ndcMin.X * 0.5f + 0.5f) * SizeX), 0, SizeX - 1);
+    min.Y = Math::Clamp((int32)((ndcMin.Y * 0.5f + 0.5f) * SizeY), 0, SizeY - 1);
+    max.X = Math::Clamp((int32)((ndcMax.X * 0.5f + 0.5f) * SizeX), 0, SizeX - 1);
+    max.Y = Math::Clamp((int32)((ndcMax.Y * 0.5f + 0.5f) * SizeY), 0, SizeY - 1);
+    return true;
+}
+
+int32 RenderLocalLightsGrid::Query(const BoundingSphere& bounds, int32* lights, int32 maxLights) const
+{
+    // Keep the most important lights sorted by score (descending)
+    float scores[16];
+    ASSERT_LOW_LAYER(maxLights <= ARRAY_COUNT(scores));
+    int32 count = 0;
+    const Float3 position = bounds.Center;
+    const float radius = (float)bounds.Radius;
+    const auto testLight = [&](int32 lightIndex)
+    {
+        const LightInfo& light = _lights.Get()[lightIndex];
+        const float distance = Float3::Distance(position, light.Position) - radius;
+        if (distance >= light.Radius)
+            return;
+        const float falloff = 1.0f - Math::Max(distance, 0.0f) / light.Radius;
+        const float score = light.Luminance * falloff * falloff;
+        for (int32 i = 0; i < count; i++)
+        {
+            if (lights[i] == lightIndex)
+                return; // Light already tested (overlaps many cells)
+        }
+        int32 slot = count;
+        while (slot > 0 && scores[slot - 1] < score)
+            slot--;
+        if (slot >= maxLights)
+            return;
+        for (int32 i = Math::Min(count, maxLights - 1); i > slot; i--)
+        {
+            lights[i] = lights[i - 1];
+            scores[i] = scores[i - 1];
+        }
+        lights[slot] = lightIndex;
+        scores[slot] = score;
+        count = Math::Min(count + 1, maxLights);
+    };
+
+    Int3 min, max;
+    if (_isBuilt && GetCells(position, radius, min, max))
+    {
+        const int32 cellsCount = (max.X - min.X + 1) * (max.Y - min.Y + 1) * (max.Z - min.Z + 1);
+        if (cellsCount * 4 < _lights.Count())
+        {
+            // Test lights from the cells overlapping the object bounds
+            for (int32 z = min.Z; z <= max.Z; z++)
+            {
+                for (int32 y = min.Y; y <= max.Y; y++)
+                {
+                    for (int32 x = min.X; x <= max.X; x++)
+                    {
+                        const int32 cell = (z * SizeY + y) * SizeX + x;
+                        for (int32 i = _cellOffsets.Get()[cell]; i < _cellOffsets.Get()[cell + 1]; i++)
+                            testLight(_cellLights.Get()[i]);
+                    }
+                }
+            }
+            return count;
+        }
+    }
+
+    // Test all lights (object covers large part of the view or it's outside the grid)
+    for (int32 i = 0; i < _lights.Count(); i++)
+        testLight(i);
+    return count;
+}
+
+void RenderLocalLightsGrid::Clear()
+{
+    _isBuilt = false;
+    _lights.Clear();
+    _cellLights.Clear();
+}
+
+const RenderLocalLightsGrid& RenderList::GetLocalLightsGrid(const RenderView& view)
+{
+    LocalLightsGrid.Build(view, *this);
+    return LocalLightsGrid;
+}
+
 void RenderList::Clear()
 {
     Scenes.Clear();
@@ -402,6 +588,7 @@ void RenderList::Clear()
     ShadowDepthDrawCallsList.Clear();
     PointLights.Clear();
     SpotLights.Clear();
+    LocalLightsGrid.Clear();
     SkyLights.Clear();
     DirectionalLights.Clear();
     EnvironmentProbes.Clear();
@@ -459,6 +646,8 @@ void RenderList::AddDrawCall(const RenderContext& renderContext, DrawPass drawMo
     auto materialDrawModes = drawCall.Material->GetDrawModes();
     ASSERT_LOW_LAYER(drawModes != DrawPass::None && ((uint32)drawModes & ~(uint32)materialDrawModes) == 0);
 #endif
+    if (!renderContext.View.CanDrawStaticFlags(staticFlags))
+        return;
 
     // Append draw call data
     CalculateSortKey(renderContext, drawCall, sortOrder);
@@ -537,7 +726,7 @@ void RenderList::AddDrawCall(const RenderContextBatch& renderContextBatch, DrawP
         const RenderContext& renderContext = renderContextBatch.Contexts.Get()[i];
         ASSERT_LOW_LAYER(renderContext.View.Pass == DrawPass::Depth);
         drawModes = modes & renderContext.View.Pass;
-        if (drawModes != DrawPass::None && renderContext.View.CullingFrustum.Intersects(bounds))
+        if (drawModes != DrawPass::None && renderContext.View.CanDrawStaticFlags(staticFlags) && renderContext.View.CullingFrustum.Intersects(bounds))
         {
             renderContext.List->ShadowDepthDrawCallsList.Indices.Add(index);
         }
@@ -605,7 +794,7 @@ void RenderList::SortDrawCalls(const RenderContext& renderContext, bool reverseD
 
     // Sort draw calls indices
     int32* resultIndices = list.Indices.Get();
-    Sorting::RadixSort(sortedKeys, resultIndices, SortingKeys[1].Get(), SortingIndices.Get(), listSize);
+    Sorting::ParallelRadixSort(sortedKeys, resultIndices, SortingKeys[1].Get(), SortingIndices.Get(), listSize);
     if (resultIndices != list.Indices.Get())
         Platform::MemoryCopy(list.Indices.Get(), resultIndices, sizeof(int32) * listSize);
 
@@ -21,6 +21,8 @@ class IPostFxSettingsProvider;
 class CubeTexture;
 struct RenderContext;
 struct RenderContextBatch;
+struct RenderView;
+class RenderList;
 
 struct RendererDirectionalLightData
 {
@@ -265,6 +267,62 @@ struct DrawCallsList
     bool IsEmpty() const;
 };
 
+/// <summary>
+/// The CPU clustered grid of the local lights (point and spot lights) within the view frustum. Used to quickly find lights that affect forward-shaded objects (eg. transparent materials).
+/// </summary>
+struct FLAXENGINE_API RenderLocalLightsGrid
+{
+    enum
+    {
+        SizeX = 16,
+        SizeY = 8,
+        SizeZ = 16,
+        CellsCount = SizeX * SizeY * SizeZ,
+    };
+
+    struct LightInfo
+    {
+        Float3 Position;
+        float Radius;
+        float Luminance;
+    };
+
+private:
+    Matrix _view;
+    Matrix _projection;
+    float _near, _far, _depthSliceScale;
+    int32 _pointLightsCount, _spotLightsCount;
+    bool _isBuilt = false;
+    Array<LightInfo> _lights;
+    Array<int32> _cellOffsets;
+    Array<int32> _cellLights;
+
+public:
+    /// <summary>
+    /// Builds the lights grid for the given view. Skipped if grid is already valid for this view and lights.
+    /// </summary>
+    /// <param name="view">The rendering view.</param>
+    /// <param name="list">The rendering list with the lights.</param>
+    void Build(const RenderView& view, const RenderList& list);
+
+    /// <summary>
+    /// Finds the most important local lights that affect the given bounds (ranked by the light brightness and the distance to the object).
+    /// </summary>
+    /// <param name="bounds">The object bounds (in render space).</param>
+    /// <param name="lights">The output lights indices. Index is within PointLights of render list, or SpotLights if not less than PointLights count.</param>
+    /// <param name="maxLights">The maximum amount of lights to find.</param>
+    /// <returns>The amount of found lights.</returns>
+    int32 Query(const BoundingSphere& bounds, int32* lights, int32 maxLights) const;
+
+    /// <summary>
+    /// Clears the grid.
+    /// </summary>
+    void Clear();
+
+private:
+    bool GetCells(const Float3& center, float radius, Int3& min, Int3& max) const;
+};
+
 /// <summary>
 /// Rendering cache container object for the draw calls collecting, sorting and executing.
 /// </summary>
@@ -335,6 +393,11 @@ API_CLASS(Sealed) class FLAXENGINE_API RenderList : public ScriptingObject
     /// </summary>
     Array<RendererSkyLightData> SkyLights;
 
+    /// <summary>
+    /// Light pass members - local lights grid for the forward shading (point and spot lights). Built on the first use via GetLocalLightsGrid.
+    /// </summary>
+    RenderLocalLightsGrid LocalLightsGrid;
+
     /// <summary>
     /// Environment probes to use for rendering reflections
     /// </summary>
@@ -486,6 +549,13 @@ API_CLASS(Sealed) class FLAXENGINE_API RenderList : public ScriptingObject
     /// </summary>
     void Clear();
 
+    /// <summary>
+    /// Gets the local lights grid for the given view (builds it on the first use).
+    /// </summary>
+    /// <param name="view">The rendering view.</param>
+    /// <returns>The local lights grid.</returns>
+    const RenderLocalLightsGrid& GetLocalLightsGrid(const RenderView& view);
+
 public:
     /// <summary>
     /// Adds the draw call to the draw lists.
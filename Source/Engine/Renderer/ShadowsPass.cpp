@@ -7,8 +7,13 @@
 #include "Engine/Graphics/GPUContext.h"
 #include "Engine/Graphics/RenderTask.h"
 #include "Engine/Graphics/RenderBuffers.h"
+#include "Engine/Graphics/RenderTargetPool.h"
+#include "Engine/Graphics/RenderTools.h"
 #include "Engine/Graphics/PixelFormatExtensions.h"
 #include "Engine/Content/Content.h"
+#include "Engine/Core/Collections/Dictionary.h"
+#include "Engine/Engine/Engine.h"
+#include "Engine/Level/Scene/SceneRendering.h"
 #include "Engine/Scripting/Enums.h"
 #if USE_EDITOR
 #include "Engine/Renderer/Lightmaps.h"
@@ -17,6 +22,9 @@
 #define NormalOffsetScaleTweak 100.0f
 #define SpotLight_NearPlane 10.0f
 #define PointLight_NearPlane 10.0f
+#define MaxCachedShadowLights 32
+#define MaxCachedShadowMemory (64 * 1024 * 1024)
+#define CachedShadowLightLifetime 60
 
 PACK_STRUCT(struct Data{
     GBufferData GBuffer;
@@ -29,6 +37,74 @@ PACK_STRUCT(struct Data{
     float ContactShadowsLength;
     });
 
+// Cached shadow maps with static objects (StaticFlags::Transform) for static local lights. Invalidated when light or any static object within its range changes (including model streaming changes reported via SceneRendering::UpdateActor).
+// Static objects are skipped during scene collection for the dynamic-only shadow views (they keep the LOD picked when the cache was drawn).
+class ShadowsCustomBuffer : public RenderBuffers::CustomBuffer, public ISceneRenderingListener
+{
+public:
+    struct CachedLight
+    {
+        uint64 LastFrameUsed = 0;
+        uint32 Version = 1;
+        uint32 CachedVersion = 0;
+        BoundingSphere Bounds = BoundingSphere::Empty;
+        Matrix ViewProjection = Matrix::Identity;
+        GPUTexture* StaticShadowMap = nullptr;
+        uint64 StaticShadowMapMemory = 0;
+    };
+
+    Dictionary<Guid, CachedLight> Lights;
+    uint64 MemoryUsage = 0;
+
+    ~ShadowsCustomBuffer()
+    {
+        for (auto& e : Lights)
+            RenderTargetPool::Release(e.Value.StaticShadowMap);
+    }
+
+    void ReleaseShadowMap(CachedLight& light)
+    {
+        RenderTargetPool::Release(light.StaticShadowMap);
+        light.StaticShadowMap = nullptr;
+        MemoryUsage -= light.StaticShadowMapMemory;
+        light.StaticShadowMapMemory = 0;
+    }
+
+    void OnSceneRenderingDirty(Actor* a, const BoundingSphere& objectBounds)
+    {
+        if ((a->GetStaticFlags() & StaticFlags::Transform) == StaticFlags::None)
+            return;
+        for (auto& e : Lights)
+        {
+            if (e.Value.Bounds.Intersects(objectBounds))
+                e.Value.Version++;
+        }
+    }
+
+    // [ISceneRenderingListener]
+    void OnSceneRenderingAddActor(Actor* a) override
+    {
+        OnSceneRenderingDirty(a, a->GetSphere());
+    }
+
+    void OnSceneRenderingUpdateActor(Actor* a, const BoundingSphere& prevBounds) override
+    {
+        OnSceneRenderingDirty(a, prevBounds);
+        OnSceneRenderingDirty(a, a->GetSphere());
+    }
+
+    void OnSceneRenderingRemoveActor(Actor* a) override
+    {
+        OnSceneRenderingDirty(a, a->GetSphere());
+    }
+
+    void OnSceneRenderingClear(SceneRendering* scene) override
+    {
+        for (auto& e : Lights)
+            e.Value.Version++;
+    }
+};
+
 ShadowsPass::ShadowsPass()
     : _shader(nullptr)
     , _shadowMapsSizeCSM(0)
@@ -331,6 +407,8 @@ void ShadowsPass::SetupLight(RenderContext& renderContext, RenderContextBatch& r
     auto& shadowData = _shadowData.AddOne();
     shadowData.ContextIndex = renderContextBatch.Contexts.Count();
     shadowData.ContextCount = csmCount;
+    shadowData.StaticContextIndex = -1;
+    shadowData.StaticShadowMap = nullptr;
     shadowData.BlendCSM = blendCSM;
     renderContextBatch.Contexts.AddDefault(shadowData.ContextCount);
 
@@ -481,6 +559,7 @@ void ShadowsPass::SetupLight(RenderContext& renderContext, RenderContextBatch& r
         shadowContext.View.PrepareCache(shadowContext, shadowMapsSizeCube, shadowMapsSizeCube, Float2::Zero, &view);
         Matrix::Transpose(shadowContext.View.ViewProjection(), shadowData.Constants.ShadowVP[faceIndex]);
     }
+    SetupStaticShadow(renderContext, renderContextBatch, shadowData, light.ID, light.StaticFlags, BoundingSphere(view.Origin + light.Position, light.Radius));
 
     // Setup constant buffer data
     shadowData.Constants.ShadowMapSize = shadowMapsSizeCube;
@@ -520,6 +599,7 @@ void ShadowsPass::SetupLight(RenderContext& renderContext, RenderContextBatch& r
         shadowContext.View.PrepareCache(shadowContext, shadowMapsSizeCube, shadowMapsSizeCube, Float2::Zero, &view);
         Matrix::Transpose(shadowContext.View.ViewProjection(), shadowData.Constants.ShadowVP[faceIndex]);
     }
+    SetupStaticShadow(renderContext, renderContextBatch, shadowData, light.ID, light.StaticFlags, BoundingSphere(view.Origin + light.Position, light.Radius));
 
     // Setup constant buffer data
     shadowData.Constants.ShadowMapSize = shadowMapsSizeCube;
@@ -532,6 +612,139 @@ void ShadowsPass::SetupLight(RenderContext& renderContext, RenderContextBatch& r
     shadowData.Constants.CascadeSplits = Float4::Zero;
 }
 
+void ShadowsPass::SetupStaticShadow(RenderContext& renderContext, RenderContextBatch& renderContextBatch, ShadowData& shadowData, const Guid& lightId, StaticFlags lightFlags, const BoundingSphere& lightBounds)
+{
+    shadowData.StaticContextIndex = -1;
+    shadowData.StaticVersion = 0;
+    shadowData.StaticShadowMap = nullptr;
+    if (renderContext.View.IsOfflinePass || !renderContext.Buffers)
+        return;
+    auto& shadows = *renderContext.Buffers->GetCustomBuffer<ShadowsCustomBuffer>(TEXT("Shadows"));
+    auto* cachedLight = shadows.Lights.TryGet(lightId);
+
+    // Cache only static lights (release the cache of the light that became dynamic)
+    if ((lightFlags & StaticFlags::Transform) == StaticFlags::None)
+    {
+        if (cachedLight)
+        {
+            shadows.ReleaseShadowMap(*cachedLight);
+            shadows.Lights.Remove(lightId);
+        }
+        return;
+    }
+    if (!cachedLight)
+    {
+        if (shadows.Lights.Count() >= MaxCachedShadowLights)
+            return;
+        cachedLight = &shadows.Lights[lightId];
+    }
+    cachedLight->LastFrameUsed = Engine::FrameCount;
+
+    // Release the cache of the moving light (static objects would need to be redrawn every frame anyway)
+    const Matrix& viewProjection = renderContextBatch.Contexts[shadowData.ContextIndex].View.ViewProjection();
+    if (cachedLight->Bounds != lightBounds || cachedLight->ViewProjection != viewProjection)
+    {
+        shadows.ReleaseShadowMap(*cachedLight);
+        cachedLight->Bounds = lightBounds;
+        cachedLight->ViewProjection = viewProjection;
+        cachedLight->Version++;
+        return;
+    }
+
+    // Allocate the shadow map for the static objects (within the memory budget)
+    const bool isCube = shadowData.ContextCount == 6;
+    GPUTexture* staticShadowMap = cachedLight->StaticShadowMap;
+    if (!staticShadowMap || staticShadowMap->Width() != _shadowMapsSizeCube || staticShadowMap->IsCubeMap() != isCube)
+    {
+        shadows.ReleaseShadowMap(*cachedLight);
+        const auto flags = GPUTextureFlags::ShaderResource | GPUTextureFlags::DepthStencil;
+        const auto desc = isCube ? GPUTextureDescription::NewCube(_shadowMapsSizeCube, _shadowMapFormat, flags) : GPUTextureDescription::New2D(_shadowMapsSizeCube, _shadowMapsSizeCube, _shadowMapFormat, flags);
+        const uint64 memory = RenderTools::CalculateTextureMemoryUsage(desc.Format, desc.Width, desc.Height, desc.MipLevels) * desc.ArraySize;
+        if (shadows.MemoryUsage + memory > MaxCachedShadowMemory)
+            return;
+        staticShadowMap = RenderTargetPool::Get(desc);
+        if (!staticShadowMap)
+            return;
+        RENDER_TARGET_POOL_SET_NAME(staticShadowMap, "ShadowMap.Static");
+        cachedLight->StaticShadowMap = staticShadowMap;
+        cachedLight->StaticShadowMapMemory = memory;
+        shadows.MemoryUsage += memory;
+        cachedLight->Version++;
+    }
+    shadowData.StaticShadowMap = staticShadowMap;
+    shadowData.StaticVersion = cachedLight->Version;
+
+    // Draw only dynamic objects every frame
+    for (int32 i = 0; i < shadowData.ContextCount; i++)
+    {
+        auto& shadowContext = renderContextBatch.Contexts[shadowData.ContextIndex + i];
+        shadowContext.View.StaticFlagsMask = StaticFlags::Transform;
+        shadowContext.View.StaticFlagsMaskInverted = true;
+    }
+
+    // Draw static objects only when the cached shadow map is outdated
+    if (cachedLight->CachedVersion != cachedLight->Version)
+    {
+        shadowData.StaticContextIndex = renderContextBatch.Contexts.Count();
+        renderContextBatch.Contexts.AddDefault(shadowData.ContextCount);
+        for (int32 i = 0; i < shadowData.ContextCount; i++)
+        {
+            auto& staticContext = renderContextBatch.Contexts[shadowData.StaticContextIndex + i];
+            SetupRenderContext(renderContext, staticContext);
+            staticContext.List->Clear();
+            staticContext.View = renderContextBatch.Contexts[shadowData.ContextIndex + i].View;
+            staticContext.View.StaticFlagsMaskInverted = false;
+        }
+    }
+}
+
+void ShadowsPass::RenderShadowMap(GPUContext* context, RenderContextBatch& renderContextBatch, ShadowData& shadowData, const Guid& lightId, GPUTexture* shadowMap)
+{
+    RenderContext& renderContext = renderContextBatch.GetMainContext();
+    GPUTexture* staticShadowMap = shadowData.StaticShadowMap;
+    if (staticShadowMap && shadowData.StaticContextIndex != -1)
+    {
+        // Render static objects into the cached shadow map
+        PROFILE_GPU_CPU_NAMED("Static");
+        for (int32 faceIndex = 0; faceIndex < shadowData.ContextCount; faceIndex++)
+        {
+            auto rt = staticShadowMap->IsCubeMap() ? staticShadowMap->View(faceIndex) : staticShadowMap->View();
+            context->ResetSR();
+            context->SetRenderTarget(rt, static_cast<GPUTextureView*>(nullptr));
+            context->ClearDepth(rt);
+            auto& staticContext = renderContextBatch.Contexts[shadowData.StaticContextIndex + faceIndex];
+            staticContext.List->ExecuteDrawCalls(staticContext, DrawCallsListType::Depth);
+            staticContext.List->ExecuteDrawCalls(staticContext, staticContext.List->ShadowDepthDrawCallsList, renderContext.List->DrawCalls, nullptr);
+        }
+        context->ResetRenderTarget();
+
+        // Keep redrawing static objects while assets are still loading (eg. after level load) to not cache missing objects
+        auto* cachedLight = renderContext.Buffers->GetCustomBuffer<ShadowsCustomBuffer>(TEXT("Shadows"))->Lights.TryGet(lightId);
+        if (cachedLight && cachedLight->StaticShadowMap == staticShadowMap && Content::GetStats().LoadingAssetsCount == 0)
+            cachedLight->CachedVersion = shadowData.StaticVersion;
+    }
+
+    // Render dynamic objects (on top of the cached static objects depth)
+    for (int32 faceIndex = 0; faceIndex < shadowData.ContextCount; faceIndex++)
+    {
+        auto rt = shadowMap->View(faceIndex);
+        context->ResetSR();
+        if (staticShadowMap)
+        {
+            context->CopyTexture(shadowMap, faceIndex, 0, 0, 0, staticShadowMap, faceIndex);
+            context->SetRenderTarget(rt, static_cast<GPUTextureView*>(nullptr));
+        }
+        else
+        {
+            context->SetRenderTarget(rt, static_cast<GPUTextureView*>(nullptr));
+            context->ClearDepth(rt);
+        }
+        auto& shadowContext = renderContextBatch.Contexts[shadowData.ContextIndex + faceIndex];
+        shadowContext.List->ExecuteDrawCalls(shadowContext, DrawCallsListType::Depth);
+        shadowContext.List->ExecuteDrawCalls(shadowContext, shadowContext.List->ShadowDepthDrawCallsList, renderContext.List->DrawCalls, nullptr);
+    }
+}
+
 void ShadowsPass::Dispose()
 {
     // Base
@@ -567,6 +780,23 @@ void ShadowsPass::SetupShadows(RenderContext& renderContext, RenderContextBatch&
     auto shadowsQuality = Graphics::ShadowsQuality;
     maxShadowsQuality = Math::Clamp(Math::Min<int32>(static_cast<int32>(shadowsQuality), static_cast<int32>(view.MaxShadowsQuality)), 0, static_cast<int32>(Quality::MAX) - 1);
 
+    // Update cached shadow maps of the local lights (remove lights that are no longer visible)
+    if (renderContext.Buffers && !view.IsOfflinePass)
+    {
+        auto& shadows = *renderContext.Buffers->GetCustomBuffer<ShadowsCustomBuffer>(TEXT("Shadows"));
+        shadows.LastFrameUsed = Engine::FrameCount;
+        for (SceneRendering* scene : renderContext.List->Scenes)
+            shadows.ListenSceneRendering(scene);
+        for (auto it = shadows.Lights.Begin(); it.IsNotEnd(); ++it)
+        {
+            if (it->Value.LastFrameUsed + CachedShadowLightLifetime < Engine::FrameCount)
+            {
+                shadows.ReleaseShadowMap(it->Value);
+                shadows.Lights.Remove(it);
+            }
+        }
+    }
+
     // Create shadow projections for lights
     for (auto& light : renderContext.List->DirectionalLights)
     {
@@ -634,16 +864,7 @@ void ShadowsPass::RenderShadow(RenderContextBatch& renderContextBatch, RendererP
     context->SetViewportAndScissors(shadowMapsSizeCube, shadowMapsSizeCube);
 
     // Render depth to all 6 faces of the cube map
-    for (int32 faceIndex = 0; faceIndex < 6; faceIndex++)
-    {
-        auto rt = _shadowMapCube->View(faceIndex);
-        context->ResetSR();
-        context->SetRenderTarget(rt, static_cast<GPUTextureView*>(nullptr));
-        context->ClearDepth(rt);
-        auto& shadowContext = renderContextBatch.Contexts[shadowData.ContextIndex + faceIndex];
-        shadowContext.List->ExecuteDrawCalls(shadowContext, DrawCallsListType::Depth);
-        shadowContext.List->ExecuteDrawCalls(shadowContext, shadowContext.List->ShadowDepthDrawCallsList, renderContext.List->DrawCalls, nullptr);
-    }
+    RenderShadowMap(context, renderContextBatch, shadowData, light.ID, _shadowMapCube);
 
     // Restore GPU context
     context->ResetSR();
@@ -713,15 +934,7 @@ void ShadowsPass::RenderShadow(RenderContextBatch& renderContextBatch, RendererS
 
     // Render depth to all 1 face of the cube map
     constexpr int32 faceIndex = 0;
-    {
-        auto rt = _shadowMapCube->View(faceIndex);
-        context->ResetSR();
-        context->SetRenderTarget(rt, static_cast<GPUTextureView*>(nullptr));
-        context->ClearDepth(rt);
-        auto& shadowContext = renderContextBatch.Contexts[shadowData.ContextIndex + faceIndex];
-        shadowContext.List->ExecuteDrawCalls(shadowContext, DrawCallsListType::Depth);
-        shadowContext.List->ExecuteDrawCalls(shadowContext, shadowContext.List->ShadowDepthDrawCallsList, renderContext.List->DrawCalls, nullptr);
-    }
+    RenderShadowMap(context, renderContextBatch, shadowData, light.ID, _shadowMapCube);
 
     // Restore GPU context
     context->ResetSR();
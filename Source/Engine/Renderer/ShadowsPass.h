@@ -46,7 +46,10 @@ class ShadowsPass : public RendererPass<ShadowsPass>
     {
         int32 ContextIndex;
         int32 ContextCount;
+        int32 StaticContextIndex;
+        uint32 StaticVersion;
         bool BlendCSM;
+        GPUTexture* StaticShadowMap;
         LightShadowData Constants;
     };
 
@@ -157,6 +160,8 @@ class ShadowsPass : public RendererPass<ShadowsPass>
     void SetupLight(RenderContext& renderContext, RenderContextBatch& renderContextBatch, RendererDirectionalLightData& light);
     void SetupLight(RenderContext& renderContext, RenderContextBatch& renderContextBatch, RendererPointLightData& light);
     void SetupLight(RenderContext& renderContext, RenderContextBatch& renderContextBatch, RendererSpotLightData& light);
+    void SetupStaticShadow(RenderContext& renderContext, RenderContextBatch& renderContextBatch, ShadowData& shadowData, const Guid& lightId, StaticFlags lightFlags, const BoundingSphere& lightBounds);
+    void RenderShadowMap(GPUContext* context, RenderContextBatch& renderContextBatch, ShadowData& shadowData, const Guid& lightId, GPUTexture* shadowMap);
 
 #if COMPILE_WITH_DEV_ENV
     void OnShaderReloading(Asset* obj)
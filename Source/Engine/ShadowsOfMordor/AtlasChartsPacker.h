@@ -13,12 +13,12 @@ namespace ShadowsOfMordor
     {
     public:
 
-        struct Node : RectPack<Node>
+        struct Node : RectPackNode<uint32>
         {
             Builder::LightmapUVsChart* Chart = nullptr;
 
             Node(uint32 x, uint32 y, uint32 width, uint32 height)
-                : RectPack<Node>(x, y, width, height)
+                : RectPackNode<uint32>(x, y, width, height)
             {
             }
 
@@ -28,11 +28,15 @@ namespace ShadowsOfMordor
                 const float invSize = 1.0f / (int32)settings->AtlasSize;
                 chart->Result.UVsArea = Rectangle(X * invSize, Y * invSize, chart->Width * invSize, chart->Height * invSize);
             }
+
+            void OnFree()
+            {
+            }
         };
 
     private:
 
-        Node _root;
+        RectPackAtlas<Node> _atlas;
         const LightmapSettings* _settings;
 
     public:
@@ -42,7 +46,7 @@ namespace ShadowsOfMordor
         /// </summary>
         /// <param name="settings">The settings.</param>
         AtlasChartsPacker(const LightmapSettings* settings)
-            : _root(settings->ChartsPadding, settings->ChartsPadding, (int32)settings->AtlasSize - settings->ChartsPadding, (int32)settings->AtlasSize - settings->ChartsPadding)
+            : _atlas(settings->ChartsPadding, settings->ChartsPadding, (int32)settings->AtlasSize - settings->ChartsPadding, (int32)settings->AtlasSize - settings->ChartsPadding)
             , _settings(settings)
         {
         }
@@ -63,7 +67,7 @@ namespace ShadowsOfMordor
         /// <returns></returns>
         Node* Insert(Builder::LightmapUVsChart* chart)
         {
-            return _root.Insert(chart->Width, chart->Height, _settings->ChartsPadding, chart, _settings);
+            return _atlas.Insert(chart->Width, chart->Height, _settings->ChartsPadding, chart, _settings);
         }
     };
 };
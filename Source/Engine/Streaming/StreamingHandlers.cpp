@@ -10,6 +10,7 @@
 #include "Engine/Audio/AudioClip.h"
 #include "Engine/Audio/Audio.h"
 #include "Engine/Audio/AudioSource.h"
+#include "Engine/Threading/Threading.h"
 
 float TexturesStreamingHandler::CalculateTargetQuality(StreamableResource* resource, double currentTime)
 {
@@ -186,23 +187,30 @@ int32 AudioStreamingHandler::CalculateResidency(StreamableResource* resource, fl
     Platform::MemoryClear(chunksMask, sizeof(chunksMask));
 
     // Find audio chunks required for streaming
+    ScopeLock lock(clip->Locker);
     clip->StreamingQueue.Clear();
-    for (int32 sourceIndex = 0; sourceIndex < Audio::Sources.Count(); sourceIndex++)
+    for (AudioSource* src : clip->_sources)
     {
-        // TODO: collect refs to audio clip from sources and use faster iteration (but do it thread-safe)
-
-        const auto src = Audio::Sources[sourceIndex];
-        if (src->Clip == clip && src->GetState() != AudioSource::States::Stopped)
+        if (src->GetState() != AudioSource::States::Stopped)
         {
-            // Stream the current and the next chunk if could be used in a while
+            // Stream the current and the next chunk (source queues both of them)
             const int32 chunk = src->_streamingFirstChunk;
             ASSERT(Math::IsInRange(chunk, 0, chunksCount));
             chunksMask[chunk] = true;
-            
+            if (chunk + 1 < chunksCount)
+                chunksMask[chunk + 1] = true;
+
+            // Read-ahead the chunk after the next one if it could be used in a while so it's ready before the source moves on
             const float StreamingDstSec = 2.0f; // TODO: make it configurable via StreamingSettings
-            if (chunk + 1 < chunksCount && src->GetTime() + StreamingDstSec >= clip->GetBufferStartTime(src->_streamingFirstChunk))
+            if (src->GetTime() + StreamingDstSec >= clip->GetBufferStartTime(Math::Min(chunk + 1, chunksCount)))
             {
-                chunksMask[chunk + 1] = true;
+                for (int32 i = chunk + 1; i <= chunk + 2; i++)
+                {
+                    if (i < chunksCount)
+                        chunksMask[i] = true;
+                    else if (src->GetIsLooping())
+                        chunksMask[i % chunksCount] = true;
+                }
             }
         }
     }
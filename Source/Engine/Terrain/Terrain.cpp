@@ -2,7 +2,9 @@
 
 #include "Terrain.h"
 #include "TerrainPatch.h"
+#include "TerrainManager.h"
 #include "Engine/Core/Log.h"
+#include "Engine/Core/SIMD.h"
 #include "Engine/Core/Math/Ray.h"
 #include "Engine/Level/Scene/SceneRendering.h"
 #include "Engine/Serialization/Serialization.h"
@@ -27,6 +29,7 @@ Terrain::Terrain(const SpawnParams& params)
     , _chunkSize(0)
     , _scaleInLightmap(0.1f)
     , _lodDistribution(0.6f)
+    , _collisionStreamingDistance(0.0f)
     , _boundsExtent(Vector3::Zero)
     , _cachedScale(1.0f)
 {
@@ -286,6 +289,94 @@ void Terrain::SetCollisionLOD(int32 value)
 #endif
 }
 
+void Terrain::SetCollisionStreamingDistance(float value)
+{
+    value = Math::Max(value, 0.0f);
+    if (Math::NearEqual(value, _collisionStreamingDistance))
+        return;
+    _collisionStreamingDistance = value;
+
+    // Restore collision for all patches when streaming gets disabled
+    if (value <= 0.0f && IsDuringPlay())
+    {
+        for (TerrainPatch* patch : _patches)
+        {
+            patch->CancelCollisionStreaming();
+            if (!patch->HasCollision())
+                patch->CreateCollision();
+        }
+        UpdateLayerBits();
+    }
+}
+
+void Terrain::SetStreamingPoints(const Array<Vector3>& points)
+{
+    TerrainManager::SetStreamingPoints(points);
+}
+
+TerrainStreamingStats Terrain::GetStreamingStats() const
+{
+    TerrainStreamingStats stats;
+    stats.PatchesCount = _patches.Count();
+    for (const TerrainPatch* patch : _patches)
+    {
+        if (const RawDataAsset* heightfield = patch->_heightfield.Get())
+            stats.CollisionDataMemory += heightfield->Data.Count();
+        if (patch->HasCollision())
+        {
+            stats.CollisionPatchesCount++;
+        }
+        else if (Platform::AtomicRead(&patch->_collisionStreamingState) != 0)
+        {
+            stats.PendingCollisionPatchesCount++;
+        }
+        if (patch->Heightmap && patch->Heightmap->GetTexture())
+            stats.TexturesMemory += patch->Heightmap->GetTexture()->GetMemoryUsage();
+        for (int32 i = 0; i < TERRAIN_MAX_SPLATMAPS_COUNT; i++)
+        {
+            if (patch->Splatmap[i] && patch->Splatmap[i]->GetTexture())
+                stats.TexturesMemory += patch->Splatmap[i]->GetTexture()->GetMemoryUsage();
+        }
+#if TERRAIN_UPDATING
+        stats.CachedDataMemory += patch->_cachedHeightMap.Count() * sizeof(float);
+        stats.CachedDataMemory += patch->_cachedHolesMask.Count() * sizeof(byte);
+        for (int32 i = 0; i < TERRAIN_MAX_SPLATMAPS_COUNT; i++)
+            stats.CachedDataMemory += patch->_cachedSplatMap[i].Count() * sizeof(Color32);
+#endif
+    }
+    return stats;
+}
+
+void Terrain::UpdateCollisionStreaming(const Array<Vector3>& points)
+{
+    if (_collisionStreamingDistance <= 0.0f)
+        return;
+    PROFILE_CPU();
+
+    // Use a margin for streaming out to prevent collision recreation when moving around the range edge
+    const Real streamInDistance = _collisionStreamingDistance;
+    const Real streamOutDistance = _collisionStreamingDistance * 1.2f;
+    bool anyAdded = false;
+    for (TerrainPatch* patch : _patches)
+    {
+        Real minDistance = MAX_Real;
+        for (const Vector3& point : points)
+            minDistance = Math::Min(minDistance, CollisionsHelper::DistanceBoxPoint(patch->_bounds, point));
+        if (minDistance <= streamInDistance)
+        {
+            const bool hadCollision = patch->HasCollision();
+            patch->UpdateCollisionStreaming(true);
+            anyAdded |= !hadCollision && patch->HasCollision();
+        }
+        else if (minDistance > streamOutDistance)
+        {
+            patch->UpdateCollisionStreaming(false);
+        }
+    }
+    if (anyAdded)
+        UpdateLayerBits();
+}
+
 void Terrain::SetPhysicalMaterials(const Array<JsonAssetReference<PhysicalMaterial>, FixedAllocation<8>>& value)
 {
     _physicalMaterials = value;
@@ -559,53 +650,199 @@ void Terrain::Draw(RenderContext& renderContext)
         return;
     }
 
-    // Collect chunks to render and calculate LOD/material for them (required to be done before to gather NeighborLOD)
-    _drawChunks.Clear();
+    RenderContext* renderContextPtr = &renderContext;
+    DrawChunks(&renderContextPtr, 1);
+}
 
-    // Frustum vs Box culling for patches
-    const BoundingFrustum frustum = renderContext.View.CullingFrustum;
-    const Vector3 origin = renderContext.View.Origin;
-    for (int32 patchIndex = 0; patchIndex < _patches.Count(); patchIndex++)
+void Terrain::Draw(RenderContextBatch& renderContextBatch)
+{
+    PROFILE_CPU();
+    Array<RenderContext*, InlinedAllocation<16>> renderContexts;
+    for (RenderContext& renderContext : renderContextBatch.Contexts)
     {
-        const auto patch = _patches[patchIndex];
-        BoundingBox bounds(patch->_bounds.Minimum - origin, patch->_bounds.Maximum - origin);
-        if (renderContext.View.IsCullingDisabled || frustum.Intersects(bounds))
+        const DrawPass pass = renderContext.View.Pass;
+        if ((DrawModes & pass) == DrawPass::None)
+            continue;
+        if (pass == DrawPass::GlobalSDF || pass == DrawPass::GlobalSurfaceAtlas)
+            Draw(renderContext);
+        else
+            renderContexts.Add(&renderContext);
+    }
+    if (renderContexts.HasItems())
+        DrawChunks(renderContexts.Get(), renderContexts.Count());
+}
+
+void Terrain::CacheDrawTable()
+{
+    PROFILE_CPU();
+    _drawTableDirty = false;
+    auto& table = _drawTable;
+    table.Origin = _box.GetCenter();
+    table.Count = _patches.Count() * Terrain::ChunksCount;
+    table.Stride = Math::AlignUp(table.Count, 4);
+    table.Bounds.Resize(table.Stride * 6, false);
+    table.Chunks.Resize(table.Count, false);
+    float* bounds = table.Bounds.Get();
+    Platform::MemoryClear(bounds, table.Bounds.Count() * sizeof(float));
+    for (int32 patchIndex = 0, i = 0; patchIndex < _patches.Count(); patchIndex++)
+    {
+        TerrainPatch* patch = _patches.Get()[patchIndex];
+        for (int32 chunkIndex = 0; chunkIndex < Terrain::ChunksCount; chunkIndex++, i++)
         {
-            // Skip if has no heightmap or it's not loaded
-            if (patch->Heightmap == nullptr || patch->Heightmap->GetTexture()->ResidentMipLevels() == 0)
-                continue;
+            TerrainChunk* chunk = &patch->Chunks[chunkIndex];
+            const Float3 center = chunk->_bounds.GetCenter() - table.Origin;
+            const Float3 extent = chunk->_bounds.GetSize() * 0.5f;
+            bounds[table.Stride * 0 + i] = center.X;
+            bounds[table.Stride * 1 + i] = center.Y;
+            bounds[table.Stride * 2 + i] = center.Z;
+            bounds[table.Stride * 3 + i] = extent.X;
+            bounds[table.Stride * 4 + i] = extent.Y;
+            bounds[table.Stride * 5 + i] = extent.Z;
+            table.Chunks.Get()[i] = chunk;
+        }
+    }
+}
 
-            // Frustum vs Box culling for chunks
-            for (int32 chunkIndex = 0; chunkIndex < Terrain::ChunksCount; chunkIndex++)
+void Terrain::CullChunks(const float* bounds, int32 count, int32 stride, const BoundingFrustum& frustum, const Float3& frustumOffset, bool cullingDisabled, const Float3& lodPosition, float lodScale, bool* visible, float* distances)
+{
+    // Move frustum planes into the bounds space
+    SimdVector4 planeNX[6], planeNY[6], planeNZ[6], planeAX[6], planeAY[6], planeAZ[6], planeD[6];
+    for (int32 i = 0; i < 6; i++)
+    {
+        const Plane plane = frustum.GetPlane(i);
+        const Float3 normal = plane.Normal;
+        planeNX[i] = SIMD::Splat(normal.X);
+        planeNY[i] = SIMD::Splat(normal.Y);
+        planeNZ[i] = SIMD::Splat(normal.Z);
+        planeAX[i] = SIMD::Splat(Math::Abs(normal.X));
+        planeAY[i] = SIMD::Splat(Math::Abs(normal.Y));
+        planeAZ[i] = SIMD::Splat(Math::Abs(normal.Z));
+        planeD[i] = SIMD::Splat((float)plane.D + Float3::Dot(normal, frustumOffset) - Plane::DistanceEpsilon);
+    }
+    const SimdVector4 lodX = SIMD::Splat(lodPosition.X);
+    const SimdVector4 lodY = SIMD::Splat(lodPosition.Y);
+    const SimdVector4 lodZ = SIMD::Splat(lodPosition.Z);
+    const SimdVector4 lodScaleV = SIMD::Splat(lodScale);
+
+    for (int32 i = 0; i < count; i += 4)
+    {
+        const SimdVector4 centerX = SIMD::Load(bounds + stride * 0 + i);
+        const SimdVector4 centerY = SIMD::Load(bounds + stride * 1 + i);
+        const SimdVector4 centerZ = SIMD::Load(bounds + stride * 2 + i);
+        const SimdVector4 extentX = SIMD::Load(bounds + stride * 3 + i);
+        const SimdVector4 extentY = SIMD::Load(bounds + stride * 4 + i);
+        const SimdVector4 extentZ = SIMD::Load(bounds + stride * 5 + i);
+
+        // Frustum vs Box culling (box is outside if it's fully behind any plane)
+        int32 outsideMask = 0;
+        if (!cullingDisabled)
+        {
+            for (int32 planeIndex = 0; planeIndex < 6; planeIndex++)
             {
-                auto chunk = &patch->Chunks[chunkIndex];
-                chunk->_cachedDrawLOD = 0;
-                bounds = BoundingBox(chunk->_bounds.Minimum - origin, chunk->_bounds.Maximum - origin);
-                if (renderContext.View.IsCullingDisabled || frustum.Intersects(bounds))
-                {
-                    if (chunk->PrepareDraw(renderContext))
-                    {
-                        // Add chunk for drawing
-                        _drawChunks.Add(chunk);
-                    }
-                }
+                SimdVector4 distance = SIMD::Add(SIMD::Mul(planeNX[planeIndex], centerX), planeD[planeIndex]);
+                distance = SIMD::Add(distance, SIMD::Mul(planeNY[planeIndex], centerY));
+                distance = SIMD::Add(distance, SIMD::Mul(planeNZ[planeIndex], centerZ));
+                distance = SIMD::Add(distance, SIMD::Mul(planeAX[planeIndex], extentX));
+                distance = SIMD::Add(distance, SIMD::Mul(planeAY[planeIndex], extentY));
+                distance = SIMD::Add(distance, SIMD::Mul(planeAZ[planeIndex], extentZ));
+                outsideMask |= SIMD::MoveMask(distance);
             }
         }
-        else
+
+        // Box distance to view (scaled)
+        const SimdVector4 deltaX = SIMD::Sub(centerX, lodX);
+        const SimdVector4 deltaY = SIMD::Sub(centerY, lodY);
+        const SimdVector4 deltaZ = SIMD::Sub(centerZ, lodZ);
+        SimdVector4 distance = SIMD::Mul(deltaX, deltaX);
+        distance = SIMD::Add(distance, SIMD::Mul(deltaY, deltaY));
+        distance = SIMD::Add(distance, SIMD::Mul(deltaZ, deltaZ));
+        SIMD::Store(distances + i, SIMD::Mul(SIMD::Sqrt(distance), lodScaleV));
+
+        const int32 laneCount = Math::Min(count - i, 4);
+        for (int32 lane = 0; lane < laneCount; lane++)
+            visible[i + lane] = (outsideMask & (1 << lane)) == 0;
+    }
+}
+
+void Terrain::DrawChunks(RenderContext* const* renderContexts, int32 renderContextsCount)
+{
+    if (_drawTableDirty || _drawTable.Count != _patches.Count() * Terrain::ChunksCount)
+        CacheDrawTable();
+    auto& table = _drawTable;
+    const int32 count = table.Count;
+    if (count == 0)
+        return;
+    const int32 stride = table.Stride;
+    const float* bounds = table.Bounds.Get();
+
+    // Skip patches that have no heightmap or it's not loaded
+    table.PatchLODs.Resize(_patches.Count(), false);
+    for (int32 patchIndex = 0; patchIndex < _patches.Count(); patchIndex++)
+    {
+        const TerrainPatch* patch = _patches.Get()[patchIndex];
+        Int2& lods = table.PatchLODs.Get()[patchIndex];
+        const int32 residentLods = patch->Heightmap ? patch->Heightmap->GetTexture()->ResidentMipLevels() : 0;
+        if (residentLods == 0)
         {
-            // Reset cached LOD for chunks (prevent LOD transition from invisible chunks)
-            for (int32 chunkIndex = 0; chunkIndex < Terrain::ChunksCount; chunkIndex++)
+            lods = Int2(-1);
+            continue;
+        }
+        const int32 lodCount = patch->Heightmap->StreamingTexture()->TotalMipLevels();
+        lods = Int2(lodCount - residentLods, lodCount - 1);
+    }
+
+    // Calculate visibility and LOD for all chunks in all views (vectorized over 4 chunks at once)
+    table.LODs.Resize(count * renderContextsCount, false);
+    table.Visible.Resize(count * renderContextsCount, false);
+    table.Distances.Resize(stride, false);
+    const float chunkEdgeSizeInv = 1.0f / ((float)_chunkSize * TERRAIN_UNITS_PER_VERTEX);
+    const int32 forcedLod = _forcedLod;
+    for (int32 viewIndex = 0; viewIndex < renderContextsCount; viewIndex++)
+    {
+        const RenderContext& renderContext = *renderContexts[viewIndex];
+        const RenderView& view = renderContext.View;
+        const RenderView& lodView = renderContext.LodProxyView ? *renderContext.LodProxyView : view;
+
+        // Cull chunks and calculate their distance to the LOD view
+        bool* viewVisible = table.Visible.Get() + viewIndex * count;
+        const Float3 frustumOffset = table.Origin - view.Origin;
+        Float3 lodPosition = lodView.Origin - table.Origin;
+        lodPosition += lodView.Position;
+        CullChunks(bounds, count, stride, view.CullingFrustum, frustumOffset, view.IsCullingDisabled, lodPosition, chunkEdgeSizeInv, viewVisible, table.Distances.Get());
+
+        // Pick LOD for visible chunks
+        byte* viewLODs = table.LODs.Get() + viewIndex * count;
+        for (int32 chunkIndex = 0; chunkIndex < count; chunkIndex++)
+        {
+            const Int2 patchLODs = table.PatchLODs.Get()[chunkIndex / Terrain::ChunksCount];
+            const bool visible = viewVisible[chunkIndex] && patchLODs.X != -1;
+            int32 lod = 0;
+            if (visible)
             {
-                auto chunk = &patch->Chunks[chunkIndex];
-                chunk->_cachedDrawLOD = 0;
+                lod = forcedLod >= 0 ? forcedLod : (int32)Math::Pow(table.Distances.Get()[chunkIndex], _lodDistribution) + _lodBias;
+                lod = Math::Clamp(lod, patchLODs.X, patchLODs.Y);
             }
+            viewVisible[chunkIndex] = visible;
+            viewLODs[chunkIndex] = (byte)lod;
         }
     }
 
-    // Draw all visible chunks
-    for (int32 i = 0; i < _drawChunks.Count(); i++)
+    // Generate draw calls for each view (chunks LOD for the view has to be known before to gather NeighborLOD)
+    for (int32 viewIndex = 0; viewIndex < renderContextsCount; viewIndex++)
     {
-        _drawChunks.Get()[i]->Draw(renderContext);
+        const RenderContext& renderContext = *renderContexts[viewIndex];
+        const byte* viewLODs = table.LODs.Get() + viewIndex * count;
+        const bool* viewVisible = table.Visible.Get() + viewIndex * count;
+        _drawChunks.Clear();
+        for (int32 i = 0; i < count; i++)
+        {
+            TerrainChunk* chunk = table.Chunks.Get()[i];
+            chunk->_cachedDrawLOD = 0;
+            if (viewVisible[i] && chunk->PrepareDraw((int32)viewLODs[i]))
+                _drawChunks.Add(chunk);
+        }
+        for (int32 i = 0; i < _drawChunks.Count(); i++)
+            _drawChunks.Get()[i]->Draw(renderContext);
     }
 }
 
@@ -673,6 +910,7 @@ void Terrain::Serialize(SerializeStream& stream, const void* otherObj)
     SERIALIZE_MEMBER(ScaleInLightmap, _scaleInLightmap);
     SERIALIZE_MEMBER(BoundsExtent, _boundsExtent);
     SERIALIZE_MEMBER(CollisionLOD, _collisionLod);
+    SERIALIZE_MEMBER(CollisionStreamingDistance, _collisionStreamingDistance);
     SERIALIZE_MEMBER(PhysicalMaterials, _physicalMaterials);
     SERIALIZE(Material);
     SERIALIZE(DrawModes);
@@ -720,6 +958,7 @@ void Terrain::Deserialize(DeserializeStream& stream, ISerializeModifier* modifie
     DESERIALIZE_MEMBER(LODDistribution, _lodDistribution);
     DESERIALIZE_MEMBER(ScaleInLightmap, _scaleInLightmap);
     DESERIALIZE_MEMBER(BoundsExtent, _boundsExtent);
+    DESERIALIZE_MEMBER(CollisionStreamingDistance, _collisionStreamingDistance);
     DESERIALIZE_MEMBER(PhysicalMaterials, _physicalMaterials);
     DESERIALIZE(Material);
     DESERIALIZE(DrawModes);
@@ -899,15 +1138,19 @@ void Terrain::BeginPlay(SceneBeginData* data)
 {
     CacheNeighbors();
     _cachedScale = _transform.Scale;
-    for (int32 pathIndex = 0; pathIndex < _patches.Count(); pathIndex++)
+    if (_collisionStreamingDistance <= 0.0f)
     {
-        const auto patch = _patches[pathIndex];
-        if (!patch->HasCollision())
+        for (int32 pathIndex = 0; pathIndex < _patches.Count(); pathIndex++)
         {
-            patch->CreateCollision();
+            const auto patch = _patches[pathIndex];
+            if (!patch->HasCollision())
+            {
+                patch->CreateCollision();
+            }
         }
     }
     UpdateLayerBits();
+    TerrainManager::AddTerrain(this);
 
     // Base
     Actor::BeginPlay(data);
@@ -915,9 +1158,11 @@ void Terrain::BeginPlay(SceneBeginData* data)
 
 void Terrain::EndPlay()
 {
+    TerrainManager::RemoveTerrain(this);
     for (int32 pathIndex = 0; pathIndex < _patches.Count(); pathIndex++)
     {
         const auto patch = _patches[pathIndex];
+        patch->CancelCollisionStreaming();
         if (patch->HasCollision())
         {
             patch->DestroyCollision();
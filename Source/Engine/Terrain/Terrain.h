@@ -32,6 +32,44 @@ struct RenderView;
 // Terrain splatmaps amount limit. Each splatmap can hold up to 4 layer weights.
 #define TERRAIN_MAX_SPLATMAPS_COUNT 2
 
+/// <summary>
+/// The terrain data streaming and memory statistics.
+/// </summary>
+API_STRUCT(NoDefault) struct FLAXENGINE_API TerrainStreamingStats
+{
+    DECLARE_SCRIPTING_TYPE_MINIMAL(TerrainStreamingStats);
+
+    /// <summary>
+    /// The amount of terrain patches.
+    /// </summary>
+    API_FIELD() int32 PatchesCount = 0;
+
+    /// <summary>
+    /// The amount of terrain patches with created (resident) collision.
+    /// </summary>
+    API_FIELD() int32 CollisionPatchesCount = 0;
+
+    /// <summary>
+    /// The amount of terrain patches with collision being created asynchronously.
+    /// </summary>
+    API_FIELD() int32 PendingCollisionPatchesCount = 0;
+
+    /// <summary>
+    /// The memory used by the loaded collision height fields data (in bytes). Includes patches that hold the data without created collision (eg. pending or with unsaved modifications).
+    /// </summary>
+    API_FIELD() uint64 CollisionDataMemory = 0;
+
+    /// <summary>
+    /// The GPU memory used by the resident heightmap and splatmap textures mips (in bytes).
+    /// </summary>
+    API_FIELD() uint64 TexturesMemory = 0;
+
+    /// <summary>
+    /// The memory used by the heightmap, holes and splatmap data cached on a CPU (in bytes).
+    /// </summary>
+    API_FIELD() uint64 CachedDataMemory = 0;
+};
+
 /// <summary>
 /// Represents a single terrain object.
 /// </summary>
@@ -69,10 +107,33 @@ API_CLASS(Sealed) class FLAXENGINE_API Terrain : public PhysicsColliderActor
     int32 _sceneRenderingKey = -1;
     float _scaleInLightmap;
     float _lodDistribution;
+    float _collisionStreamingDistance;
     Vector3 _boundsExtent;
     Float3 _cachedScale;
     Array<TerrainPatch*, InlinedAllocation<64>> _patches;
     Array<TerrainChunk*> _drawChunks;
+
+    // Terrain-wide chunks table in SoA layout used to cull and pick LOD for all chunks (and all views) in a single pass
+    struct DrawTable
+    {
+        // Origin of the chunk positions (for large worlds precision).
+        Vector3 Origin;
+        // Amount of chunks (arrays are padded to the multiple of 4).
+        int32 Count = 0;
+        int32 Stride = 0;
+        // Chunks bounds: CenterX, CenterY, CenterZ, ExtentX, ExtentY, ExtentZ (each has Stride elements).
+        Array<float> Bounds;
+        Array<TerrainChunk*> Chunks;
+        // Per-view results (Count elements for each view).
+        Array<byte> LODs;
+        Array<bool> Visible;
+        // Temporary chunks distances to the view (Stride elements).
+        Array<float> Distances;
+        // Per-patch LOD range (-1 if patch cannot be drawn).
+        Array<Int2> PatchLODs;
+    };
+    DrawTable _drawTable;
+    bool _drawTableDirty = true;
     Array<JsonAssetReference<PhysicalMaterial>, FixedAllocation<8>> _physicalMaterials;
 
 public:
@@ -185,6 +246,20 @@ API_CLASS(Sealed) class FLAXENGINE_API Terrain : public PhysicsColliderActor
     /// </summary>
     API_PROPERTY() void SetCollisionLOD(int32 value);
 
+    /// <summary>
+    /// Gets the distance from the streaming points (eg. players or main camera) within which terrain patches have collision created. Patches further away have their collision released (asynchronously created again when coming back into range). Value 0 disables streaming and keeps collision for all patches.
+    /// </summary>
+    API_PROPERTY(Attributes="EditorOrder(510), DefaultValue(0.0f), Limit(0), EditorDisplay(\"Collision\")")
+    FORCE_INLINE float GetCollisionStreamingDistance() const
+    {
+        return _collisionStreamingDistance;
+    }
+
+    /// <summary>
+    /// Sets the distance from the streaming points (eg. players or main camera) within which terrain patches have collision created. Patches further away have their collision released (asynchronously created again when coming back into range). Value 0 disables streaming and keeps collision for all patches.
+    /// </summary>
+    API_PROPERTY() void SetCollisionStreamingDistance(float value);
+
     /// <summary>
     /// Gets the list with physical materials used to define the terrain collider physical properties - each for terrain layer (layer index matches index in this array).
     /// </summary>
@@ -358,6 +433,23 @@ API_CLASS(Sealed) class FLAXENGINE_API Terrain : public PhysicsColliderActor
     API_FUNCTION() void RemovePatch(API_PARAM(Ref) const Int2& patchCoord);
 #endif
 
+    /// <summary>
+    /// Sets the world-space points of interest used for terrain collision streaming (eg. players positions on a server). If empty, the main camera position is used.
+    /// </summary>
+    /// <param name="points">The streaming points locations.</param>
+    API_FUNCTION() static void SetStreamingPoints(const Array<Vector3>& points);
+
+    /// <summary>
+    /// Gets the terrain data streaming and memory statistics.
+    /// </summary>
+    API_FUNCTION() TerrainStreamingStats GetStreamingStats() const;
+
+    /// <summary>
+    /// Updates the terrain patches collision residency based on the distance to the streaming points. Called by the terrain manager.
+    /// </summary>
+    /// <param name="points">The streaming points locations.</param>
+    void UpdateCollisionStreaming(const Array<Vector3>& points);
+
     /// <summary>
     /// Updates the cached bounds of the actor. Updates the cached world bounds for every patch and chunk.
     /// </summary>
@@ -424,10 +516,28 @@ API_CLASS(Sealed) class FLAXENGINE_API Terrain : public PhysicsColliderActor
 #if TERRAIN_USE_PHYSICS_DEBUG
     void DrawPhysicsDebug(RenderView& view);
 #endif
+    void CacheDrawTable();
+    void DrawChunks(RenderContext* const* renderContexts, int32 renderContextsCount);
 
 public:
+    /// <summary>
+    /// Culls the boxes against the view frustum and calculates their distance to the view (vectorized over 4 boxes at once). Used to cull terrain chunks and pick their LOD.
+    /// </summary>
+    /// <param name="bounds">The boxes in SoA layout: CenterX, CenterY, CenterZ, ExtentX, ExtentY, ExtentZ (each has stride elements). Must be 16-bytes aligned.</param>
+    /// <param name="count">The amount of boxes.</param>
+    /// <param name="stride">The amount of elements in each bounds component (count aligned up to the multiple of 4).</param>
+    /// <param name="frustum">The view frustum.</param>
+    /// <param name="frustumOffset">The offset to apply to the frustum planes to move them into the bounds space.</param>
+    /// <param name="cullingDisabled">True if skip frustum culling and mark all boxes as visible.</param>
+    /// <param name="lodPosition">The view position (in the bounds space) to calculate distance to.</param>
+    /// <param name="lodScale">The scale applied to the calculated distances.</param>
+    /// <param name="visible">The output visibility of the boxes (count elements).</param>
+    /// <param name="distances">The output scaled distances to the view (stride elements, 16-bytes aligned).</param>
+    static void CullChunks(const float* bounds, int32 count, int32 stride, const BoundingFrustum& frustum, const Float3& frustumOffset, bool cullingDisabled, const Float3& lodPosition, float lodScale, bool* visible, float* distances);
+
     // [PhysicsColliderActor]
     void Draw(RenderContext& renderContext) override;
+    void Draw(RenderContextBatch& renderContextBatch) override;
 #if USE_EDITOR
     void OnDebugDrawSelected() override;
 #endif
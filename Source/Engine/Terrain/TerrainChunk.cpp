@@ -38,8 +38,6 @@ bool TerrainChunk::PrepareDraw(const RenderContext& renderContext)
     // Calculate LOD
     int32 lod;
     const int32 forcedLod = _patch->_terrain->_forcedLod;
-    const int32 lodCount = _patch->Heightmap.Get()->StreamingTexture()->TotalMipLevels();
-    const int32 minStreamedLod = lodCount - _patch->Heightmap.Get()->GetTexture()->ResidentMipLevels();
     if (forcedLod >= 0)
     {
         lod = forcedLod;
@@ -62,6 +60,13 @@ bool TerrainChunk::PrepareDraw(const RenderContext& renderContext)
         //lod = (int32)Vector2::Distance(Vector2(2, 2), Vector2(_patch->_x, _patch->_z) * Terrain::ChunksCountEdge + Vector2(_x, _z));
         //lod = (int32)(Vector3::Distance(_bounds.GetCenter(), view.Position) / 10000.0f);
     }
+    return PrepareDraw(lod);
+}
+
+bool TerrainChunk::PrepareDraw(int32 lod)
+{
+    const int32 lodCount = _patch->Heightmap.Get()->StreamingTexture()->TotalMipLevels();
+    const int32 minStreamedLod = lodCount - _patch->Heightmap.Get()->GetTexture()->ResidentMipLevels();
     lod = Math::Clamp(lod, minStreamedLod, lodCount - 1);
 
     // Pick a material
@@ -200,6 +205,7 @@ bool TerrainChunk::Intersects(const Ray& ray, Real& distance)
 
 void TerrainChunk::UpdateBounds()
 {
+    _patch->_terrain->_drawTableDirty = true;
     const Vector3 boundsExtent = _patch->_terrain->_boundsExtent;
     const float size = (float)_patch->_terrain->_chunkSize * TERRAIN_UNITS_PER_VERTEX;
     const Transform terrainTransform = _patch->_terrain->_transform;
@@ -124,6 +124,13 @@ API_CLASS(Sealed, NoSpawn) class FLAXENGINE_API TerrainChunk : public ScriptingO
     /// <returns>True if draw chunk, otherwise false.</returns>
     bool PrepareDraw(const RenderContext& renderContext);
 
+    /// <summary>
+    /// Prepares for drawing chunk with a given LOD (eg. calculated by the terrain for many chunks at once). Caches LOD and material.
+    /// </summary>
+    /// <param name="lod">The chunk LOD to draw (clamped to the valid range).</param>
+    /// <returns>True if draw chunk, otherwise false.</returns>
+    bool PrepareDraw(int32 lod);
+
     /// <summary>
     /// Draws the chunk (adds the draw call). Must be called after PrepareDraw.
     /// </summary>
@@ -14,6 +14,8 @@
 #include "Engine/Content/AssetReference.h"
 #include "Engine/Core/Log.h"
 #include "Engine/Renderer/DrawCall.h"
+#include "Engine/Level/Actors/Camera.h"
+#include "Engine/Profiler/ProfilerCPU.h"
 
 // Must match structure defined in Terrain.shader
 struct TerrainVertex
@@ -49,6 +51,8 @@ ChunkedArray<GeometryData, 1024> Pool;
 Dictionary<uint32, GeometryData*> Lookup;
 Array<byte> TempData;
 AssetReference<MaterialBase> DefaultTerrainMaterial;
+Array<Terrain*> StreamingTerrains;
+Array<Vector3> StreamingPoints;
 
 class TerrainManagerService : public EngineService
 {
@@ -60,6 +64,7 @@ class TerrainManagerService : public EngineService
     }
 
     bool Init() override;
+    void Update() override;
     void BeforeExit() override;
 };
 
@@ -210,6 +215,21 @@ bool TerrainManager::GetChunkGeometry(DrawCall& drawCall, int32 chunkSize, int32
     return false;
 }
 
+void TerrainManager::SetStreamingPoints(const Array<Vector3>& points)
+{
+    StreamingPoints = points;
+}
+
+void TerrainManager::AddTerrain(Terrain* terrain)
+{
+    StreamingTerrains.AddUnique(terrain);
+}
+
+void TerrainManager::RemoveTerrain(Terrain* terrain)
+{
+    StreamingTerrains.Remove(terrain);
+}
+
 bool TerrainManagerService::Init()
 {
     // Load default terrain material as fallback
@@ -222,8 +242,29 @@ bool TerrainManagerService::Init()
     return false;
 }
 
+void TerrainManagerService::Update()
+{
+    if (StreamingTerrains.IsEmpty())
+        return;
+    PROFILE_CPU_NAMED("Terrain.Streaming");
+
+    // Use main camera as a point of interest if game doesn't provide any (eg. players locations on a server)
+    Array<Vector3> cameraPoints;
+    if (StreamingPoints.IsEmpty())
+    {
+        if (const Camera* camera = Camera::GetMainCamera())
+            cameraPoints.Add(camera->GetPosition());
+    }
+    const Array<Vector3>& points = StreamingPoints.HasItems() ? StreamingPoints : cameraPoints;
+    for (Terrain* terrain : StreamingTerrains)
+        terrain->UpdateCollisionStreaming(points);
+}
+
 void TerrainManagerService::BeforeExit()
 {
+    StreamingTerrains.Clear();
+    StreamingPoints.Resize(0);
+
     // Cleanup data
     for (auto i = Lookup.Begin(); i.IsNotEnd(); ++i)
     {
@@ -3,8 +3,11 @@
 #pragma once
 
 #include "Engine/Core/Types/BaseTypes.h"
+#include "Engine/Core/Math/Vector3.h"
+#include "Engine/Core/Collections/Array.h"
 
 struct DrawCall;
+class Terrain;
 class GPUBuffer;
 class MaterialBase;
 
@@ -29,4 +32,22 @@ class TerrainManager
     /// <param name="lodIndex">The chunk LOD.</param>
     /// <returns>True if failed to get it, otherwise false.</returns>
     static bool GetChunkGeometry(DrawCall& drawCall, int32 chunkSize, int32 lodIndex);
+
+    /// <summary>
+    /// Sets the world-space points of interest used for terrain collision streaming. If empty, the main camera position is used.
+    /// </summary>
+    /// <param name="points">The streaming points locations.</param>
+    static void SetStreamingPoints(const Array<Vector3>& points);
+
+    /// <summary>
+    /// Registers the terrain for the data streaming updates (during play).
+    /// </summary>
+    /// <param name="terrain">The terrain.</param>
+    static void AddTerrain(Terrain* terrain);
+
+    /// <summary>
+    /// Unregisters the terrain from the data streaming updates.
+    /// </summary>
+    /// <param name="terrain">The terrain.</param>
+    static void RemoveTerrain(Terrain* terrain);
 };
@@ -14,6 +14,8 @@
 #include "Engine/Level/Level.h"
 #include "Engine/Graphics/Async/GPUTask.h"
 #include "Engine/Threading/Threading.h"
+#include "Engine/Threading/Task.h"
+#include "Engine/Threading/JobSystem.h"
 #if TERRAIN_EDITING
 #include "Engine/Core/Math/Packed.h"
 #include "Engine/Graphics/PixelFormatExtensions.h"
@@ -83,10 +85,12 @@ void TerrainPatch::Init(Terrain* terrain, int16 x, int16 z)
         Splatmap[i] = nullptr;
     }
     _heightfield = nullptr;
+    _heightfieldId = Guid::Empty;
 #if TERRAIN_UPDATING
     _cachedHeightMap.Resize(0);
     _cachedHolesMask.Resize(0);
     _wasHeightModified = false;
+    _hasChunkHeightRanges = false;
     for (int32 i = 0; i < TERRAIN_MAX_SPLATMAPS_COUNT; i++)
     {
         _cachedSplatMap[i].Resize(0);
@@ -104,6 +108,7 @@ void TerrainPatch::Init(Terrain* terrain, int16 x, int16 z)
 
 TerrainPatch::~TerrainPatch()
 {
+    CancelCollisionStreaming();
 #if TERRAIN_UPDATING
     SAFE_DELETE(_dataHeightmap);
     for (int32 i = 0; i < TERRAIN_MAX_SPLATMAPS_COUNT; i++)
@@ -246,16 +251,68 @@ FORCE_INLINE bool ReadIsHole(const Color32& raw)
     return (raw.B + raw.A) >= (int32)(1.9f * MAX_uint8);
 }
 
-void CalculateHeightmapRange(Terrain* terrain, TerrainDataUpdateInfo& info, const float* heightmap, float chunkOffsets[Terrain::ChunksCount], float chunkHeights[Terrain::ChunksCount])
+// Minimal amount of heightmap samples to process by a single job when splitting terrain data updating work
+#define TERRAIN_UPDATE_JOB_SAMPLES (128 * 128)
+
+// Runs the job for each chunk that overlaps the modified heightmap area (chunks are processed in parallel if more than one is affected)
+void ForEachModifiedChunk(const TerrainDataUpdateInfo& info, const Int2& modifiedOffset, const Int2& modifiedSize, const Function<void(int32)>& job)
+{
+    const Int2 modifiedEnd = modifiedOffset + modifiedSize;
+    int32 chunks[Terrain::ChunksCount];
+    int32 chunksCount = 0;
+    for (int32 chunkIndex = 0; chunkIndex < Terrain::ChunksCount; chunkIndex++)
+    {
+        const int32 chunkHeightmapX = (chunkIndex % Terrain::ChunksCountEdge) * info.ChunkSize;
+        const int32 chunkHeightmapZ = (chunkIndex / Terrain::ChunksCountEdge) * info.ChunkSize;
+        if (chunkHeightmapX < modifiedEnd.X && chunkHeightmapX + info.VertexCountEdge > modifiedOffset.X &&
+            chunkHeightmapZ < modifiedEnd.Y && chunkHeightmapZ + info.VertexCountEdge > modifiedOffset.Y)
+            chunks[chunksCount++] = chunkIndex;
+    }
+    if (chunksCount == 1)
+    {
+        job(chunks[0]);
+    }
+    else if (chunksCount != 0)
+    {
+        const Function<void(int32)> chunkJob = [&](int32 i)
+        {
+            job(chunks[i]);
+        };
+        JobSystem::Execute(chunkJob, chunksCount);
+    }
+}
+
+// Runs the job for the rows range split into batches (batches are processed in parallel if area is large enough)
+void ForEachRowsBatch(int32 rowsStart, int32 rowsEnd, int32 rowLength, const Function<void(int32, int32)>& job)
+{
+    const int32 rowsCount = rowsEnd - rowsStart;
+    if (rowsCount <= 0)
+        return;
+    const int32 batchRows = Math::Max(TERRAIN_UPDATE_JOB_SAMPLES / Math::Max(rowLength, 1), 1);
+    const int32 batchesCount = Math::DivideAndRoundUp(rowsCount, batchRows);
+    if (batchesCount == 1)
+    {
+        job(rowsStart, rowsEnd);
+    }
+    else
+    {
+        const Function<void(int32)> batchJob = [&](int32 i)
+        {
+            const int32 batchStart = rowsStart + i * batchRows;
+            job(batchStart, Math::Min(batchStart + batchRows, rowsEnd));
+        };
+        JobSystem::Execute(batchJob, batchesCount);
+    }
+}
+
+void CalculateHeightmapRange(Terrain* terrain, TerrainDataUpdateInfo& info, const float* heightmap, Float2 chunkRanges[Terrain::ChunksCount], const Int2& modifiedOffset, const Int2& modifiedSize, float chunkOffsets[Terrain::ChunksCount], float chunkHeights[Terrain::ChunksCount])
 {
     PROFILE_CPU_NAMED("Terrain.CalculateRange");
 
     // Note: terrain heightmap doesn't store raw height values but normalized into per-patch dimensions (height = normHeight * chunkPatch + patchOffset)
 
-    float minPatchHeight = MAX_float;
-    float maxPatchHeight = MIN_float;
-
-    for (int32 chunkIndex = 0; chunkIndex < Terrain::ChunksCount; chunkIndex++)
+    // Update min/max heights of the chunks that overlap the modified area (other chunks use ranges from the previous update)
+    ForEachModifiedChunk(info, modifiedOffset, modifiedSize, [&](int32 chunkIndex)
     {
         const int32 chunkX = (chunkIndex % Terrain::ChunksCountEdge) * info.ChunkSize;
         const int32 chunkZ = (chunkIndex / Terrain::ChunksCountEdge) * info.ChunkSize;
@@ -276,6 +333,17 @@ void CalculateHeightmapRange(Terrain* terrain, TerrainDataUpdateInfo& info, cons
             }
         }
 
+        chunkRanges[chunkIndex] = Float2(minHeight, maxHeight);
+    });
+
+    float minPatchHeight = MAX_float;
+    float maxPatchHeight = MIN_float;
+
+    for (int32 chunkIndex = 0; chunkIndex < Terrain::ChunksCount; chunkIndex++)
+    {
+        const float minHeight = chunkRanges[chunkIndex].X;
+        const float maxHeight = chunkRanges[chunkIndex].Y;
+
         chunkOffsets[chunkIndex] = minHeight;
         chunkHeights[chunkIndex] = Math::Max(maxHeight - minHeight, 1.0f);
 
@@ -292,16 +360,21 @@ void CalculateHeightmapRange(Terrain* terrain, TerrainDataUpdateInfo& info, cons
     info.PatchHeight = Math::Max(maxPatchHeight - minPatchHeight, 1.0f);
 }
 
+void CalculateHeightmapRange(Terrain* terrain, TerrainDataUpdateInfo& info, const float* heightmap, float chunkOffsets[Terrain::ChunksCount], float chunkHeights[Terrain::ChunksCount])
+{
+    Float2 chunkRanges[Terrain::ChunksCount];
+    CalculateHeightmapRange(terrain, info, heightmap, chunkRanges, Int2::Zero, Int2(info.HeightmapSize), chunkOffsets, chunkHeights);
+}
+
 void UpdateHeightMap(const TerrainDataUpdateInfo& info, const float* heightmap, const Int2& modifiedOffset, const Int2& modifiedSize, const byte* data)
 {
     PROFILE_CPU_NAMED("Terrain.UpdateHeightMap");
 
-    // TODO: use offset and size to improve performance of the data updating
-
     const auto heightmapPtr = heightmap;
     const auto ptr = (Color32*)data;
+    const Int2 modifiedEnd = modifiedOffset + modifiedSize;
 
-    for (int32 chunkIndex = 0; chunkIndex < Terrain::ChunksCount; chunkIndex++)
+    ForEachModifiedChunk(info, modifiedOffset, modifiedSize, [&](int32 chunkIndex)
     {
         const int32 chunkX = (chunkIndex % Terrain::ChunksCountEdge);
         const int32 chunkZ = (chunkIndex / Terrain::ChunksCountEdge);
@@ -312,12 +385,18 @@ void UpdateHeightMap(const TerrainDataUpdateInfo& info, const float* heightmap,
         const int32 chunkHeightmapX = chunkX * info.ChunkSize;
         const int32 chunkHeightmapZ = chunkZ * info.ChunkSize;
 
-        for (int32 z = 0; z < info.VertexCountEdge; z++)
+        // Clip chunk vertices to the modified area
+        const int32 startX = Math::Max(modifiedOffset.X - chunkHeightmapX, 0);
+        const int32 startZ = Math::Max(modifiedOffset.Y - chunkHeightmapZ, 0);
+        const int32 endX = Math::Min(modifiedEnd.X - chunkHeightmapX, info.VertexCountEdge);
+        const int32 endZ = Math::Min(modifiedEnd.Y - chunkHeightmapZ, info.VertexCountEdge);
+
+        for (int32 z = startZ; z < endZ; z++)
         {
             const int32 tz = (chunkTextureZ + z) * info.TextureSize;
             const int32 sz = (chunkHeightmapZ + z) * info.HeightmapSize;
 
-            for (int32 x = 0; x < info.VertexCountEdge; x++)
+            for (int32 x = startX; x < endX; x++)
             {
                 const int32 tx = chunkTextureX + x;
                 const int32 sx = chunkHeightmapX + x;
@@ -327,7 +406,7 @@ void UpdateHeightMap(const TerrainDataUpdateInfo& info, const float* heightmap,
                 WriteHeight(info, ptr[textureIndex], heightmapPtr[heightmapIndex]);
             }
         }
-    }
+    });
 }
 
 void UpdateHeightMap(const TerrainDataUpdateInfo& info, const float* heightmap, const byte* data)
@@ -386,86 +465,121 @@ void UpdateNormalsAndHoles(const TerrainDataUpdateInfo& info, const float* heigh
     const Int2 normalsStart = Int2::Max(Int2::Zero, modifiedOffset - 1);
     const Int2 normalsEnd = Int2::Min(info.HeightmapSize, modifiedEnd + 1);
     const Int2 normalsSize = normalsEnd - normalsStart;
+    const Int2 quadsSize = normalsSize - 1;
 
-    // Prepare memory
+    // Prepare memory (per-quad normals, accumulated per-vertex normals and smoothed per-vertex normals)
     const int32 normalsLength = normalsSize.X * normalsSize.Y;
-    GET_TERRAIN_SCRATCH_BUFFER(normalsPerVertex, normalsLength, Float3);
-
-    // Clear normals (for accumulation pass)
-    Platform::MemoryClear(normalsPerVertex, normalsLength * sizeof(Float3));
+    const int32 quadsLength = quadsSize.X * quadsSize.Y;
+    GET_TERRAIN_SCRATCH_BUFFER(normalsPerQuad, quadsLength * 2 + normalsLength * 2, Float3);
+    Float3* normalsPerVertex = normalsPerQuad + quadsLength * 2;
+    Float3* normalsSmooth = normalsPerVertex + normalsLength;
 
-    // Calculate per-quad normals and apply them to nearby vertices
-    for (int32 z = normalsStart.Y; z < normalsEnd.Y - 1; z++)
+    // Calculate per-quad normals (two triangles per quad)
+    ForEachRowsBatch(0, quadsSize.Y, quadsSize.X, [&](int32 rowsStart, int32 rowsEnd)
     {
-        for (int32 x = normalsStart.X; x < normalsEnd.X - 1; x++)
+        for (int32 z = rowsStart; z < rowsEnd; z++)
         {
-            // Get four vertices from the quad
+            for (int32 x = 0; x < quadsSize.X; x++)
+            {
+                // Get four vertices from the quad
 #define GET_VERTEX(a, b) \
-	int32 i##a##b = (z + (b) - normalsStart.Y) * normalsSize.X + (x + (a) - normalsStart.X); \
-	int32 h##a##b = (z + (b)) * info.HeightmapSize + (x + (a)); \
-	Float3 v##a##b; v##a##b.X = (x + (a)) * TERRAIN_UNITS_PER_VERTEX; \
+	int32 h##a##b = (normalsStart.Y + z + (b)) * info.HeightmapSize + (normalsStart.X + x + (a)); \
+	Float3 v##a##b; v##a##b.X = (normalsStart.X + x + (a)) * TERRAIN_UNITS_PER_VERTEX; \
 	v##a##b.Y = heightmap[h##a##b]; \
-	v##a##b.Z = (z + (b)) * TERRAIN_UNITS_PER_VERTEX
-            GET_VERTEX(0, 0);
-            GET_VERTEX(1, 0);
-            GET_VERTEX(0, 1);
-            GET_VERTEX(1, 1);
+	v##a##b.Z = (normalsStart.Y + z + (b)) * TERRAIN_UNITS_PER_VERTEX
+                GET_VERTEX(0, 0);
+                GET_VERTEX(1, 0);
+                GET_VERTEX(0, 1);
+                GET_VERTEX(1, 1);
 #undef GET_VERTEX
 
-            // TODO: use SIMD for those calculations
+                // TODO: use SIMD for those calculations
 
-            // Calculate normals for quad two vertices
-            Float3 n0 = Float3::Normalize((v00 - v01) ^ (v01 - v10));
-            Float3 n1 = Float3::Normalize((v11 - v10) ^ (v10 - v01));
-            Float3 n2 = n0 + n1;
+                // Calculate normals for quad two vertices
+                Float3* quad = normalsPerQuad + (z * quadsSize.X + x) * 2;
+                quad[0] = Float3::Normalize((v00 - v01) ^ (v01 - v10));
+                quad[1] = Float3::Normalize((v11 - v10) ^ (v10 - v01));
+            }
+        }
+    });
 
-            // Apply normal to each vertex using it
-            normalsPerVertex[i00] += n1;
-            normalsPerVertex[i01] += n2;
-            normalsPerVertex[i10] += n2;
-            normalsPerVertex[i11] += n0;
+    // Gather normals of the quads around each vertex
+    ForEachRowsBatch(0, normalsSize.Y, normalsSize.X, [&](int32 rowsStart, int32 rowsEnd)
+    {
+        for (int32 z = rowsStart; z < rowsEnd; z++)
+        {
+            for (int32 x = 0; x < normalsSize.X; x++)
+            {
+                /*
+                 * Vertex is a corner of up to four quads, each quad contributes with its triangle normals:
+                 * top-left vertex of the quad: n1, top-right and bottom-left vertices: n0 + n1, bottom-right vertex: n0
+                 */
+                Float3 normal = Float3::Zero;
+#define GET_QUAD(a, b) (normalsPerQuad + ((z + (b)) * quadsSize.X + (x + (a))) * 2)
+                if (x < quadsSize.X && z < quadsSize.Y)
+                    normal += GET_QUAD(0, 0)[1];
+                if (x < quadsSize.X && z > 0)
+                    normal += GET_QUAD(0, -1)[0] + GET_QUAD(0, -1)[1];
+                if (x > 0 && z < quadsSize.Y)
+                    normal += GET_QUAD(-1, 0)[0] + GET_QUAD(-1, 0)[1];
+                if (x > 0 && z > 0)
+                    normal += GET_QUAD(-1, -1)[0];
+#undef GET_QUAD
+                normalsPerVertex[z * normalsSize.X + x] = normal;
+            }
         }
-    }
+    });
 
     // Smooth normals
-    for (int32 z = 1; z < normalsSize.Y - 1; z++)
+    ForEachRowsBatch(0, normalsSize.Y, normalsSize.X, [&](int32 rowsStart, int32 rowsEnd)
     {
-        for (int32 x = 1; x < normalsSize.X - 1; x++)
+        for (int32 z = rowsStart; z < rowsEnd; z++)
         {
-            // Get four normals for the nearby quads
+            for (int32 x = 0; x < normalsSize.X; x++)
+            {
+                const int32 i = z * normalsSize.X + x;
+                if (x == 0 || z == 0 || x == normalsSize.X - 1 || z == normalsSize.Y - 1)
+                {
+                    // Keep edge normals unchanged
+                    normalsSmooth[i] = normalsPerVertex[i];
+                    continue;
+                }
+
+                // Get four normals for the nearby quads
 #define GET_NORMAL(a, b) \
 	int32 i##a##b = (z + (b - 1)) * normalsSize.X + (x + (a - 1)); \
 	Float3 n##a##b = Float3::NormalizeFast(normalsPerVertex[i##a##b])
-            GET_NORMAL(0, 0);
-            GET_NORMAL(1, 0);
-            GET_NORMAL(0, 1);
-            GET_NORMAL(1, 1);
-            GET_NORMAL(2, 0);
-            GET_NORMAL(2, 1);
-            GET_NORMAL(0, 2);
-            GET_NORMAL(1, 2);
-            GET_NORMAL(2, 2);
-#undef GET_VERTEX
-
-            // TODO: use SIMD for those calculations
-
-            /*
-             * The current vertex is (11). Calculate average for the nearby vertices.
-             * 00   01   02
-             * 10  (11)  12
-             * 20   21   22
-             */
-
-            const Float3 avg = (n00 + n01 + n02 + n10 + n11 + n12 + n20 + n21 + n22) * (1.0f / 9.0f);
-
-            // Smooth normals by performing interpolation to average for nearby quads
-            normalsPerVertex[i11] = Float3::Lerp(n11, avg, 0.6f);
+                GET_NORMAL(0, 0);
+                GET_NORMAL(1, 0);
+                GET_NORMAL(0, 1);
+                GET_NORMAL(1, 1);
+                GET_NORMAL(2, 0);
+                GET_NORMAL(2, 1);
+                GET_NORMAL(0, 2);
+                GET_NORMAL(1, 2);
+                GET_NORMAL(2, 2);
+#undef GET_NORMAL
+
+                // TODO: use SIMD for those calculations
+
+                /*
+                 * The current vertex is (11). Calculate average for the nearby vertices.
+                 * 00   01   02
+                 * 10  (11)  12
+                 * 20   21   22
+                 */
+
+                const Float3 avg = (n00 + n01 + n02 + n10 + n11 + n12 + n20 + n21 + n22) * (1.0f / 9.0f);
+
+                // Smooth normals by performing interpolation to average for nearby quads (reads unsmoothed neighbors so rows can be processed in parallel)
+                normalsSmooth[i11] = Float3::Lerp(n11, avg, 0.6f);
+            }
         }
-    }
+    });
 
     // Write back to the data container
     const auto ptr = (Color32*)data;
-    for (int32 chunkIndex = 0; chunkIndex < Terrain::ChunksCount; chunkIndex++)
+    ForEachModifiedChunk(info, modifiedOffset, modifiedSize, [&](int32 chunkIndex)
     {
         const int32 chunkX = (chunkIndex % Terrain::ChunksCountEdge);
         const int32 chunkZ = (chunkIndex / Terrain::ChunksCountEdge);
@@ -476,29 +590,20 @@ void UpdateNormalsAndHoles(const TerrainDataUpdateInfo& info, const float* heigh
         const int32 chunkHeightmapX = chunkX * info.ChunkSize;
         const int32 chunkHeightmapZ = chunkZ * info.ChunkSize;
 
-        // Skip unmodified chunks
-        if (chunkHeightmapX >= modifiedEnd.X || chunkHeightmapX + info.ChunkSize < modifiedOffset.X ||
-            chunkHeightmapZ >= modifiedEnd.Y || chunkHeightmapZ + info.ChunkSize < modifiedOffset.Y)
-            continue;
+        // Clip chunk vertices to the modified area
+        const int32 startX = Math::Max(modifiedOffset.X - chunkHeightmapX, 0);
+        const int32 startZ = Math::Max(modifiedOffset.Y - chunkHeightmapZ, 0);
+        const int32 endX = Math::Min(modifiedEnd.X - chunkHeightmapX, info.VertexCountEdge);
+        const int32 endZ = Math::Min(modifiedEnd.Y - chunkHeightmapZ, info.VertexCountEdge);
 
-        // TODO: adjust loop range to reduce iterations count for edge cases (skip checking unmodified samples)
-        for (int32 z = 0; z < info.VertexCountEdge; z++)
+        for (int32 z = startZ; z < endZ; z++)
         {
-            // Skip unmodified columns
-            const int32 dz = chunkHeightmapZ + z - modifiedOffset.Y;
-            if (dz < 0 || dz >= modifiedSize.Y)
-                continue;
             const int32 hz = (chunkHeightmapZ + z) * info.HeightmapSize;
             const int32 sz = (chunkHeightmapZ + z - normalsStart.Y) * normalsSize.X;
             const int32 tz = (chunkTextureZ + z) * info.TextureSize;
 
-            // TODO: adjust loop range to reduce iterations count for edge cases (skip checking unmodified samples)
-            for (int32 x = 0; x < info.VertexCountEdge; x++)
+            for (int32 x = startX; x < endX; x++)
             {
-                // Skip unmodified rows
-                const int32 dx = chunkHeightmapX + x - modifiedOffset.X;
-                if (dx < 0 || dx >= modifiedSize.X)
-                    continue;
                 const int32 hx = chunkHeightmapX + x;
                 const int32 sx = chunkHeightmapX + x - normalsStart.X;
                 const int32 tx = chunkTextureX + x;
@@ -509,7 +614,7 @@ void UpdateNormalsAndHoles(const TerrainDataUpdateInfo& info, const float* heigh
 #if BUILD_DEBUG
                 ASSERT(normalIndex >= 0 && normalIndex < normalsLength);
 #endif
-                Float3 normal = Float3::NormalizeFast(normalsPerVertex[normalIndex]) * 0.5f + 0.5f;
+                Float3 normal = Float3::NormalizeFast(normalsSmooth[normalIndex]) * 0.5f + 0.5f;
 
                 if (holesMask && !holesMask[heightmapIndex])
                     normal = Float3::One;
@@ -518,7 +623,7 @@ void UpdateNormalsAndHoles(const TerrainDataUpdateInfo& info, const float* heigh
                 ptr[textureIndex].A = (uint8)(normal.Z * MAX_uint8);
             }
         }
-    }
+    });
 }
 
 void UpdateNormalsAndHoles(const TerrainDataUpdateInfo& info, const float* heightmap, const byte* holesMask, const byte* data)
@@ -1007,6 +1112,7 @@ bool TerrainPatch::SetupHeightMap(int32 heightMapLength, const float* heightMap,
     _cachedHeightMap.Resize(0);
     _cachedHolesMask.Resize(0);
     _wasHeightModified = false;
+    _hasChunkHeightRanges = false;
 #endif
 
     return false;
@@ -1252,6 +1358,7 @@ void TerrainPatch::CacheHeightData()
     _cachedHeightMap.Resize(info.HeightmapLength);
     _cachedHolesMask.Resize(info.HeightmapLength);
     _wasHeightModified = false;
+    _hasChunkHeightRanges = false;
 
     // Extract heightmap data and denormalize it to get the pure height field
     const float patchOffset = _yOffset;
@@ -1396,24 +1503,27 @@ bool TerrainPatch::ModifyHeightMap(const float* samples, const Int2& modifiedOff
     }
 
     // Modify heightmap data
+    if (samples != heightMap)
     {
         PROFILE_CPU_NAMED("Terrain.WrtieCache");
         for (int32 z = 0; z < modifiedSize.Y; z++)
         {
-            // TODO: use batches row mem copy
-
-            for (int32 x = 0; x < modifiedSize.X; x++)
-            {
-                heightMap[(z + modifiedOffset.Y) * info.HeightmapSize + (x + modifiedOffset.X)] = samples[z * modifiedSize.X + x];
-            }
+            Platform::MemoryCopy(heightMap + (z + modifiedOffset.Y) * info.HeightmapSize + modifiedOffset.X, samples + z * modifiedSize.X, modifiedSize.X * sizeof(float));
         }
     }
 
-    // Process heightmap to get per-patch height normalization values
+    // Process heightmap to get per-patch height normalization values (only chunks overlapping the modified area are recalculated)
     float chunkOffsets[Terrain::ChunksCount];
     float chunkHeights[Terrain::ChunksCount];
-    CalculateHeightmapRange(_terrain, info, heightMap, chunkOffsets, chunkHeights);
-    // TODO: maybe calculate chunk ranges for only modified chunks
+    if (_hasChunkHeightRanges)
+    {
+        CalculateHeightmapRange(_terrain, info, heightMap, _chunkHeightRanges, modifiedOffset, modifiedSize, chunkOffsets, chunkHeights);
+    }
+    else
+    {
+        CalculateHeightmapRange(_terrain, info, heightMap, _chunkHeightRanges, Int2::Zero, Int2(info.HeightmapSize), chunkOffsets, chunkHeights);
+        _hasChunkHeightRanges = true;
+    }
     const bool wasHeightRangeChanged = Math::NotNearEqual(_yOffset, info.PatchOffset) || Math::NotNearEqual(_yHeight, info.PatchHeight);
 
     // Check if has allocated texture
@@ -1438,12 +1548,15 @@ bool TerrainPatch::ModifyHeightMap(const float* samples, const Int2& modifiedOff
         UpdateNormalsAndHoles(info, heightMap, holesMask, modifiedOffset, modifiedSize, data);
     }
 
-    // Update all the stuff
+    // Update all the stuff (chunk transform depends on the patch height range so skip chunks only if both ranges are unchanged)
+    const bool wasPatchRangeChanged = _yOffset != info.PatchOffset || _yHeight != info.PatchHeight;
     _yOffset = info.PatchOffset;
     _yHeight = info.PatchHeight;
     for (int32 chunkIndex = 0; chunkIndex < Terrain::ChunksCount; chunkIndex++)
     {
         auto& chunk = Chunks[chunkIndex];
+        if (!wasPatchRangeChanged && chunk._yOffset == chunkOffsets[chunkIndex] && chunk._yHeight == chunkHeights[chunkIndex])
+            continue;
         chunk._yOffset = chunkOffsets[chunkIndex];
         chunk._yHeight = chunkHeights[chunkIndex];
         chunk.UpdateTransform();
@@ -1767,10 +1880,14 @@ bool TerrainPatch::UpdateHeightData(TerrainDataUpdateInfo& info, const Int2& mod
     }
 
 #if 1
-    if (wasHeightRangeChanged)
+    // Drop pending async height field creation (it reads the collision data that is modified below)
+    CancelCollisionStreaming();
+    if (wasHeightRangeChanged || !HasCollision())
     {
         // When min-max height range has been changed for the patch let's update it all, it's faster to cook collision and rebuild shape rather than modify all the samples
-        if (_heightfield->WaitForLoaded())
+        // Patches without collision (eg. streamed out) get only the collision data updated so it's valid once streamed in
+        RestoreHeightfield();
+        if (_heightfield == nullptr || _heightfield->WaitForLoaded())
         {
             LOG(Error, "Failed to load patch heightfield data.");
             return true;
@@ -1778,7 +1895,8 @@ bool TerrainPatch::UpdateHeightData(TerrainDataUpdateInfo& info, const Int2& mod
         const auto collisionData = &_heightfield->Data;
         if (CookCollision(info, _dataHeightmap, _terrain->_collisionLod, collisionData))
             return true;
-        UpdateCollision();
+        if (HasCollision())
+            UpdateCollision();
     }
     else
     {
@@ -1834,6 +1952,8 @@ void TerrainPatch::SaveHeightData()
 {
 #if USE_EDITOR
     // Skip if was not modified or cannot be saved
+    if (_wasHeightModified)
+        RestoreHeightfield();
     if (!_wasHeightModified ||
         Heightmap == nullptr ||
         _heightfield == nullptr ||
@@ -2106,7 +2226,11 @@ void TerrainPatch::CreateCollision()
     if (CreateHeightField())
         return;
     ASSERT(_physicsHeightField);
+    CreateCollisionActor();
+}
 
+void TerrainPatch::CreateCollisionActor()
+{
     // Create geometry
     const Transform terrainTransform = _terrain->_transform;
     CollisionShape shape;
@@ -2136,6 +2260,7 @@ bool TerrainPatch::CreateHeightField()
     ASSERT(_physicsHeightField == nullptr);
 
     // Skip if height field data is missing but warn on loading failed
+    RestoreHeightfield();
     if (_heightfield == nullptr)
         return true;
     if (_heightfield->WaitForLoaded() || _heightfield->Data.IsEmpty())
@@ -2166,6 +2291,117 @@ bool TerrainPatch::CreateHeightField()
     return false;
 }
 
+void TerrainPatch::UpdateCollisionStreaming(bool resident)
+{
+    const int64 state = Platform::AtomicRead(&_collisionStreamingState);
+    if (state == 1)
+        return; // Height field is being created
+    if (resident)
+    {
+        if (HasCollision())
+            return;
+        if (state == 2)
+        {
+            // Finalize collision created asynchronously (fallback to the sync path to handle outdated or invalid data)
+            Platform::AtomicStore(&_collisionStreamingState, 0);
+            _collisionStreamingTask = nullptr;
+            if (_streamedHeightField)
+            {
+                PROFILE_CPU_NAMED("Terrain.StreamCollision");
+                _physicsHeightField = _streamedHeightField;
+                _collisionScaleXZ = _streamedCollisionScaleXZ;
+                _streamedHeightField = nullptr;
+                CreateCollisionActor();
+            }
+            else
+            {
+                CreateCollision();
+            }
+            return;
+        }
+
+        // Start async height field creation once the collision data is loaded
+        RestoreHeightfield();
+        RawDataAsset* heightfield = _heightfield.Get();
+        if (!heightfield || !heightfield->IsLoaded())
+            return;
+        Platform::AtomicStore(&_collisionStreamingState, 1);
+        Function<void()> action;
+        action.Bind<TerrainPatch, &TerrainPatch::CreateHeightFieldAsync>(this);
+        _collisionStreamingTask = Task::StartNew(action);
+        if (_collisionStreamingTask == nullptr)
+            Platform::AtomicStore(&_collisionStreamingState, 0);
+    }
+    else
+    {
+        if (state == 2)
+            CancelCollisionStreaming();
+        if (HasCollision())
+            DestroyCollision();
+        bool canRelease = true;
+#if TERRAIN_UPDATING
+        // Release CPU data cache (unless it holds not yet saved modifications)
+        canRelease = !_wasHeightModified;
+        if (canRelease)
+        {
+            _cachedHeightMap.Resize(0);
+            _cachedHolesMask.Resize(0);
+        }
+#endif
+
+        // Release reference to the collision data so it can be unloaded (virtual assets would be lost)
+        RawDataAsset* heightfield = _heightfield.Get();
+        if (canRelease && heightfield && !heightfield->IsVirtual())
+        {
+            _heightfieldId = heightfield->GetID();
+            _heightfield = nullptr;
+        }
+    }
+}
+
+void TerrainPatch::RestoreHeightfield()
+{
+    if (_heightfield == nullptr && _heightfieldId.IsValid())
+        _heightfield = Content::LoadAsync<RawDataAsset>(_heightfieldId);
+    _heightfieldId = Guid::Empty;
+}
+
+void TerrainPatch::CancelCollisionStreaming()
+{
+    if (_collisionStreamingTask)
+    {
+        // Wait for the async height field creation to end (task object is alive until it ends)
+        if (Platform::AtomicRead(&_collisionStreamingState) == 1)
+            _collisionStreamingTask->Wait();
+        _collisionStreamingTask = nullptr;
+    }
+    Platform::AtomicStore(&_collisionStreamingState, 0);
+    if (_streamedHeightField)
+    {
+        PhysicsBackend::DestroyObject(_streamedHeightField);
+        _streamedHeightField = nullptr;
+    }
+}
+
+void TerrainPatch::CreateHeightFieldAsync()
+{
+    PROFILE_CPU();
+    void* heightField = nullptr;
+    RawDataAsset* heightfield = _heightfield.Get();
+    if (heightfield && heightfield->IsLoaded() && heightfield->Data.Count() > (int32)sizeof(TerrainCollisionDataHeader))
+    {
+        // Skip outdated data (main thread will reset it)
+        auto collisionHeader = (TerrainCollisionDataHeader*)heightfield->Data.Get();
+        if (collisionHeader->CheckOldMagicNumber == MAX_int32 && collisionHeader->Version == TerrainCollisionDataHeader::CurrentVersion)
+        {
+            _streamedCollisionScaleXZ = collisionHeader->ScaleXZ * TERRAIN_UNITS_PER_VERTEX;
+            heightField = PhysicsBackend::CreateHeightField(heightfield->Data.Get() + sizeof(TerrainCollisionDataHeader), heightfield->Data.Count() - sizeof(TerrainCollisionDataHeader));
+        }
+    }
+    _streamedHeightField = heightField;
+    Platform::AtomicStore(&_collisionStreamingState, 2);
+}
+
 void TerrainPatch::UpdateCollisionScale() const
 {
     PROFILE_CPU();
@@ -2535,7 +2771,12 @@ void TerrainPatch::Serialize(SerializeStream& stream, const void* otherObj)
     SERIALIZE_MEMBER(Splatmap0, Splatmap[0]);
     SERIALIZE_MEMBER(Splatmap1, Splatmap[1]);
     static_assert(ARRAY_COUNT(Splatmap) == 2, "Please update the code above to match the maximum terrain splatmaps amount.");
-    SERIALIZE_MEMBER(Heightfield, _heightfield);
+    const Guid heightfieldId = _heightfield ? _heightfield.GetID() : _heightfieldId;
+    if (!other || heightfieldId != (other->_heightfield ? other->_heightfield.GetID() : other->_heightfieldId))
+    {
+        stream.JKEY("Heightfield");
+        stream.Guid(heightfieldId);
+    }
 
     stream.JKEY("Chunks");
     stream.StartArray();
@@ -2564,6 +2805,7 @@ void TerrainPatch::Deserialize(DeserializeStream& stream, ISerializeModifier* mo
     DESERIALIZE_MEMBER(Splatmap1, Splatmap[1]);
     static_assert(ARRAY_COUNT(Splatmap) == 2, "Please update the code above to match the maximum terrain splatmaps amount.");
     DESERIALIZE_MEMBER(Heightfield, _heightfield);
+    _heightfieldId = Guid::Empty;
 
     // Update offset (x or/and z may be modified)
     const float size = _terrain->_chunkSize * TERRAIN_UNITS_PER_VERTEX * Terrain::ChunksCountEdge;
@@ -11,6 +11,7 @@
 
 struct RayCastHit;
 class TerrainMaterialShader;
+class Task;
 
 /// <summary>
 /// Represents single terrain patch made of 16 terrain chunks.
@@ -29,16 +30,23 @@ API_CLASS(Sealed, NoSpawn) class FLAXENGINE_API TerrainPatch : public ScriptingO
     BoundingBox _bounds;
     Float3 _offset;
     AssetReference<RawDataAsset> _heightfield;
+    Guid _heightfieldId; // Collision data asset released by the collision streaming
     void* _physicsShape;
     void* _physicsActor;
     void* _physicsHeightField;
     CriticalSection _collisionLocker;
     float _collisionScaleXZ;
+    volatile int64 _collisionStreamingState = 0;
+    void* _streamedHeightField = nullptr;
+    Task* _collisionStreamingTask = nullptr;
+    float _streamedCollisionScaleXZ;
 #if TERRAIN_UPDATING
     Array<float> _cachedHeightMap;
     Array<byte> _cachedHolesMask;
     Array<Color32> _cachedSplatMap[TERRAIN_MAX_SPLATMAPS_COUNT];
     bool _wasHeightModified;
+    bool _hasChunkHeightRanges;
+    Float2 _chunkHeightRanges[Terrain::ChunksCount]; // Min/max heights of the chunks in the cached heightmap (valid if _hasChunkHeightRanges is set)
     bool _wasSplatmapModified[TERRAIN_MAX_SPLATMAPS_COUNT];
     TextureBase::InitData* _dataHeightmap = nullptr;
     TextureBase::InitData* _dataSplatmap[TERRAIN_MAX_SPLATMAPS_COUNT] = {};
@@ -395,12 +403,36 @@ API_CLASS(Sealed, NoSpawn) class FLAXENGINE_API TerrainPatch : public ScriptingO
     /// </summary>
     void CreateCollision();
 
+    /// <summary>
+    /// Creates the collision shape and static actor for the patch using the already created height field.
+    /// </summary>
+    void CreateCollisionActor();
+
     /// <summary>
     /// Creates the height field from the collision data and caches height field XZ scale parameter.
     /// </summary>
     /// <returns>True if failed, otherwise false.</returns>
     bool CreateHeightField();
 
+    /// <summary>
+    /// Streams the patch collision in or out. Height field is created asynchronously and the collision actor is added on the next update.
+    /// </summary>
+    /// <param name="resident">True if patch should have collision, otherwise false.</param>
+    void UpdateCollisionStreaming(bool resident);
+
+    /// <summary>
+    /// Restores the collision data asset reference released by the collision streaming (asset is loaded asynchronously).
+    /// </summary>
+    void RestoreHeightfield();
+
+    /// <summary>
+    /// Waits for the pending async height field creation (if any) and releases the streamed data.
+    /// </summary>
+    void CancelCollisionStreaming();
+
+    // Async height field creation.
+    void CreateHeightFieldAsync();
+
     /// <summary>
     /// Updates the collision geometry scale for the patch. Called when terrain actor scale gets changed.
     /// </summary>
@@ -5,6 +5,7 @@
 #include "Engine/Core/Collections/BitArray.h"
 #include "Engine/Core/Collections/HashSet.h"
 #include "Engine/Core/Collections/Dictionary.h"
+#include "Engine/Core/Collections/Sorting.h"
 #include <ThirdParty/catch2/catch.hpp>
 
 TEST_CASE("Array")
@@ -291,3 +292,120 @@ TEST_CASE("Dictionary")
         CHECK(a1.Capacity() <= DICTIONARY_DEFAULT_CAPACITY);
     }
 }
+
+namespace
+{
+    struct SortingItem
+    {
+        uint32 Key;
+        int32 Index;
+
+        bool operator<(const SortingItem& other) const
+        {
+            return Key < other.Key;
+        }
+    };
+}
+
+TEST_CASE("Sorting")
+{
+    // Generate some random data for testing (big enough to use parallel sorting, with duplicated keys to verify stability)
+    const int32 count = Sorting::ParallelSortThreshold * 4 + 13;
+    RandomStream rand(101);
+    Array<uint32> keys32;
+    Array<uint64> keys64;
+    keys32.Resize(count);
+    keys64.Resize(count);
+    for (int32 i = 0; i < count; i++)
+    {
+        keys32[i] = rand.GetUnsignedInt() % 5000;
+        keys64[i] = ((uint64)rand.GetUnsignedInt() << 32) | keys32[i];
+    }
+
+    SECTION("Test Radix Sort")
+    {
+        Array<uint32> keys(keys32), tmpKeys;
+        Array<int32> values, tmpValues;
+        tmpKeys.Resize(count);
+        values.Resize(count);
+        tmpValues.Resize(count);
+        for (int32 i = 0; i < count; i++)
+            values[i] = i;
+        uint32* resultKeys = keys.Get();
+        int32* resultValues = values.Get();
+        Sorting::RadixSort(resultKeys, resultValues, tmpKeys.Get(), tmpValues.Get(), count);
+        for (int32 i = 1; i < count; i++)
+        {
+            CHECK(resultKeys[i - 1] <= resultKeys[i]);
+            if (resultKeys[i - 1] == resultKeys[i])
+                CHECK(resultValues[i - 1] < resultValues[i]);
+        }
+        for (int32 i = 0; i < count; i++)
+            CHECK(keys32[resultValues[i]] == resultKeys[i]);
+    }
+
+    SECTION("Test Radix Sort 64-bit")
+    {
+        Array<uint64> keys(keys64), tmpKeys;
+        Array<int32> values, tmpValues;
+        tmpKeys.Resize(count);
+        values.Resize(count);
+        tmpValues.Resize(count);
+        for (int32 i = 0; i < count; i++)
+            values[i] = i;
+        uint64* resultKeys = keys.Get();
+        int32* resultValues = values.Get();
+        Sorting::RadixSort(resultKeys, resultValues, tmpKeys.Get(), tmpValues.Get(), count);
+        for (int32 i = 1; i < count; i++)
+            CHECK(resultKeys[i - 1] <= resultKeys[i]);
+        for (int32 i = 0; i < count; i++)
+            CHECK(keys64[resultValues[i]] == resultKeys[i]);
+    }
+
+    SECTION("Test Parallel Radix Sort")
+    {
+        Array<uint64> keys1(keys64), keys2(keys64), tmpKeys1, tmpKeys2;
+        Array<int32> values1, values2, tmpValues1, tmpValues2;
+        tmpKeys1.Resize(count);
+        tmpKeys2.Resize(count);
+        values1.Resize(count);
+        values2.Resize(count);
+        tmpValues1.Resize(count);
+        tmpValues2.Resize(count);
+        for (int32 i = 0; i < count; i++)
+            values1[i] = values2[i] = i;
+        uint64* resultKeys1 = keys1.Get();
+        int32* resultValues1 = values1.Get();
+        Sorting::RadixSort(resultKeys1, resultValues1, tmpKeys1.Get(), tmpValues1.Get(), count);
+        uint64* resultKeys2 = keys2.Get();
+        int32* resultValues2 = values2.Get();
+        Sorting::ParallelRadixSort(resultKeys2, resultValues2, tmpKeys2.Get(), tmpValues2.Get(), count);
+        for (int32 i = 0; i < count; i++)
+        {
+            CHECK(resultKeys1[i] == resultKeys2[i]);
+            CHECK(resultValues1[i] == resultValues2[i]);
+        }
+    }
+
+    SECTION("Test Merge Sort")
+    {
+        Array<SortingItem> items1, items2;
+        items1.Resize(count);
+        for (int32 i = 0; i < count; i++)
+            items1[i] = { keys32[i], i };
+        items2 = items1;
+        Sorting::MergeSort(items1);
+        Sorting::ParallelMergeSort(items2);
+        for (int32 i = 1; i < count; i++)
+        {
+            CHECK(items1[i - 1].Key <= items1[i].Key);
+            if (items1[i - 1].Key == items1[i].Key)
+                CHECK(items1[i - 1].Index < items1[i].Index);
+        }
+        for (int32 i = 0; i < count; i++)
+        {
+            CHECK(items1[i].Key == items2[i].Key);
+            CHECK(items1[i].Index == items2[i].Index);
+        }
+    }
+}
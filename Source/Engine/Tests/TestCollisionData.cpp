@@ -0,0 +1,104 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#include "Engine/Physics/CollisionData.h"
+#include "Engine/Content/Content.h"
+#include "Engine/Content/AssetReference.h"
+#include "Engine/Core/Log.h"
+#include "Engine/Core/Math/Math.h"
+#include "Engine/Core/Collections/Array.h"
+#include "Engine/Platform/Platform.h"
+#include "Engine/Threading/Task.h"
+#include <ThirdParty/catch2/catch.hpp>
+
+#if COMPILE_WITH_PHYSICS_COOKING
+
+namespace
+{
+    void GetProceduralMesh(uint32 seed, int32 size, Array<Float3>& vertices, Array<uint32>& triangles)
+    {
+        // Bumpy grid, heights depend on the seed so every mesh is unique
+        vertices.Resize((size + 1) * (size + 1));
+        for (int32 z = 0; z <= size; z++)
+        {
+            for (int32 x = 0; x <= size; x++)
+            {
+                const uint32 hash = (seed * 73856093u) ^ ((uint32)x * 19349663u) ^ ((uint32)z * 83492791u);
+                vertices[z * (size + 1) + x] = Float3(x * 100.0f, (float)(hash % 1000) * 0.1f, z * 100.0f);
+            }
+        }
+        triangles.Resize(size * size * 6);
+        int32 index = 0;
+        for (int32 z = 0; z < size; z++)
+        {
+            for (int32 x = 0; x < size; x++)
+            {
+                const uint32 i0 = z * (size + 1) + x;
+                const uint32 i1 = i0 + size + 1;
+                triangles[index++] = i0;
+                triangles[index++] = i1;
+                triangles[index++] = i0 + 1;
+                triangles[index++] = i0 + 1;
+                triangles[index++] = i1;
+                triangles[index++] = i1 + 1;
+            }
+        }
+    }
+
+    double CookColliders(Array<AssetReference<CollisionData>>& assets, uint32 seed, int32 size, int32& failedCount)
+    {
+        Array<Float3> vertices;
+        Array<uint32> triangles;
+        Array<Task*> tasks;
+        tasks.Resize(assets.Count());
+        const double startTime = Platform::GetTimeSeconds();
+        for (int32 i = 0; i < assets.Count(); i++)
+        {
+            GetProceduralMesh(seed + i, size, vertices, triangles);
+            tasks[i] = assets[i]->CookCollisionAsync(CollisionDataType::TriangleMesh, ToSpan(vertices), ToSpan(triangles));
+            tasks[i]->Start();
+        }
+        Task::WaitAll(tasks);
+        const double time = Platform::GetTimeSeconds() - startTime;
+        failedCount = 0;
+        for (Task* task : tasks)
+            failedCount += task->IsFailed() ? 1 : 0;
+        return time;
+    }
+}
+
+TEST_CASE("CollisionData")
+{
+    SECTION("Benchmark Cooking Procedural Colliders")
+    {
+        const int32 collidersCount = 1000;
+        const int32 gridSize = 16;
+        Array<AssetReference<CollisionData>> assets;
+        assets.Resize(collidersCount);
+        for (auto& asset : assets)
+        {
+            asset = Content::CreateVirtualAsset<CollisionData>();
+            REQUIRE(asset);
+        }
+
+        // Cook unique geometry (seed changes every run so cache from the previous sessions is not used)
+        const uint32 seed = (uint32)Platform::GetTimeCycles();
+        int32 failedCount;
+        const double cookTime = CookColliders(assets, seed, gridSize, failedCount);
+        CHECK(failedCount == 0);
+        for (auto& asset : assets)
+        {
+            CHECK(asset->GetOptions().Type == CollisionDataType::TriangleMesh);
+            CHECK(asset->GetOptions().Box.GetSize().X > 0.0f);
+        }
+
+        // Cook the same geometry again (cooked data is loaded from the cache if enabled in Physics Settings)
+        const double cachedTime = CookColliders(assets, seed, gridSize, failedCount);
+        CHECK(failedCount == 0);
+
+        LOG(Info, "Cooking {0} procedural mesh colliders ({1} triangles each): {2} ms, cached: {3} ms", collidersCount, gridSize * gridSize * 2, (int32)(cookTime * 1000.0), (int32)(cachedTime * 1000.0));
+        for (auto& asset : assets)
+            Content::DeleteAsset(asset);
+    }
+}
+
+#endif
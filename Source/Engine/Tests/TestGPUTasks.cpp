@@ -0,0 +1,169 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#include "Engine/Graphics/Async/GPUTask.h"
+#include "Engine/Graphics/Async/GPUTasksManager.h"
+#include <ThirdParty/catch2/catch.hpp>
+
+class TestGPUTask : public GPUTask
+{
+private:
+    GPUTasksManager* _manager;
+
+public:
+    TestGPUTask(GPUTasksManager* manager, uint64 cost, Priority priority)
+        : GPUTask(Type::Custom)
+        , _manager(manager)
+    {
+        SetCost(cost);
+        SetPriority(priority);
+    }
+
+protected:
+    // [GPUTask]
+    Result run(GPUTasksContext* context) override
+    {
+        return Result::Ok;
+    }
+
+    void Enqueue() override
+    {
+        _manager->Enqueue(this);
+    }
+};
+
+TEST_CASE("GPUTasks")
+{
+    SECTION("Test Budget")
+    {
+        GPUTasksManager manager;
+        manager.FrameTasksLimit = 2;
+        manager.FrameBytesBudget = 100;
+        GPUTask* tasks[3] =
+        {
+            New<TestGPUTask>(&manager, 1000, GPUTask::Priority::Normal),
+            New<TestGPUTask>(&manager, 40, GPUTask::Priority::Normal),
+            New<TestGPUTask>(&manager, 40, GPUTask::Priority::Normal),
+        };
+        for (GPUTask* task : tasks)
+            task->Start();
+        GPUTask* buffer[8];
+
+        // Task that exceeds the budget is executed alone
+        CHECK(manager.RequestWork(buffer, 8) == 1);
+        CHECK(buffer[0] == tasks[0]);
+        CHECK(manager.RequestWork(buffer, 8) == 0);
+        manager.FrameEnd();
+        CHECK(manager.GetLastFrameStats().GetTasksCount() == 1);
+        CHECK(manager.GetLastFrameStats().Bytes == 1000);
+        CHECK(manager.GetLastFrameStats().DeferredCount == 2);
+
+        // Tasks limit
+        manager.FrameTasksLimit = 1;
+        CHECK(manager.RequestWork(buffer, 8) == 1);
+        CHECK(buffer[0] == tasks[1]);
+        manager.FrameEnd();
+        CHECK(manager.GetLastFrameStats().Bytes == 40);
+        CHECK(manager.GetLastFrameStats().DeferredCount == 1);
+        CHECK(manager.RequestWork(buffer, 8) == 1);
+        CHECK(buffer[0] == tasks[2]);
+        manager.FrameEnd();
+        CHECK(manager.GetLastFrameStats().DeferredCount == 0);
+        CHECK(manager.GetTaskCount() == 0);
+
+        for (GPUTask* task : tasks)
+            task->Cancel();
+    }
+
+    SECTION("Test Priority")
+    {
+        GPUTasksManager manager;
+        manager.FrameBytesBudget = 100;
+        GPUTask* tasks[4] =
+        {
+            New<TestGPUTask>(&manager, 10, GPUTask::Priority::Low),
+            New<TestGPUTask>(&manager, 50, GPUTask::Priority::Normal),
+            New<TestGPUTask>(&manager, 60, GPUTask::Priority::High),
+            New<TestGPUTask>(&manager, 30, GPUTask::Priority::Normal),
+        };
+        for (GPUTask* task : tasks)
+            task->Start();
+        GPUTask* buffer[8];
+
+        // High priority task goes first and the next one doesn't fit into the budget
+        CHECK(manager.RequestWork(buffer, 8) == 1);
+        CHECK(buffer[0] == tasks[2]);
+        manager.FrameEnd();
+        CHECK(manager.GetLastFrameStats().TasksCount[(int32)GPUTask::Priority::High] == 1);
+        CHECK(manager.GetLastFrameStats().Bytes == 60);
+        CHECK(manager.GetLastFrameStats().DeferredCount == 3);
+
+        // Normal priority tasks in order and then the low priority one
+        CHECK(manager.RequestWork(buffer, 8) == 3);
+        CHECK(buffer[0] == tasks[1]);
+        CHECK(buffer[1] == tasks[3]);
+        CHECK(buffer[2] == tasks[0]);
+        manager.FrameEnd();
+        CHECK(manager.GetLastFrameStats().TasksCount[(int32)GPUTask::Priority::Normal] == 2);
+        CHECK(manager.GetLastFrameStats().TasksCount[(int32)GPUTask::Priority::Low] == 1);
+        CHECK(manager.GetLastFrameStats().Bytes == 90);
+        CHECK(manager.GetLastFrameStats().DeferredCount == 0);
+
+        // Finished or canceled tasks are skipped
+        GPUTask* canceled = New<TestGPUTask>(&manager, 10, GPUTask::Priority::Normal);
+        canceled->Start();
+        canceled->Cancel();
+        CHECK(manager.RequestWork(buffer, 8) == 0);
+
+        for (GPUTask* task : tasks)
+            task->Cancel();
+    }
+
+    SECTION("Test Starvation")
+    {
+        GPUTasksManager manager;
+        manager.FrameTasksLimit = 1;
+        manager.MaxStarvedFrames = 2;
+        GPUTask* low = New<TestGPUTask>(&manager, 10, GPUTask::Priority::Low);
+        GPUTask* tasks[4] =
+        {
+            New<TestGPUTask>(&manager, 10, GPUTask::Priority::High),
+            New<TestGPUTask>(&manager, 10, GPUTask::Priority::High),
+            New<TestGPUTask>(&manager, 10, GPUTask::Priority::High),
+            New<TestGPUTask>(&manager, 10, GPUTask::Priority::High),
+        };
+        low->Start();
+        for (GPUTask* task : tasks)
+            task->Start();
+        GPUTask* buffer[8];
+
+        // High priority tasks use the whole budget
+        for (int32 frame = 0; frame < 2; frame++)
+        {
+            CHECK(manager.RequestWork(buffer, 8) == 1);
+            CHECK(buffer[0] == tasks[frame]);
+            manager.FrameEnd();
+        }
+
+        // Low priority task waited for too long so it goes first
+        CHECK(manager.RequestWork(buffer, 8) == 1);
+        CHECK(buffer[0] == low);
+        manager.FrameEnd();
+        CHECK(manager.GetLastFrameStats().TasksCount[(int32)GPUTask::Priority::Low] == 1);
+        CHECK(manager.GetLastFrameStats().DeferredCount == 2);
+
+        // High priority tasks continue
+        CHECK(manager.RequestWork(buffer, 8) == 1);
+        CHECK(buffer[0] == tasks[2]);
+        manager.FrameEnd();
+        CHECK(manager.GetTaskCount() == 1);
+
+        // Canceled task left in a queue due to budget limit is removed at the frame end
+        tasks[3]->Cancel();
+        manager.FrameEnd();
+        CHECK(manager.GetTaskCount() == 0);
+
+        low->Cancel();
+        for (GPUTask* task : tasks)
+            task->Cancel();
+    }
+}
@@ -0,0 +1,131 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#include "Engine/Graphics/Models/MeshBase.h"
+#include "Engine/Graphics/Models/MeshDeformation.h"
+#include "Engine/Graphics/GPUDevice.h"
+#include "Engine/Graphics/GPUBuffer.h"
+#include "Engine/Core/Log.h"
+#include "Engine/Core/Math/Math.h"
+#include "Engine/Core/Collections/Array.h"
+#include "Engine/Platform/Platform.h"
+#include <ThirdParty/catch2/catch.hpp>
+
+namespace
+{
+    int64 SpanDeformerCalls = 0;
+
+    // Mesh with the vertex data kept in memory (deformation doesn't need the model asset)
+    class BenchmarkMesh : public MeshBase
+    {
+    public:
+        BytesContainer VertexData;
+
+        BenchmarkMesh(const Array<VB0ElementType>& vertices)
+            : MeshBase(SpawnParams(Guid::New(), TypeInitializer))
+        {
+            _model = nullptr;
+            _index = 0;
+            _lodIndex = 0;
+            _vertices = vertices.Count();
+            _triangles = 0;
+            _materialSlotIndex = 0;
+            _use16BitIndexBuffer = false;
+            VertexData.Copy((const byte*)vertices.Get(), vertices.Count() * sizeof(VB0ElementType));
+            BoundingBox::FromPoints((const Float3*)vertices.Get(), vertices.Count(), _box);
+            BoundingSphere::FromBox(_box, _sphere);
+        }
+
+        bool DownloadDataGPU(MeshBufferType type, BytesContainer& result) const override
+        {
+            return true;
+        }
+
+        Task* DownloadDataGPUAsync(MeshBufferType type, BytesContainer& result) const override
+        {
+            return nullptr;
+        }
+
+        bool DownloadDataCPU(MeshBufferType type, BytesContainer& result, int32& count) const override
+        {
+            if (type != MeshBufferType::Vertex0)
+                return true;
+            result.Link(VertexData);
+            count = (int32)_vertices;
+            return false;
+        }
+    };
+
+    void RunWaveDeformer(const MeshBase* mesh, MeshDeformationData& deformation, MeshDeformationSpan& span)
+    {
+        Platform::InterlockedIncrement(&SpanDeformerCalls);
+        auto data = (VB0ElementType*)deformation.VertexBuffer.Data.Get();
+        for (uint32 vertexIndex = span.VertexStart; vertexIndex <= span.VertexEnd; vertexIndex++)
+        {
+            Float3& position = data[vertexIndex].Position;
+            position.Y += Math::Sin(position.X * 0.01f + position.Z * 0.02f) * 10.0f;
+        }
+        span.DirtyMinIndex = span.VertexStart;
+        span.DirtyMaxIndex = span.VertexEnd;
+    }
+}
+
+TEST_CASE("MeshDeformation")
+{
+    SECTION("Benchmark Span Deformers")
+    {
+        // Run the editor with -null to measure the deformation without GPU work
+        const int32 meshesCount = 100;
+        const int32 vertexCount = 50000;
+        const int32 spansPerMesh = (vertexCount + MeshDeformation::SpanSize - 1) / MeshDeformation::SpanSize;
+        Array<VB0ElementType> vertices;
+        vertices.Resize(vertexCount);
+        for (int32 i = 0; i < vertexCount; i++)
+            vertices[i].Position = Float3((float)(i % 250) * 10.0f, 0.0f, (float)(i / 250) * 10.0f);
+        GPUBuffer* vertexBuffer = GPUDevice::Instance->CreateBuffer(TEXT("MeshDeformationBenchmark"));
+        REQUIRE(!vertexBuffer->Init(GPUBufferDescription::Vertex(sizeof(VB0ElementType), vertexCount)));
+        Function<void(const MeshBase*, MeshDeformationData&, MeshDeformationSpan&)> deformer;
+        deformer.Bind<&RunWaveDeformer>();
+        Array<BenchmarkMesh*> meshes;
+        Array<MeshDeformation*> deformations;
+        for (int32 i = 0; i < meshesCount; i++)
+        {
+            meshes.Add(New<BenchmarkMesh>(vertices));
+            deformations.Add(New<MeshDeformation>());
+            deformations[i]->AddSpanDeformer(0, 0, MeshBufferType::Vertex0, deformer);
+        }
+
+        // Deform on draw (whole mesh at once on the drawing thread)
+        SpanDeformerCalls = 0;
+        const double drawStartTime = Platform::GetTimeSeconds();
+        for (int32 i = 0; i < meshesCount; i++)
+        {
+            GPUBuffer* buffer = vertexBuffer;
+            deformations[i]->RunDeformers(meshes[i], MeshBufferType::Vertex0, buffer);
+            CHECK(buffer != vertexBuffer);
+        }
+        const double drawTime = Platform::GetTimeSeconds() - drawStartTime;
+        CHECK(SpanDeformerCalls == meshesCount);
+
+        // Deform ahead of the rendering (spans in parallel on Job System)
+        SpanDeformerCalls = 0;
+        for (int32 i = 0; i < meshesCount; i++)
+            deformations[i]->Dirty();
+        const double queuedStartTime = Platform::GetTimeSeconds();
+        MeshDeformation::RunQueuedDeformers();
+        const double queuedTime = Platform::GetTimeSeconds() - queuedStartTime;
+        CHECK(SpanDeformerCalls == meshesCount * spansPerMesh);
+
+        // Nothing to do when deformations are up to date
+        SpanDeformerCalls = 0;
+        MeshDeformation::RunQueuedDeformers();
+        CHECK(SpanDeformerCalls == 0);
+
+        LOG(Info, "Deforming {0} meshes ({1} vertices each): {2} ms on draw, {3} ms ahead of rendering ({4} spans)", meshesCount, vertexCount, (float)(drawTime * 1000.0), (float)(queuedTime * 1000.0), meshesCount * spansPerMesh);
+        for (int32 i = 0; i < meshesCount; i++)
+        {
+            Delete(deformations[i]);
+            Delete(meshes[i]);
+        }
+        SAFE_DELETE_GPU_RESOURCE(vertexBuffer);
+    }
+}
@@ -0,0 +1,164 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#include "Engine/Particles/ParticlesData.h"
+#include "Engine/Core/Log.h"
+#include "Engine/Core/Math/Math.h"
+#include "Engine/Core/Math/Vector2.h"
+#include "Engine/Core/Math/Vector3.h"
+#include "Engine/Core/Math/Vector4.h"
+#include "Engine/Core/Collections/Array.h"
+#include "Engine/Platform/Platform.h"
+#include <ThirdParty/catch2/catch.hpp>
+
+namespace
+{
+    struct SimulationLayout
+    {
+        ParticleLayout Layout;
+        int32 Position, Velocity, Age, Lifetime, Color, SpriteSize;
+
+        SimulationLayout(bool quantized)
+        {
+            // The same attributes as the typical CPU emitter with sprite rendering and color over life
+            Layout.Clear();
+            Position = Layout.AddAttribute(TEXT("Position"), ParticleAttribute::ValueTypes::Float3);
+            Velocity = Layout.AddAttribute(TEXT("Velocity"), ParticleAttribute::ValueTypes::Float3);
+            Age = Layout.AddAttribute(TEXT("Age"), ParticleAttribute::ValueTypes::Float);
+            Lifetime = Layout.AddAttribute(TEXT("Lifetime"), ParticleAttribute::ValueTypes::Float);
+            Color = Layout.AddAttribute(TEXT("Color"), ParticleAttribute::ValueTypes::Float4);
+            SpriteSize = Layout.AddAttribute(TEXT("SpriteSize"), ParticleAttribute::ValueTypes::Float2);
+            if (quantized)
+            {
+                // The same as ParticleEmitterGraphCPU::UseQuantizedLayout
+                Layout.SetAttributeFormat(Color, ParticleAttribute::Formats::Half);
+                Layout.SetAttributeFormat(SpriteSize, ParticleAttribute::Formats::Half);
+            }
+            Layout.UpdateLayout();
+        }
+    };
+
+    void SpawnParticles(const SimulationLayout& layout, Array<byte>& buffer, int32 count)
+    {
+        const int32 stride = layout.Layout.Size;
+        buffer.Resize(count * stride);
+        byte* ptr = buffer.Get();
+        for (int32 i = 0; i < count; i++)
+        {
+            const auto& attributes = layout.Layout.Attributes;
+            attributes[layout.Position].Write(ptr + attributes[layout.Position].Offset, Float3((float)(i % 1000), 0.0f, (float)(i / 1000)));
+            attributes[layout.Velocity].Write(ptr + attributes[layout.Velocity].Offset, Float3(0.0f, 100.0f, 0.0f));
+            attributes[layout.Age].Write(ptr + attributes[layout.Age].Offset, 0.0f);
+            attributes[layout.Lifetime].Write(ptr + attributes[layout.Lifetime].Offset, 5.0f);
+            attributes[layout.Color].Write(ptr + attributes[layout.Color].Offset, Float4::One);
+            attributes[layout.SpriteSize].Write(ptr + attributes[layout.SpriteSize].Offset, Float2(50.0f));
+            ptr += stride;
+        }
+    }
+
+    double SimulateParticles(const SimulationLayout& layout, Array<byte>& buffer, int32 count, int32 framesCount)
+    {
+        // Mirrors the CPU modules: integrate position and age, set color and sprite size over life
+        const auto& attributes = layout.Layout.Attributes;
+        const ParticleAttribute& color = attributes[layout.Color];
+        const ParticleAttribute& spriteSize = attributes[layout.SpriteSize];
+        const int32 stride = layout.Layout.Size;
+        const float dt = 1.0f / 60.0f;
+        const double startTime = Platform::GetTimeSeconds();
+        for (int32 frame = 0; frame < framesCount; frame++)
+        {
+            byte* positionPtr = buffer.Get() + attributes[layout.Position].Offset;
+            byte* velocityPtr = buffer.Get() + attributes[layout.Velocity].Offset;
+            byte* agePtr = buffer.Get() + attributes[layout.Age].Offset;
+            byte* lifetimePtr = buffer.Get() + attributes[layout.Lifetime].Offset;
+            byte* colorPtr = buffer.Get() + color.Offset;
+            byte* spriteSizePtr = buffer.Get() + spriteSize.Offset;
+            for (int32 i = 0; i < count; i++)
+            {
+                *(Float3*)positionPtr += *(Float3*)velocityPtr * dt;
+                *(float*)agePtr += dt;
+                const float normalizedAge = Math::Saturate(*(float*)agePtr / *(float*)lifetimePtr);
+                color.Write(colorPtr, Float4(1.0f, 1.0f - normalizedAge, 0.0f, 1.0f - normalizedAge));
+                spriteSize.Write(spriteSizePtr, spriteSize.Read<Float2>(spriteSizePtr) * 0.99f);
+                positionPtr += stride;
+                velocityPtr += stride;
+                agePtr += stride;
+                lifetimePtr += stride;
+                colorPtr += stride;
+                spriteSizePtr += stride;
+            }
+        }
+        return Platform::GetTimeSeconds() - startTime;
+    }
+}
+
+TEST_CASE("Particles")
+{
+    SECTION("Test Attribute Formats")
+    {
+        ParticleLayout layout;
+        layout.Clear();
+        const int32 color = layout.AddAttribute(TEXT("Color"), ParticleAttribute::ValueTypes::Float4);
+        const int32 index = layout.AddAttribute(TEXT("Index"), ParticleAttribute::ValueTypes::Int);
+        CHECK(layout.SetAttributeFormat(index, ParticleAttribute::Formats::Half));
+        const Float4 value(0.25f, 0.5f, 0.75f, 1.0f);
+        byte data[16];
+
+        CHECK(!layout.SetAttributeFormat(color, ParticleAttribute::Formats::Half));
+        layout.UpdateLayout();
+        CHECK(layout.Size == 12);
+        CHECK(layout.Attributes[index].Offset == 8);
+        CHECK(layout.Attributes[color].GetShaderOffset() == (1 << 24));
+        layout.Attributes[color].Write(data, Float4(0.1f, -2.0f, 100.0f, 1.0f));
+        CHECK(Float4::NearEqual(layout.Attributes[color].Read<Float4>(data), Float4(0.1f, -2.0f, 100.0f, 1.0f), 0.05f));
+
+        CHECK(!layout.SetAttributeFormat(color, ParticleAttribute::Formats::UNorm8));
+        layout.UpdateLayout();
+        CHECK(layout.Size == 8);
+        layout.Attributes[color].Write(data, value);
+        CHECK(Float4::NearEqual(layout.Attributes[color].Read<Float4>(data), value, 1.0f / 255.0f));
+        layout.Attributes[color].Write(data, Float4(2.0f, -1.0f, 0.0f, 1.0f));
+        CHECK(Float4::NearEqual(layout.Attributes[color].Read<Float4>(data), Float4(1.0f, 0.0f, 0.0f, 1.0f), ZeroTolerance));
+
+        CHECK(!layout.SetAttributeFormat(color, ParticleAttribute::Formats::UNorm16));
+        layout.UpdateLayout();
+        CHECK(layout.Size == 12);
+        layout.Attributes[color].Write(data, value);
+        CHECK(Float4::NearEqual(layout.Attributes[color].Read<Float4>(data), value, 1.0f / 65535.0f));
+
+        CHECK(!layout.SetAttributeFormat(color, ParticleAttribute::Formats::Default));
+        layout.UpdateLayout();
+        CHECK(layout.Size == 20);
+        layout.Attributes[color].Write(data, value);
+        CHECK(layout.Attributes[color].Read<Float4>(data) == value);
+    }
+    SECTION("Benchmark Quantized Layout")
+    {
+        const int32 particlesCount = 1000000;
+        const int32 framesCount = 10;
+        Array<byte> buffer;
+
+        // Full-precision layout
+        SimulationLayout fullLayout(false);
+        SpawnParticles(fullLayout, buffer, particlesCount);
+        const double fullTime = SimulateParticles(fullLayout, buffer, particlesCount, framesCount);
+        const int32 fullUploadSize = buffer.Count();
+
+        // Quantized layout (half-precision color and sprite size)
+        SimulationLayout quantizedLayout(true);
+        SpawnParticles(quantizedLayout, buffer, particlesCount);
+        const double quantizedTime = SimulateParticles(quantizedLayout, buffer, particlesCount, framesCount);
+        const int32 quantizedUploadSize = buffer.Count();
+        CHECK(quantizedLayout.Layout.Size == fullLayout.Layout.Size - 12);
+        CHECK(quantizedUploadSize < fullUploadSize);
+
+        // Values are still valid after many encode/decode rounds
+        const auto& spriteSize = quantizedLayout.Layout.Attributes[quantizedLayout.SpriteSize];
+        const Float2 size = spriteSize.Read<Float2>(buffer.Get() + (particlesCount - 1) * quantizedLayout.Layout.Size + spriteSize.Offset);
+        CHECK(Math::NearEqual(size.X, 50.0f * Math::Pow(0.99f, (float)framesCount), 0.5f));
+
+        LOG(Info, "Simulating {0} CPU particles: {1} ms/frame with {2} MB upload ({3} bytes per particle), quantized: {4} ms/frame with {5} MB upload ({6} bytes per particle)",
+            particlesCount,
+            (float)(fullTime * 1000.0 / framesCount), fullUploadSize / (1024 * 1024), fullLayout.Layout.Size,
+            (float)(quantizedTime * 1000.0 / framesCount), quantizedUploadSize / (1024 * 1024), quantizedLayout.Layout.Size);
+    }
+}
@@ -0,0 +1,167 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#include "Engine/Core/RandomStream.h"
+#include "Engine/Utilities/RectPack.h"
+#include <ThirdParty/catch2/catch.hpp>
+
+namespace
+{
+    struct TestNode : RectPackNode<uint32>
+    {
+        int32 Id = -1;
+
+        TestNode(uint32 x, uint32 y, uint32 width, uint32 height)
+            : RectPackNode<uint32>(x, y, width, height)
+        {
+        }
+
+        void OnInsert(int32 id)
+        {
+            Id = id;
+        }
+
+        void OnFree()
+        {
+        }
+    };
+
+    bool Overlaps(const TestNode* a, const TestNode* b)
+    {
+        return a->X < b->X + b->Width && b->X < a->X + a->Width && a->Y < b->Y + b->Height && b->Y < a->Y + a->Height;
+    }
+
+    bool IsValid(const RectPackAtlas<TestNode>& atlas)
+    {
+        const auto& nodes = atlas.GetNodes();
+        for (int32 i = 0; i < nodes.Count(); i++)
+        {
+            const TestNode* a = nodes[i];
+            if (a->X + a->Width > atlas.GetWidth() || a->Y + a->Height > atlas.GetHeight())
+                return false;
+            for (int32 j = i + 1; j < nodes.Count(); j++)
+            {
+                if (Overlaps(a, nodes[j]))
+                    return false;
+            }
+        }
+        return true;
+    }
+}
+
+TEST_CASE("RectPack")
+{
+    SECTION("Test Insert")
+    {
+        RectPackAtlas<TestNode> atlas(0, 0, 64, 64);
+        for (int32 i = 0; i < 16; i++)
+        {
+            TestNode* node = atlas.Insert(16, 16, 0, i);
+            REQUIRE(node != nullptr);
+            CHECK(node->Id == i);
+        }
+        CHECK(atlas.Insert(1, 1, 0, 16) == nullptr);
+        CHECK(IsValid(atlas));
+        CHECK(atlas.GetStats().GetOccupancy() == 1.0f);
+    }
+
+    SECTION("Test Padding")
+    {
+        RectPackAtlas<TestNode> atlas(0, 0, 64, 64);
+        TestNode* node = atlas.Insert(10, 20, 2, 0);
+        REQUIRE(node != nullptr);
+        CHECK(node->Width == 12);
+        CHECK(node->Height == 22);
+    }
+
+    SECTION("Test Free")
+    {
+        // Fill the whole atlas, free everything and check if the whole space can be reused
+        RectPackAtlas<TestNode> atlas(0, 0, 64, 64);
+        Array<TestNode*> nodes;
+        for (int32 i = 0; i < 64; i++)
+            nodes.Add(atlas.Insert(8, 8, 0, i));
+        for (TestNode* node : nodes)
+            REQUIRE(node != nullptr);
+        for (int32 i = 0; i < nodes.Count(); i += 2)
+            atlas.Free(nodes[i]);
+        CHECK(atlas.GetStats().Nodes == 32);
+        for (int32 i = 1; i < nodes.Count(); i += 2)
+            atlas.Free(nodes[i]);
+        CHECK(atlas.GetStats().Nodes == 0);
+        CHECK(atlas.GetStats().FreeRects == 1);
+        CHECK(atlas.Insert(64, 64, 0, 0) != nullptr);
+    }
+
+    SECTION("Test Defragment")
+    {
+        RectPackAtlas<TestNode> atlas(0, 0, 128, 128);
+        RandomStream rand(101);
+        Array<TestNode*> nodes;
+        for (int32 i = 0; i < 200; i++)
+        {
+            TestNode* node = atlas.Insert(4 + (uint32)(rand.GetFraction() * 12), 4 + (uint32)(rand.GetFraction() * 12), 0, i);
+            if (node)
+                nodes.Add(node);
+            if (nodes.HasItems() && rand.GetFraction() < 0.4f)
+            {
+                const int32 index = Math::Min((int32)(rand.GetFraction() * nodes.Count()), nodes.Count() - 1);
+                atlas.Free(nodes[index]);
+                nodes.RemoveAt(index);
+            }
+        }
+        CHECK(IsValid(atlas));
+        const int32 count = atlas.GetStats().Nodes;
+        Array<RectPackAtlas<TestNode>::Relocation> relocations;
+        CHECK(!atlas.Defragment(relocations));
+        CHECK(IsValid(atlas));
+        CHECK(atlas.GetStats().Nodes == count);
+        for (const auto& e : relocations)
+            CHECK((e.Node->X != e.PrevX || e.Node->Y != e.PrevY));
+    }
+
+    SECTION("Test Large Atlas")
+    {
+        // Many small nodes with churn (sizes are multiples of the cell size so overlaps can be checked on a grid)
+        const uint32 cellSize = 8, gridSize = 1024;
+        RectPackAtlas<TestNode> atlas(0, 0, cellSize * gridSize, cellSize * gridSize);
+        RandomStream rand(7);
+        Array<TestNode*> nodes;
+        for (int32 i = 0; i < 60000; i++)
+        {
+            TestNode* node = atlas.Insert(cellSize * (1 + (uint32)(rand.GetFraction() * 6)), cellSize * (1 + (uint32)(rand.GetFraction() * 6)), 0, i);
+            if (node)
+                nodes.Add(node);
+            if (nodes.Count() > 20000 || (nodes.HasItems() && rand.GetFraction() < 0.3f))
+            {
+                const int32 index = Math::Min((int32)(rand.GetFraction() * nodes.Count()), nodes.Count() - 1);
+                atlas.Free(nodes[index]);
+                nodes.RemoveAtKeepOrder(index);
+            }
+        }
+        CHECK(atlas.GetStats().Nodes == nodes.Count());
+        Array<bool> grid;
+        grid.Resize(gridSize * gridSize);
+        Platform::MemoryClear(grid.Get(), grid.Count() * sizeof(bool));
+        bool valid = true;
+        for (const TestNode* node : atlas.GetNodes())
+        {
+            valid &= node->X % cellSize == 0 && node->Y % cellSize == 0 && node->X + node->Width <= atlas.GetWidth() && node->Y + node->Height <= atlas.GetHeight();
+            for (uint32 y = node->Y / cellSize; valid && y < (node->Y + node->Height) / cellSize; y++)
+            {
+                for (uint32 x = node->X / cellSize; x < (node->X + node->Width) / cellSize; x++)
+                {
+                    valid &= !grid[y * gridSize + x];
+                    grid[y * gridSize + x] = true;
+                }
+            }
+        }
+        CHECK(valid);
+
+        // Releasing all nodes gives back the whole area
+        for (TestNode* node : nodes)
+            atlas.Free(node);
+        CHECK(atlas.GetStats().Nodes == 0);
+        CHECK(atlas.GetStats().FreeRects == 1);
+        CHECK(atlas.Insert(cellSize * gridSize, cellSize * gridSize, 0, 0) != nullptr);
+    }
+}
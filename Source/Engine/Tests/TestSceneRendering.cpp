@@ -0,0 +1,148 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#include "Engine/Level/Scene/SceneRendering.h"
+#include "Engine/Level/Actors/StaticModel.h"
+#include "Engine/Content/Content.h"
+#include "Engine/Content/AssetReference.h"
+#include "Engine/Content/Assets/Model.h"
+#include "Engine/Core/Log.h"
+#include "Engine/Core/Collections/Array.h"
+#include "Engine/Graphics/RenderTask.h"
+#include "Engine/Platform/Platform.h"
+#include "Engine/Renderer/RenderList.h"
+#include "Engine/Threading/JobSystem.h"
+#include <ThirdParty/catch2/catch.hpp>
+
+namespace
+{
+    void SetupCubeModel(Model* model)
+    {
+        const Float3 vertices[8] =
+        {
+            Float3(-50, -50, -50), Float3(50, -50, -50), Float3(50, 50, -50), Float3(-50, 50, -50),
+            Float3(-50, -50, 50), Float3(50, -50, 50), Float3(50, 50, 50), Float3(-50, 50, 50),
+        };
+        const uint32 triangles[36] =
+        {
+            0, 2, 1, 0, 3, 2, 4, 5, 6, 4, 6, 7, 0, 1, 5, 0, 5, 4,
+            3, 6, 2, 3, 7, 6, 0, 4, 7, 0, 7, 3, 1, 2, 6, 1, 6, 5,
+        };
+        int32 meshesCount = 1;
+        model->SetupLODs(Span<int32>(&meshesCount, 1));
+        model->LODs[0].Meshes[0].UpdateMesh(8, 12, vertices, triangles);
+    }
+
+    void SetupPointLightBatch(RenderContextBatch& batch, const Float3& lightPosition, float lightRadius, bool cachedStatic)
+    {
+        // Main view looks away from the light so the casters are visible only in the shadow map faces
+        batch.Contexts.Resize(7);
+        RenderContext& mainContext = batch.Contexts[0];
+        mainContext.List = RenderList::GetFromPool();
+        mainContext.View.Pass = DrawPass::Default;
+        mainContext.View.SetProjector(10.0f, 1000.0f, lightPosition + Float3(0, 0, -lightRadius * 4), Float3::Backward, Float3::Up, 60.0f);
+        mainContext.View.PrepareCache(mainContext, 1920.0f, 1080.0f, Float2::Zero);
+        for (int32 faceIndex = 0; faceIndex < 6; faceIndex++)
+        {
+            RenderContext& shadowContext = batch.Contexts[faceIndex + 1];
+            shadowContext.List = RenderList::GetFromPool();
+            shadowContext.View.Pass = DrawPass::Depth;
+            shadowContext.View.SetUpCube(10.0f, lightRadius, lightPosition);
+            shadowContext.View.SetFace(faceIndex);
+            shadowContext.View.PrepareCache(shadowContext, 512.0f, 512.0f, Float2::Zero, &mainContext.View);
+            if (cachedStatic)
+            {
+                // The same as ShadowsPass does for the dynamic objects drawn on top of the cached static shadow map
+                shadowContext.View.StaticFlagsMask = StaticFlags::Transform;
+                shadowContext.View.StaticFlagsMaskInverted = true;
+            }
+        }
+    }
+
+    double DrawSceneFrames(SceneRendering& scene, RenderContextBatch& batch, int32 framesCount, int32& drawCallsCount, int32& shadowDrawCallsCount)
+    {
+        const double startTime = Platform::GetTimeSeconds();
+        for (int32 frame = 0; frame < framesCount; frame++)
+        {
+            for (const RenderContext& renderContext : batch.Contexts)
+                renderContext.List->Clear();
+            scene.Draw(batch, SceneRendering::SceneDrawAsync);
+            for (const uint64 label : batch.WaitLabels)
+                JobSystem::Wait(label);
+            batch.WaitLabels.Clear();
+        }
+        const double time = Platform::GetTimeSeconds() - startTime;
+        drawCallsCount = batch.Contexts[0].List->DrawCalls.Count();
+        shadowDrawCallsCount = 0;
+        for (int32 i = 1; i < batch.Contexts.Count(); i++)
+            shadowDrawCallsCount += batch.Contexts[i].List->ShadowDepthDrawCallsList.Indices.Count();
+        return time;
+    }
+
+    void ReleaseBatch(RenderContextBatch& batch)
+    {
+        for (const RenderContext& renderContext : batch.Contexts)
+            RenderList::ReturnToPool(renderContext.List);
+        batch.Contexts.Clear();
+    }
+}
+
+TEST_CASE("SceneRendering")
+{
+    SECTION("Benchmark Cached Shadows Static Casters")
+    {
+        // Run the editor with -null to measure the draw calls collection without GPU work
+        const int32 actorsCount = 10000;
+        const int32 framesCount = 30;
+        const Float3 lightPosition = Float3::Zero;
+        const float lightRadius = 10000.0f;
+        AssetReference<Model> model = Content::CreateVirtualAsset<Model>();
+        REQUIRE(model);
+        SetupCubeModel(model);
+
+        // Spawn static casters around the point light
+        SceneRendering scene;
+        Array<StaticModel*> actors;
+        Array<int32> keys;
+        actors.Resize(actorsCount);
+        keys.Resize(actorsCount);
+        uint32 seed = 1;
+        for (int32 i = 0; i < actorsCount; i++)
+        {
+            seed = seed * 1664525u + 1013904223u;
+            const Float3 direction = Float3::Normalize(Float3((float)(seed & 0xff) - 127.5f, (float)((seed >> 8) & 0xff) - 127.5f, (float)((seed >> 16) & 0xff) - 127.5f));
+            auto actor = New<StaticModel>();
+            actor->SetStaticFlags(StaticFlags::FullyStatic);
+            actor->SetPosition(lightPosition + direction * (lightRadius * (0.1f + (float)(seed >> 24) / 255.0f * 0.8f)));
+            actor->SetForcedLOD(0);
+            actor->Model = model;
+            actors[i] = actor;
+            keys[i] = -1;
+            scene.AddActor(actor, keys[i]);
+        }
+
+        // Shadow map redrawn every frame (all casters)
+        RenderContextBatch batch;
+        int32 drawCallsCount, shadowDrawCallsCount;
+        SetupPointLightBatch(batch, lightPosition, lightRadius, false);
+        const double allTime = DrawSceneFrames(scene, batch, framesCount, drawCallsCount, shadowDrawCallsCount);
+        CHECK(drawCallsCount == actorsCount);
+        CHECK(shadowDrawCallsCount >= actorsCount);
+        ReleaseBatch(batch);
+
+        // Cached static shadow map (dynamic casters only)
+        SetupPointLightBatch(batch, lightPosition, lightRadius, true);
+        const double cachedTime = DrawSceneFrames(scene, batch, framesCount, drawCallsCount, shadowDrawCallsCount);
+        CHECK(drawCallsCount == 0);
+        CHECK(shadowDrawCallsCount == 0);
+        ReleaseBatch(batch);
+
+        LOG(Info, "Point light shadow with {0} static casters: {1} ms/frame, with cached static shadow map: {2} ms/frame", actorsCount, (float)(allTime * 1000.0 / framesCount), (float)(cachedTime * 1000.0 / framesCount));
+        for (int32 i = 0; i < actorsCount; i++)
+        {
+            scene.RemoveActor(actors[i], keys[i]);
+            actors[i]->DeleteObject();
+        }
+        scene.Clear();
+        Content::DeleteAsset(model);
+    }
+}
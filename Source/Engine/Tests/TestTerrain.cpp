@@ -0,0 +1,115 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#include "Engine/Terrain/Terrain.h"
+#include "Engine/Core/Math/Matrix.h"
+#include "Engine/Core/Math/BoundingBox.h"
+#include "Engine/Core/Math/BoundingFrustum.h"
+#include "Engine/Core/Collections/Array.h"
+#include <ThirdParty/catch2/catch.hpp>
+
+namespace
+{
+    struct TestChunks
+    {
+        Vector3 Origin;
+        int32 Count = 0;
+        int32 Stride = 0;
+        Array<float> Bounds;
+        Array<bool> Visible;
+        Array<float> Distances;
+
+        TestChunks(const Vector3& origin, const Array<BoundingBox>& boxes)
+            : Origin(origin)
+            , Count(boxes.Count())
+            , Stride(Math::AlignUp(boxes.Count(), 4))
+        {
+            Bounds.Resize(Stride * 6);
+            Platform::MemoryClear(Bounds.Get(), Bounds.Count() * sizeof(float));
+            for (int32 i = 0; i < Count; i++)
+            {
+                const Float3 center = boxes[i].GetCenter() - Origin;
+                const Float3 extent = boxes[i].GetSize() * 0.5f;
+                Bounds[Stride * 0 + i] = center.X;
+                Bounds[Stride * 1 + i] = center.Y;
+                Bounds[Stride * 2 + i] = center.Z;
+                Bounds[Stride * 3 + i] = extent.X;
+                Bounds[Stride * 4 + i] = extent.Y;
+                Bounds[Stride * 5 + i] = extent.Z;
+            }
+            Visible.Resize(Count);
+            Distances.Resize(Stride);
+        }
+
+        void Cull(const BoundingFrustum& frustum, const Vector3& viewPosition, float lodScale, bool cullingDisabled = false)
+        {
+            Terrain::CullChunks(Bounds.Get(), Count, Stride, frustum, (Float3)Origin, cullingDisabled, (Float3)(viewPosition - Origin), lodScale, Visible.Get(), Distances.Get());
+        }
+    };
+
+    BoundingFrustum GetTestFrustum(const Float3& position, const Float3& direction)
+    {
+        Matrix view, projection, viewProjection;
+        Matrix::LookAt(position, position + direction, Float3::Up, view);
+        Matrix::PerspectiveFov(PI_OVER_2, 1.0f, 10.0f, 10000.0f, projection);
+        Matrix::Multiply(view, projection, viewProjection);
+        return BoundingFrustum(viewProjection);
+    }
+
+    BoundingBox GetTestBox(const Float3& center, float extent)
+    {
+        return BoundingBox(center - extent, center + extent);
+    }
+}
+
+TEST_CASE("Terrain")
+{
+    SECTION("Test Chunks Culling")
+    {
+        const BoundingFrustum frustum = GetTestFrustum(Float3::Zero, Float3::Forward);
+        Array<BoundingBox> boxes;
+        boxes.Add(GetTestBox(Float3(0, 0, 500), 50)); // In front
+        boxes.Add(GetTestBox(Float3(0, 0, -500), 50)); // Behind
+        boxes.Add(GetTestBox(Float3(5000, 0, 500), 50)); // On side
+        boxes.Add(GetTestBox(Float3(0, 0, 20000), 50)); // After far plane
+        boxes.Add(GetTestBox(Float3(0, 0, 5), 50)); // Crossing near plane
+        boxes.Add(GetTestBox(Float3(520, 0, 500), 50)); // Crossing side plane
+        TestChunks chunks(Float3(100, -200, 300), boxes);
+        chunks.Cull(frustum, Float3::Zero, 1.0f);
+        CHECK(chunks.Visible[0] == true);
+        CHECK(chunks.Visible[1] == false);
+        CHECK(chunks.Visible[2] == false);
+        CHECK(chunks.Visible[3] == false);
+        CHECK(chunks.Visible[4] == true);
+        CHECK(chunks.Visible[5] == true);
+
+        // Disabled culling
+        chunks.Cull(frustum, Float3::Zero, 1.0f, true);
+        for (int32 i = 0; i < chunks.Count; i++)
+            CHECK(chunks.Visible[i] == true);
+    }
+
+    SECTION("Test Chunks Culling Reference")
+    {
+        // Compare vectorized pass against the scalar frustum test on a grid of chunks (count not aligned to 4 to cover the tail)
+        const Float3 viewPosition(1200, 300, -800);
+        const BoundingFrustum frustum = GetTestFrustum(viewPosition, Float3(0.3f, -0.2f, 1.0f).GetNormalized());
+        Array<BoundingBox> boxes;
+        for (int32 z = 0; z < 11; z++)
+        {
+            for (int32 x = 0; x < 11; x++)
+                boxes.Add(GetTestBox(Float3(x * 613.0f - 1500.0f, (float)((x * 7 + z * 3) % 5) * 40.0f, z * 587.0f - 900.0f), 127.0f));
+        }
+        TestChunks chunks(Float3(50, 0, 50), boxes);
+        const float lodScale = 1.0f / 512.0f;
+        chunks.Cull(frustum, viewPosition, lodScale);
+        int32 visibleCount = 0;
+        for (int32 i = 0; i < chunks.Count; i++)
+        {
+            CHECK(chunks.Visible[i] == frustum.Intersects(boxes[i]));
+            CHECK(Math::NearEqual(chunks.Distances[i], (float)Vector3::Distance(boxes[i].GetCenter(), viewPosition) * lodScale, 0.001f));
+            visibleCount += chunks.Visible[i] ? 1 : 0;
+        }
+        CHECK(visibleCount > 0);
+        CHECK(visibleCount < chunks.Count);
+    }
+}
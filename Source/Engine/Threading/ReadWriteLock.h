@@ -0,0 +1,130 @@
+// Copyright (c) 2012-2024 Wojciech Figat. All rights reserved.
+
+#pragma once
+
+#include "Engine/Platform/Platform.h"
+
+/// <summary>
+/// Lightweight reader-writer lock that allows many threads to read the shared data at once or a single thread to modify it.
+/// Waiting writers have priority over the new readers. Locking is not recursive. Use it for data that is read often and modified rarely (waiting threads spin).
+/// </summary>
+class ReadWriteLock
+{
+private:
+    mutable volatile int64 _readers = 0;
+    mutable volatile int64 _writers = 0;
+    mutable volatile int64 _writing = 0;
+
+public:
+    ReadWriteLock() = default;
+    ReadWriteLock(const ReadWriteLock&) = delete;
+    ReadWriteLock& operator=(const ReadWriteLock&) = delete;
+
+public:
+    /// <summary>
+    /// Locks for reading. Blocks while the lock is owned by the writer or any writer is waiting for it.
+    /// </summary>
+    void LockRead() const
+    {
+        while (true)
+        {
+            while (Platform::AtomicRead(&_writers) != 0)
+                Platform::Sleep(0);
+            Platform::InterlockedIncrement(&_readers);
+            if (Platform::AtomicRead(&_writers) == 0)
+                return;
+            Platform::InterlockedDecrement(&_readers);
+        }
+    }
+
+    /// <summary>
+    /// Releases the read lock.
+    /// </summary>
+    void UnlockRead() const
+    {
+        Platform::InterlockedDecrement(&_readers);
+    }
+
+    /// <summary>
+    /// Locks for writing. Blocks until all readers and the other writers release the lock.
+    /// </summary>
+    void LockWrite() const
+    {
+        Platform::InterlockedIncrement(&_writers);
+        while (Platform::InterlockedCompareExchange(&_writing, 1, 0) != 0)
+            Platform::Sleep(0);
+        while (Platform::AtomicRead(&_readers) != 0)
+            Platform::Sleep(0);
+    }
+
+    /// <summary>
+    /// Releases the write lock.
+    /// </summary>
+    void UnlockWrite() const
+    {
+        Platform::InterlockedExchange(&_writing, 0);
+        Platform::InterlockedDecrement(&_writers);
+    }
+};
+
+/// <summary>
+/// Scope locker for reading data guarded by reader-writer lock.
+/// </summary>
+class ScopeReadLock
+{
+private:
+    const ReadWriteLock* _lock;
+
+    ScopeReadLock(const ScopeReadLock&) = delete;
+    ScopeReadLock& operator=(const ScopeReadLock&) = delete;
+
+public:
+    /// <summary>
+    /// Init, locks for reading.
+    /// </summary>
+    /// <param name="lock">The synchronization object to lock.</param>
+    ScopeReadLock(const ReadWriteLock& lock)
+        : _lock(&lock)
+    {
+        _lock->LockRead();
+    }
+
+    /// <summary>
+    /// Destructor, releases the read lock.
+    /// </summary>
+    ~ScopeReadLock()
+    {
+        _lock->UnlockRead();
+    }
+};
+
+/// <summary>
+/// Scope locker for modifying data guarded by reader-writer lock.
+/// </summary>
+class ScopeWriteLock
+{
+private:
+    const ReadWriteLock* _lock;
+
+    ScopeWriteLock(const ScopeWriteLock&) = delete;
+    ScopeWriteLock& operator=(const ScopeWriteLock&) = delete;
+
+public:
+    /// <summary>
+    /// Init, locks for writing.
+    /// </summary>
+    /// <param name="lock">The synchronization object to lock.</param>
+    ScopeWriteLock(const ReadWriteLock& lock)
+        : _lock(&lock)
+    {
+        _lock->LockWrite();
+    }
+
+    /// <summary>
+    /// Destructor, releases the write lock.
+    /// </summary>
+    ~ScopeWriteLock()
+    {
+        _lock->UnlockWrite();
+    }
+};
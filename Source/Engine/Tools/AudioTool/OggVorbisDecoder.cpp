@@ -47,6 +47,10 @@ bool OggVorbisDecoder::Open(ReadStream* stream, AudioDataInfo& info, uint32 offs
     if (stream == nullptr)
         return false;
 
+    // Release the previously opened data (decoder can be reused for multiple streams)
+    if (OggVorbisFile.datasource != nullptr)
+        ov_clear(&OggVorbisFile);
+
     stream->SetPosition(offset);
     Stream = stream;
     Offset = offset;
@@ -6,8 +6,6 @@
 
 MaterialValue MaterialGenerator::AccessParticleAttribute(Node* caller, const StringView& name, ParticleAttributeValueTypes valueType, const Char* index, ParticleAttributeSpace space)
 {
-    // TODO: cache the attribute value during material tree execution (eg. reuse the same Particle Color read for many nodes in graph)
-
     String mappingName = TEXT("Particle.");
     mappingName += name;
     SerializedMaterialParam* attributeMapping = nullptr;
@@ -69,7 +67,7 @@ MaterialValue MaterialGenerator::AccessParticleAttribute(Node* caller, const Str
     default:
         return MaterialValue::Zero;
     }
-    auto result = writeLocal(type, String::Format(format, attributeMapping->ShaderName, index ? index : TEXT("input.ParticleIndex")), caller);
+    String value = String::Format(format, attributeMapping->ShaderName, index ? index : TEXT("input.ParticleIndex"));
 
     // Apply transformation to world-space
     switch (space)
@@ -77,15 +75,16 @@ MaterialValue MaterialGenerator::AccessParticleAttribute(Node* caller, const Str
     case ParticleAttributeSpace::AsIs:
         break;
     case ParticleAttributeSpace::LocalPosition:
-        _writer.Write(TEXT("\t{0} = TransformParticlePosition({0});\n"), result.Value);
+        value = String::Format(TEXT("TransformParticlePosition({0})"), value);
         break;
     case ParticleAttributeSpace::LocalDirection:
-        _writer.Write(TEXT("\t{0} = TransformParticleVector({0});\n"), result.Value);
+        value = String::Format(TEXT("TransformParticleVector({0})"), value);
         break;
     default: ;
     }
 
-    return result;
+    // Particle data is read-only in material so the same attribute read can be reused by many nodes
+    return writeExpression(type, value, caller);
 }
 
 void MaterialGenerator::ProcessGroupParticles(Box* box, Node* node, Value& value)
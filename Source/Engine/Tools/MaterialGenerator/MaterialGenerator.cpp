@@ -139,6 +139,7 @@ bool MaterialGenerator::Generate(WriteStream& source, MaterialInfo& materialInfo
 
     // Setup and prepare layers
     _writer.Clear();
+    clearExpressions();
     _includes.Clear();
     _callStack.Clear();
     _parameters.Clear();
@@ -461,7 +462,7 @@ bool MaterialGenerator::Generate(WriteStream& source, MaterialInfo& materialInfo
         switch (baseLayer->Domain)
         {
         case MaterialDomain::Surface:
-            srv = 2; // Skinning Bones + Prev Bones
+            srv = 1; // Skinning Bones (current and previous frame bones share one buffer)
             break;
         case MaterialDomain::Decal:
             srv = 1; // Depth buffer
@@ -632,6 +633,7 @@ void MaterialGenerator::clearCache()
     _ddx = Value();
     _ddy = Value();
     _cameraVector = Value();
+    clearExpressions();
 }
 
 void MaterialGenerator::writeBlending(MaterialGraphBoxes box, Value& result, const Value& bottom, const Value& top, const Value& alpha)
@@ -6,145 +6,556 @@
 #include "Engine/Core/Types/BaseTypes.h"
 #include "Engine/Core/Memory/Memory.h"
 #include "Engine/Core/Math/Math.h"
+#include "Engine/Core/Collections/Array.h"
+#include "Engine/Core/Collections/Dictionary.h"
+#include "Engine/Core/Collections/Sorting.h"
 
 /// <summary>
-/// Implementation of the rectangles packing into 2D atlas with padding. Uses simple space division.
+/// The base type for the rectangle allocated within the <see cref="RectPackAtlas"/>. Custom node types should inherit from it and implement OnInsert/OnFree methods.
 /// </summary>
-template<typename NodeType, typename SizeType = uint32>
-struct RectPack
+template<typename SizeType = uint32>
+struct RectPackNode
 {
-    // Left and Right slots allow to easily move around the atlas like in a tree structure.
-    NodeType* Left;
-    NodeType* Right;
+    typedef SizeType Size;
 
     // Position of the entry in the atlas.
-    SizeType X;
-    SizeType Y;
+    Size X;
+    Size Y;
 
-    // Size of the entry.
-    SizeType Width;
-    SizeType Height;
+    // Size of the entry (including the item padding).
+    Size Width;
+    Size Height;
 
-    // True, if slot has been allocated, otherwise it's free.
-    bool IsUsed;
+    // Index of the node in the atlas used nodes list (internal).
+    int32 AtlasIndex = -1;
 
     /// <summary>
-    /// Initializes a new instance of the <see cref="RectPack"/> struct.
+    /// Initializes a new instance of the <see cref="RectPackNode"/> struct.
     /// </summary>
     /// <param name="x">The x.</param>
     /// <param name="y">The y.</param>
     /// <param name="width">The width.</param>
     /// <param name="height">The height.</param>
-    RectPack(SizeType x, SizeType y, SizeType width, SizeType height)
-        : Left(nullptr)
-        , Right(nullptr)
-        , X(x)
+    RectPackNode(Size x, Size y, Size width, Size height)
+        : X(x)
         , Y(y)
         , Width(width)
         , Height(height)
-        , IsUsed(false)
     {
     }
+};
+
+/// <summary>
+/// Implementation of the rectangles packing into 2D atlas with padding. Uses guillotine space division with free rectangles merging so released regions can be reused.
+/// Nodes are pooled (pointers stay valid until node gets freed). Free rectangles are kept in a balanced search tree ordered by size which gives O(log n) insert, free and lookup of the best fitting space.
+/// </summary>
+template<typename NodeType>
+struct RectPackAtlas
+{
+    typedef typename NodeType::Size Size;
+    static_assert(sizeof(Size) <= sizeof(uint32), "Unsupported rectangle size type.");
+
+    /// <summary>
+    /// The node location change performed during atlas defragmentation.
+    /// </summary>
+    struct Relocation
+    {
+        // The moved node (it contains the new location).
+        NodeType* Node;
+
+        // The previous location of the node.
+        Size PrevX;
+        Size PrevY;
+    };
+
+    /// <summary>
+    /// The atlas occupancy statistics.
+    /// </summary>
+    struct Stats
+    {
+        // The amount of allocated nodes.
+        int32 Nodes;
+
+        // The amount of free rectangles (higher value means more fragmented atlas).
+        int32 FreeRects;
+
+        // The area of the allocated nodes.
+        double UsedArea;
+
+        // The total area of the atlas.
+        double TotalArea;
+
+        // Gets the atlas occupancy (normalized to range 0-1).
+        float GetOccupancy() const
+        {
+            return TotalArea > 0.0 ? (float)(UsedArea / TotalArea) : 0.0f;
+        }
+    };
+
+private:
+    struct Rect
+    {
+        Size X, Y, Width, Height;
+    };
+
+    enum
+    {
+        NodesChunkSize = 64,
+    };
+
+    // Free rectangle stored in a treap (binary search tree balanced by random priorities) ordered by height, width and location.
+    struct FreeRect
+    {
+        Rect Value;
+        Size MaxWidth; // The maximum width of the rectangles in this subtree (used to skip subtrees that cannot fit the item)
+        uint32 Priority;
+        int32 Left;
+        int32 Right;
+    };
+
+    Rect _area = {};
+    Array<FreeRect> _freeRects;
+    Array<int32> _freeRectsPool;
+    int32 _freeRectsRoot = -1;
+    int32 _freeRectsCount = 0;
+    uint32 _freeRectsSeed = 0x9E3779B9;
+    Dictionary<uint64, Rect> _freeTopLeft;
+    Dictionary<uint64, Rect> _freeBottomRight;
+    Array<NodeType*> _nodes;
+    Array<NodeType*> _nodesPool;
+    Array<void*> _nodesChunks;
+
+public:
+    RectPackAtlas() = default;
+
+    /// <summary>
+    /// Initializes a new instance of the <see cref="RectPackAtlas"/> struct.
+    /// </summary>
+    /// <param name="x">The atlas area x (can be used to add border padding).</param>
+    /// <param name="y">The atlas area y (can be used to add border padding).</param>
+    /// <param name="width">The atlas area width.</param>
+    /// <param name="height">The atlas area height.</param>
+    RectPackAtlas(Size x, Size y, Size width, Size height)
+    {
+        Init(x, y, width, height);
+    }
+
+    RectPackAtlas(const RectPackAtlas&) = delete;
+    RectPackAtlas& operator=(const RectPackAtlas&) = delete;
+
+    /// <summary>
+    /// Finalizes an instance of the <see cref="RectPackAtlas"/> class.
+    /// </summary>
+    ~RectPackAtlas()
+    {
+        Clear();
+        for (void* chunk : _nodesChunks)
+            Allocator::Free(chunk);
+    }
+
+public:
+    /// <summary>
+    /// Gets the atlas area width.
+    /// </summary>
+    FORCE_INLINE Size GetWidth() const
+    {
+        return _area.Width;
+    }
+
+    /// <summary>
+    /// Gets the atlas area height.
+    /// </summary>
+    FORCE_INLINE Size GetHeight() const
+    {
+        return _area.Height;
+    }
+
+    /// <summary>
+    /// Gets the allocated nodes.
+    /// </summary>
+    FORCE_INLINE const Array<NodeType*>& GetNodes() const
+    {
+        return _nodes;
+    }
+
+    /// <summary>
+    /// Initializes the atlas area. Releases all nodes.
+    /// </summary>
+    /// <param name="x">The atlas area x (can be used to add border padding).</param>
+    /// <param name="y">The atlas area y (can be used to add border padding).</param>
+    /// <param name="width">The atlas area width.</param>
+    /// <param name="height">The atlas area height.</param>
+    void Init(Size x, Size y, Size width, Size height)
+    {
+        _area = { x, y, width, height };
+        Clear();
+    }
 
     /// <summary>
-    /// Finalizes an instance of the <see cref="RectPack"/> class.
+    /// Releases all nodes (without calling OnFree).
     /// </summary>
-    ~RectPack()
+    void Clear()
     {
-        if (Left)
-            Delete(Left);
-        if (Right)
-            Delete(Right);
+        for (NodeType* node : _nodes)
+            ReleaseNode(node);
+        _nodes.Clear();
+        ResetFreeRects();
     }
 
     /// <summary>
-    /// Tries to insert an item into this node using rectangle pack algorithm.
+    /// Tries to insert an item into the atlas.
     /// </summary>
     /// <param name="itemWidth">The item width (in pixels).</param>
     /// <param name="itemHeight">The item height (in pixels).</param>
     /// <param name="itemPadding">The item padding margin (in pixels).</param>
-    /// <param name="args">The additional arguments.</param>
+    /// <param name="args">The additional arguments passed to the node OnInsert method.</param>
     /// <returns>The node that contains inserted an item or null if failed to find a free space.</returns>
     template<class... Args>
-    NodeType* Insert(SizeType itemWidth, SizeType itemHeight, SizeType itemPadding, Args&&...args)
+    NodeType* Insert(Size itemWidth, Size itemHeight, Size itemPadding, Args&&...args)
+    {
+        const Size width = itemWidth + itemPadding;
+        const Size height = itemHeight + itemPadding;
+        Size x, y;
+        if (Allocate(width, height, x, y))
+            return nullptr;
+        NodeType* node = AllocateNode();
+        new(node) NodeType(x, y, width, height);
+        node->AtlasIndex = _nodes.Count();
+        _nodes.Add(node);
+        node->OnInsert(Forward<Args>(args)...);
+        return node;
+    }
+
+    /// <summary>
+    /// Frees the node and returns its area back to the atlas. Node pointer is invalid after this call.
+    /// </summary>
+    /// <param name="node">The node to free.</param>
+    /// <param name="args">The additional arguments passed to the node OnFree method.</param>
+    template<class... Args>
+    void Free(NodeType* node, Args&&...args)
+    {
+        if (!node || node->AtlasIndex == -1)
+            return;
+        ASSERT_LOW_LAYER(_nodes[node->AtlasIndex] == node);
+        node->OnFree(Forward<Args>(args)...);
+        NodeType* last = _nodes.Last();
+        last->AtlasIndex = node->AtlasIndex;
+        _nodes[node->AtlasIndex] = last;
+        _nodes.RemoveLast();
+        if (_nodes.IsEmpty())
+            ResetFreeRects(); // Merging neighbours might not restore the whole area so reset it when atlas gets empty
+        else
+            AddFreeRect({ node->X, node->Y, node->Width, node->Height });
+        ReleaseNode(node);
+    }
+
+    /// <summary>
+    /// Compacts the atlas by packing again all allocated nodes (from the biggest to the smallest) to reduce the fragmentation. Nodes pointers stay valid.
+    /// </summary>
+    /// <param name="relocations">The output list of nodes that changed location (eg. to copy or redraw their contents).</param>
+    /// <returns>True if failed to pack all nodes (atlas state is not modified), otherwise false.</returns>
+    bool Defragment(Array<Relocation>& relocations)
+    {
+        relocations.Clear();
+        Array<NodeType*> nodes(_nodes);
+        Sorting::QuickSort(nodes.Get(), nodes.Count(), &CompareNodes);
+        Array<Rect> prevFreeRects;
+        prevFreeRects.EnsureCapacity(_freeRectsCount);
+        for (const auto& e : _freeTopLeft)
+            prevFreeRects.Add(e.Value);
+        Array<Rect> prevLocations;
+        prevLocations.Resize(nodes.Count());
+        ResetFreeRects();
+        for (int32 i = 0; i < nodes.Count(); i++)
+        {
+            NodeType* node = nodes[i];
+            prevLocations[i] = { node->X, node->Y, node->Width, node->Height };
+            if (Allocate(node->Width, node->Height, node->X, node->Y))
+            {
+                // Restore the previous state
+                for (int32 j = 0; j <= i; j++)
+                {
+                    nodes[j]->X = prevLocations[j].X;
+                    nodes[j]->Y = prevLocations[j].Y;
+                }
+                ClearFreeRects();
+                for (const Rect& rect : prevFreeRects)
+                    InsertFreeRect(rect);
+                return true;
+            }
+        }
+        for (int32 i = 0; i < nodes.Count(); i++)
+        {
+            NodeType* node = nodes[i];
+            if (node->X != prevLocations[i].X || node->Y != prevLocations[i].Y)
+                relocations.Add({ node, prevLocations[i].X, prevLocations[i].Y });
+        }
+        return false;
+    }
+
+    /// <summary>
+    /// Gets the atlas occupancy statistics.
+    /// </summary>
+    Stats GetStats() const
+    {
+        Stats stats;
+        stats.Nodes = _nodes.Count();
+        stats.FreeRects = _freeRectsCount;
+        stats.UsedArea = 0.0;
+        for (const NodeType* node : _nodes)
+            stats.UsedArea += (double)node->Width * (double)node->Height;
+        stats.TotalArea = (double)_area.Width * (double)_area.Height;
+        return stats;
+    }
+
+private:
+    static uint64 GetCornerKey(Size x, Size y)
+    {
+        uint32 bitsX = 0, bitsY = 0;
+        Platform::MemoryCopy(&bitsX, &x, sizeof(Size));
+        Platform::MemoryCopy(&bitsY, &y, sizeof(Size));
+        return ((uint64)bitsX << 32) | bitsY;
+    }
+
+    static bool CompareRects(const Rect& a, const Rect& b)
+    {
+        if (a.Height != b.Height)
+            return a.Height < b.Height;
+        if (a.Width != b.Width)
+            return a.Width < b.Width;
+        if (a.Y != b.Y)
+            return a.Y < b.Y;
+        return a.X < b.X;
+    }
+
+    static bool CompareNodes(NodeType* const& a, NodeType* const& b)
+    {
+        if (a->Height != b->Height)
+            return a->Height > b->Height;
+        return a->Width > b->Width;
+    }
+
+    void ClearFreeRects()
+    {
+        _freeRects.Clear();
+        _freeRectsPool.Clear();
+        _freeRectsRoot = -1;
+        _freeRectsCount = 0;
+        _freeTopLeft.Clear();
+        _freeBottomRight.Clear();
+    }
+
+    void ResetFreeRects()
+    {
+        ClearFreeRects();
+        if (_area.Width > 0 && _area.Height > 0)
+            InsertFreeRect(_area);
+    }
+
+    void UpdateFreeRect(int32 index)
+    {
+        FreeRect& e = _freeRects[index];
+        e.MaxWidth = e.Value.Width;
+        if (e.Left != -1)
+            e.MaxWidth = Math::Max(e.MaxWidth, _freeRects[e.Left].MaxWidth);
+        if (e.Right != -1)
+            e.MaxWidth = Math::Max(e.MaxWidth, _freeRects[e.Right].MaxWidth);
+    }
+
+    // Splits the subtree into rectangles ordered before the given one (left) and the rest (right). Inclusive split moves the given rectangle into the left part.
+    void SplitFreeRects(int32 index, const Rect& rect, bool inclusive, int32& left, int32& right)
     {
-        NodeType* result;
-        const SizeType paddedWidth = itemWidth + itemPadding;
-        const SizeType paddedHeight = itemHeight + itemPadding;
+        if (index == -1)
+        {
+            left = right = -1;
+            return;
+        }
+        FreeRect& e = _freeRects[index];
+        if (inclusive ? !CompareRects(rect, e.Value) : CompareRects(e.Value, rect))
+        {
+            SplitFreeRects(e.Right, rect, inclusive, e.Right, right);
+            left = index;
+        }
+        else
+        {
+            SplitFreeRects(e.Left, rect, inclusive, left, e.Left);
+            right = index;
+        }
+        UpdateFreeRect(index);
+    }
 
-        // Check if we're free and just the right size
-        if (!IsUsed && Width == paddedWidth && Height == paddedHeight)
+    // Merges two subtrees (all rectangles in the left one are ordered before the right one).
+    int32 MergeFreeRects(int32 left, int32 right)
+    {
+        if (left == -1)
+            return right;
+        if (right == -1)
+            return left;
+        if (_freeRects[left].Priority > _freeRects[right].Priority)
         {
-            // Insert into this slot
-            IsUsed = true;
-            result = (NodeType*)this;
-            result->OnInsert(Forward<Args>(args)...);
+            const int32 merged = MergeFreeRects(_freeRects[left].Right, right);
+            _freeRects[left].Right = merged;
+            UpdateFreeRect(left);
+            return left;
+        }
+        const int32 merged = MergeFreeRects(left, _freeRects[right].Left);
+        _freeRects[right].Left = merged;
+        UpdateFreeRect(right);
+        return right;
+    }
+
+    // Finds the first rectangle (in order) that can fit the item, so the one with the smallest height and then the smallest width.
+    int32 FindFreeRect(int32 index, Size width, Size height) const
+    {
+        if (index == -1 || _freeRects[index].MaxWidth < width)
+            return -1;
+        const FreeRect& e = _freeRects[index];
+        if (e.Value.Height < height)
+            return FindFreeRect(e.Right, width, height); // Whole left subtree is too low
+        const int32 result = FindFreeRect(e.Left, width, height);
+        if (result != -1)
             return result;
+        if (e.Value.Width >= width)
+            return index;
+        return FindFreeRect(e.Right, width, height);
+    }
+
+    void InsertFreeRect(const Rect& rect)
+    {
+        int32 index;
+        if (_freeRectsPool.HasItems())
+        {
+            index = _freeRectsPool.Pop();
         }
+        else
+        {
+            index = _freeRects.Count();
+            _freeRects.AddUninitialized();
+        }
+        _freeRectsSeed ^= _freeRectsSeed << 13;
+        _freeRectsSeed ^= _freeRectsSeed >> 17;
+        _freeRectsSeed ^= _freeRectsSeed << 5;
+        FreeRect& e = _freeRects[index];
+        e.Value = rect;
+        e.MaxWidth = rect.Width;
+        e.Priority = _freeRectsSeed;
+        e.Left = e.Right = -1;
+        int32 left, right;
+        SplitFreeRects(_freeRectsRoot, rect, false, left, right);
+        _freeRectsRoot = MergeFreeRects(MergeFreeRects(left, index), right);
+        _freeRectsCount++;
+        _freeTopLeft[GetCornerKey(rect.X, rect.Y)] = rect;
+        _freeBottomRight[GetCornerKey(rect.X + rect.Width, rect.Y + rect.Height)] = rect;
+    }
 
-        // If there are left and right slots there are empty regions around this slot (it also means this slot is occupied)
-        if (Left || Right)
+    void RemoveFreeRect(const Rect& rect)
+    {
+        int32 left, middle, right;
+        SplitFreeRects(_freeRectsRoot, rect, false, left, right);
+        SplitFreeRects(right, rect, true, middle, right);
+        ASSERT_LOW_LAYER(middle != -1 && _freeRects[middle].Left == -1 && _freeRects[middle].Right == -1);
+        _freeRectsPool.Add(middle);
+        _freeRectsRoot = MergeFreeRects(left, right);
+        _freeRectsCount--;
+        _freeTopLeft.Remove(GetCornerKey(rect.X, rect.Y));
+        _freeBottomRight.Remove(GetCornerKey(rect.X + rect.Width, rect.Y + rect.Height));
+    }
+
+    void AddFreeRect(Rect rect)
+    {
+        // Merge with the neighbour free rectangles that share the whole edge
+        while (true)
         {
-            if (Left)
+            const Rect* ptr;
+            Rect other;
+            if ((ptr = _freeTopLeft.TryGet(GetCornerKey(rect.X + rect.Width, rect.Y))) && ptr->Height == rect.Height)
+            {
+                // Right
+                other = *ptr;
+                rect.Width += other.Width;
+            }
+            else if ((ptr = _freeBottomRight.TryGet(GetCornerKey(rect.X, rect.Y + rect.Height))) && ptr->Height == rect.Height)
             {
-                result = Left->Insert(itemWidth, itemHeight, itemPadding, Forward<Args>(args)...);
-                if (result)
-                    return result;
+                // Left
+                other = *ptr;
+                rect.X = other.X;
+                rect.Width += other.Width;
             }
-            if (Right)
+            else if ((ptr = _freeTopLeft.TryGet(GetCornerKey(rect.X, rect.Y + rect.Height))) && ptr->Width == rect.Width)
             {
-                result = Right->Insert(itemWidth, itemHeight, itemPadding, Forward<Args>(args)...);
-                if (result)
-                    return result;
+                // Bottom
+                other = *ptr;
+                rect.Height += other.Height;
             }
+            else if ((ptr = _freeBottomRight.TryGet(GetCornerKey(rect.X + rect.Width, rect.Y))) && ptr->Width == rect.Width)
+            {
+                // Top
+                other = *ptr;
+                rect.Y = other.Y;
+                rect.Height += other.Height;
+            }
+            else
+            {
+                break;
+            }
+            RemoveFreeRect(other);
         }
 
-        // This slot can't fit or has been already occupied
-        if (IsUsed || paddedWidth > Width || paddedHeight > Height)
-        {
-            // Not enough space
-            return nullptr;
-        }
+        InsertFreeRect(rect);
+    }
 
-        // The width and height of the new child node
-        const SizeType remainingWidth = Math::Max<SizeType>(0, Width - paddedWidth);
-        const SizeType remainingHeight = Math::Max<SizeType>(0, Height - paddedHeight);
+    bool Allocate(Size width, Size height, Size& x, Size& y)
+    {
+        // Find the free rectangle with the smallest height that can fit the item (and the narrowest one within that height)
+        const int32 index = FindFreeRect(_freeRectsRoot, width, height);
+        if (index == -1)
+            return true;
+        const Rect rect = _freeRects[index].Value;
+        RemoveFreeRect(rect);
+        x = rect.X;
+        y = rect.Y;
 
-        // Split the remaining area around this slot into two children
+        // Split the remaining area around the item into two rectangles
+        const Size remainingWidth = rect.Width - width;
+        const Size remainingHeight = rect.Height - height;
+        const Size right = rect.X + width;
+        const Size bottom = rect.Y + height;
+        Rect a, b;
         if (remainingHeight <= remainingWidth)
         {
             // Split vertically
-            Left = New<NodeType>(X, Y + paddedHeight, paddedWidth, remainingHeight);
-            Right = New<NodeType>(X + paddedWidth, Y, remainingWidth, Height);
+            a = { rect.X, bottom, width, remainingHeight };
+            b = { right, rect.Y, remainingWidth, rect.Height };
         }
         else
         {
             // Split horizontally
-            Left = New<NodeType>(X + paddedWidth, Y, remainingWidth, paddedHeight);
-            Right = New<NodeType>(X, Y + paddedHeight, Width, remainingHeight);
+            a = { right, rect.Y, remainingWidth, height };
+            b = { rect.X, bottom, rect.Width, remainingHeight };
         }
+        if (a.Width > 0 && a.Height > 0)
+            AddFreeRect(a);
+        if (b.Width > 0 && b.Height > 0)
+            AddFreeRect(b);
+        return false;
+    }
 
-        // Shrink the slot to the actual area
-        Width = paddedWidth;
-        Height = paddedHeight;
-
-        // Insert into this slot
-        IsUsed = true;
-        result = (NodeType*)this;
-        result->OnInsert(Forward<Args>(args)...);
-        return result;
+    NodeType* AllocateNode()
+    {
+        if (_nodesPool.IsEmpty())
+        {
+            NodeType* chunk = (NodeType*)Allocator::Allocate(sizeof(NodeType) * NodesChunkSize);
+            _nodesChunks.Add(chunk);
+            for (int32 i = NodesChunkSize - 1; i >= 0; i--)
+                _nodesPool.Add(chunk + i);
+        }
+        return _nodesPool.Pop();
     }
 
-    /// <summary>
-    /// Frees the node.
-    /// </summary>
-    /// <returns>The node that contains inserted an item or null if failed to find a free space.</returns>
-    template<class... Args>
-    void Free(Args&&...args)
+    void ReleaseNode(NodeType* node)
     {
-        if (!IsUsed)
-            return;
-        IsUsed = false;
-        ((NodeType*)this)->OnFree(Forward<Args>(args)...);
+        node->AtlasIndex = -1;
+        node->~NodeType();
+        _nodesPool.Add(node);
     }
 };
@@ -36,6 +36,91 @@ const Char* ShaderGenerator::_subs[] =
     TEXT(".w")
 };
 
+namespace
+{
+    bool FoldOperation2(const ShaderGraphValue& a, const ShaderGraphValue& b, Char op, ShaderGraphValue& result)
+    {
+        // Skip identity operations
+        switch (op)
+        {
+        case '+':
+            if (b.IsZero())
+            {
+                result = a;
+                return true;
+            }
+            if (a.IsZero() && a.Type == b.Type)
+            {
+                result = b;
+                return true;
+            }
+            break;
+        case '-':
+            if (b.IsZero())
+            {
+                result = a;
+                return true;
+            }
+            break;
+        case '*':
+            if (b.IsOne())
+            {
+                result = a;
+                return true;
+            }
+            if (a.IsOne() && a.Type == b.Type)
+            {
+                result = b;
+                return true;
+            }
+            break;
+        case '/':
+            if (b.IsOne())
+            {
+                result = a;
+                return true;
+            }
+            break;
+        default:
+            return false;
+        }
+
+        // Fold constant scalars (only if the result can be written without precision loss)
+        if (a.Type != VariantType::Float || b.Type != VariantType::Float || !a.IsLiteral() || !b.IsLiteral())
+            return false;
+        float valueA, valueB, value;
+        if (StringUtils::Parse(*a.Value, &valueA) || StringUtils::Parse(*b.Value, &valueB))
+            return false;
+        switch (op)
+        {
+        case '+':
+            value = valueA + valueB;
+            break;
+        case '-':
+            value = valueA - valueB;
+            break;
+        case '*':
+            value = valueA * valueB;
+            break;
+        case '/':
+            if (valueB == 0.0f)
+                return false;
+            value = valueA / valueB;
+            break;
+        default:
+            return false;
+        }
+        if (isnan(value) || isinf(value))
+            return false;
+        ShaderGraphValue folded(value);
+        float check;
+        if (StringUtils::Parse(*folded.Value, &check) || check != value)
+            return false;
+        result = folded;
+        return true;
+    }
+}
+
 ShaderGenerator::ShaderGenerator()
     : _writer(2048)
 {
@@ -1109,7 +1194,10 @@ ShaderGenerator::Value ShaderGenerator::writeLocal(ValueType type, Node* caller,
         OnError(caller, nullptr, *String::Format(TEXT("Unsupported value type: {0}"), VariantType(type)));
         return ShaderGraphValue::Zero;
     }
+    const uint32 position = _writer.GetBuffer()->GetPosition();
     _writer.Write(TEXT("\t{0} {1};\n"), typeName, name);
+    if (_expressionsPosition == position)
+        _expressionsPosition = _writer.GetBuffer()->GetPosition(); // Declaring a new local doesn't invalidate cached expressions
     return ShaderGraphValue(type, name);
 }
 
@@ -1165,39 +1253,73 @@ ShaderGenerator::Value ShaderGenerator::writeLocal(ValueType type, const String&
         OnError(caller, nullptr, String::Format(TEXT("Unsupported value type: {0}"), VariantType(type)));
         return ShaderGraphValue::Zero;
     }
+    const uint32 position = _writer.GetBuffer()->GetPosition();
     _writer.Write(TEXT("\t{0} {1} = {2};\n"), typeName, name, value);
+    if (_expressionsPosition == position)
+        _expressionsPosition = _writer.GetBuffer()->GetPosition(); // Declaring a new local doesn't invalidate cached expressions
     return ShaderGraphValue(type, name);
 }
 
+ShaderGenerator::Value ShaderGenerator::writeExpression(ValueType type, const String& value, Node* caller)
+{
+    // Any other code written since the last local (eg. assignment to local or input) could change the results of cached expressions
+    const uint32 position = _writer.GetBuffer()->GetPosition();
+    if (_expressionsPosition != position)
+    {
+        _expressions.Clear();
+        _expressionsPosition = position;
+    }
+
+    // Reuse local with the same pure expression
+    const String key = String::Format(TEXT("{0}:{1}"), (int32)type, value);
+    Value result;
+    if (_expressions.TryGet(key, result))
+        return result;
+    result = writeLocal(type, value, caller);
+    if (result.IsValid())
+        _expressions.Add(key, result);
+    return result;
+}
+
+void ShaderGenerator::clearExpressions()
+{
+    _expressions.Clear();
+    _expressionsPosition = _writer.GetBuffer()->GetPosition();
+}
+
 ShaderGenerator::Value ShaderGenerator::writeOperation2(Node* caller, const Value& valueA, const Value& valueB, Char op1)
 {
+    const Value valueBCast = Value::Cast(valueB, valueA.Type);
+    Value result;
+    if (FoldOperation2(valueA, valueBCast, op1, result))
+        return result;
     const Char op1Str[2] = { op1, 0 };
-    const String value = String::Format(TEXT("{0} {1} {2}"), valueA.Value, op1Str, Value::Cast(valueB, valueA.Type).Value);
-    return writeLocal(valueA.Type, value, caller);
+    const String value = String::Format(TEXT("{0} {1} {2}"), valueA.Value, op1Str, valueBCast.Value);
+    return writeExpression(valueA.Type, value, caller);
 }
 
 ShaderGenerator::Value ShaderGenerator::writeFunction1(Node* caller, const Value& valueA, const String& function)
 {
     const String value = String::Format(TEXT("{0}({1})"), function, valueA.Value);
-    return writeLocal(valueA.Type, value, caller);
+    return writeExpression(valueA.Type, value, caller);
 }
 
 ShaderGenerator::Value ShaderGenerator::writeFunction2(Node* caller, const Value& valueA, const Value& valueB, const String& function)
 {
     const String value = String::Format(TEXT("{0}({1}, {2})"), function, valueA.Value, Value::Cast(valueB, valueA.Type).Value);
-    return writeLocal(valueA.Type, value, caller);
+    return writeExpression(valueA.Type, value, caller);
 }
 
 ShaderGenerator::Value ShaderGenerator::writeFunction2(Node* caller, const Value& valueA, const Value& valueB, const String& function, ValueType resultType)
 {
     const String value = String::Format(TEXT("{0}({1}, {2})"), function, valueA.Value, Value::Cast(valueB, valueA.Type).Value);
-    return writeLocal(resultType, value, caller);
+    return writeExpression(resultType, value, caller);
 }
 
 ShaderGenerator::Value ShaderGenerator::writeFunction3(Node* caller, const Value& valueA, const Value& valueB, const Value& valueC, const String& function, ValueType resultType)
 {
     const String value = String::Format(TEXT("{0}({1}, {2}, {3})"), function, valueA.Value, Value::Cast(valueB, valueA.Type).Value, Value::Cast(valueC, valueA.Type).Value);
-    return writeLocal(resultType, value, caller);
+    return writeExpression(resultType, value, caller);
 }
 
 SerializedMaterialParam* ShaderGenerator::findParam(const String& shaderName)
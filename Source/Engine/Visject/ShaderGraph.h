@@ -209,6 +209,8 @@ class ShaderGenerator
     Array<ProcessBoxHandler, FixedAllocation<17>> _perGroupProcessCall;
     Array<Node*, FixedAllocation<SHADER_GRAPH_MAX_CALL_STACK>> _callStack;
     Array<Graph*, FixedAllocation<32>> _graphStack;
+    Dictionary<String, Value> _expressions;
+    uint32 _expressionsPosition = 0;
 
 public:
     /// <summary>
@@ -255,6 +257,8 @@ class ShaderGenerator
     Value writeLocal(const Value& value, Node* caller);
     Value writeLocal(ValueType type, const String& value, Node* caller);
     Value writeLocal(ValueType type, const String& value, Node* caller, const String& name);
+    Value writeExpression(ValueType type, const String& value, Node* caller);
+    void clearExpressions();
     Value writeOperation2(Node* caller, const Value& valueA, const Value& valueB, Char op1);
     Value writeFunction1(Node* caller, const Value& valueA, const String& function);
     Value writeFunction2(Node* caller, const Value& valueA, const Value& valueB, const String& function);